@@ -200,5 +200,30 @@ void DXSample::ParseCommandLineArgs(WCHAR* argv[], int argc)
             m_tagInterpolatedFrames = _wtoi(argv[i + 1]);
             i++;
         }
+
+        if ((_wcsnicmp(argv[i], L"-trace", wcslen(argv[i])) == 0 ||
+            _wcsnicmp(argv[i], L"/trace", wcslen(argv[i])) == 0) && (i + 1 < argc))
+        {
+            m_tracePath = argv[i + 1];
+            i++;
+        }
+
+        if (_wcsnicmp(argv[i], L"-cpu_timers", wcslen(argv[i])) == 0 ||
+            _wcsnicmp(argv[i], L"/cpu_timers", wcslen(argv[i])) == 0)
+        {
+            m_enableCpuTimers = true;
+        }
+
+        if (_wcsnicmp(argv[i], L"-telemetry", wcslen(argv[i])) == 0 ||
+            _wcsnicmp(argv[i], L"/telemetry", wcslen(argv[i])) == 0)
+        {
+            m_enableTelemetry = true;
+        }
+
+        if (_wcsnicmp(argv[i], L"-anomaly", wcslen(argv[i])) == 0 ||
+            _wcsnicmp(argv[i], L"/anomaly", wcslen(argv[i])) == 0)
+        {
+            m_enableAnomalyDetector = true;
+        }
     }
 }
@@ -61,6 +61,18 @@ public:
     bool m_topmost = false;
     float m_last_frameMS = 0.0;
 
+    // Timeline trace of XeLL reports and XeSS-FG present status, empty disables it.
+    std::wstring m_tracePath;
+
+    // Record CPU scope timers of the frame loop.
+    bool m_enableCpuTimers = false;
+
+    // Publish frame telemetry to shared memory for external readers.
+    bool m_enableTelemetry = false;
+
+    // Detect stutters and regressions of frame times and XeLL latency while running.
+    bool m_enableAnomalyDetector = false;
+
 protected:
     std::wstring GetAssetFullPath(LPCWSTR assetName);
 
@@ -200,6 +200,14 @@ void BasicSample::OnKeyUp(UINT8 key)
         m_switchResolution = true;
         break;
 #endif
+    case 0x35:  // Key 5
+        if (m_enableCpuTimers)
+        {
+            OutputDebugStringA(m_cpuTimerStatistics.FormatReport(m_cpuTimerFrames).c_str());
+            m_cpuTimerStatistics.Reset();
+            m_cpuTimerFrames = 0;
+        }
+        break;
     case VK_SPACE:
         m_pause = !m_pause;
         break;
@@ -250,6 +258,37 @@ void BasicSample::OnInit()
     CreateFSQPipeline();
     PopulateDescriptorHeap();
 
+    if (m_enableCpuTimers)
+    {
+        PerfTools::CpuTimers::Calibrate();
+        m_cpuZones.update = PerfTools::CpuTimers::RegisterZone("OnUpdate");
+        m_cpuZones.populateCommandList = PerfTools::CpuTimers::RegisterZone("PopulateCommandList");
+        m_cpuZones.present = PerfTools::CpuTimers::RegisterZone("Present");
+        m_cpuZones.frameWait = PerfTools::CpuTimers::RegisterZone("WaitForPreviousFrame");
+        // One ring worth of samples is the most a single drain can return.
+        m_cpuTimerSamples.resize(PerfTools::CpuTimers::RingCapacity);
+        PerfTools::CpuTimers::SetEnabled(true);
+    }
+
+    if (m_enableTelemetry && !m_telemetry.Create(PerfTools::TelemetryDefaultName))
+    {
+        OutputDebugStringA("Unable to create the telemetry ring\n");
+    }
+
+    if (m_enableAnomalyDetector)
+    {
+        // Ignore stutters too small to be noticed.
+        PerfTools::AnomalySignalConfig frameTimeConfig;
+        frameTimeConfig.minStutterExcess = 2.0;
+        m_anomalySignals.frameTime = m_anomalyDetector.AddSignal("frame time [ms]", frameTimeConfig);
+        // The latency is sampled every 8 frames, keep warm up and cooldown at a few seconds.
+        PerfTools::AnomalySignalConfig latencyConfig;
+        latencyConfig.minStutterExcess = 2.0;
+        latencyConfig.warmupSamples = 16;
+        latencyConfig.cooldownSamples = 16;
+        m_anomalySignals.xellLatency = m_anomalyDetector.AddSignal("XeLL sim to present [ms]", latencyConfig);
+    }
+
 #ifdef ENABLE_XEFG_SWAPCHAIN
     xell_sleep_params_t xellParams = {};
     xellParams.bLowLatencyMode = 1;
@@ -391,14 +430,34 @@ void BasicSample::LoadDX12()
 #else
     xefg_swapchain_logging_level_t log_level = xefg_swapchain_logging_level_t::XEFG_SWAPCHAIN_LOGGING_LEVEL_WARNING;
 #endif
-    if (xefgSwapChainSetLoggingCallback(m_xefgSwapChain, log_level, (xefg_swapchain_app_log_callback_t)LogCallback, nullptr) != XEFG_SWAPCHAIN_RESULT_SUCCESS)
+    // The callbacks may run on any thread, including the render thread inside Present, so they only copy the
+    // message into the sink's ring.
+    m_logSink.Start();
+    PerfTools::AsyncLogSink::SetInstance(&m_logSink);
+    if (xefgSwapChainSetLoggingCallback(m_xefgSwapChain, log_level, PerfTools::AsyncLogSink::XefgLogCallback, &m_logSink) != XEFG_SWAPCHAIN_RESULT_SUCCESS)
     {
         std::stringstream ss;
         ss << "XeFG Logging (" << log_level << ") can't be enabled" << std::endl;
         OutputDebugStringA(ss.str().c_str());
     }
+    if (xellSetLoggingCallback(m_xellContext, (xell_logging_level_t)log_level, PerfTools::AsyncLogSink::XellLogCallback) != XELL_RESULT_SUCCESS)
+    {
+        std::stringstream ss;
+        ss << "XeLL Logging (" << log_level << ") can't be enabled" << std::endl;
+        OutputDebugStringA(ss.str().c_str());
+    }
     ThrowIfFailed(xefgSwapChainSetLatencyReduction(m_xefgSwapChain, m_xellContext), "Unable to set XeLL context");
 
+    if (!m_tracePath.empty())
+    {
+        char path[MAX_PATH];
+        WideCharToMultiByte(CP_ACP, 0, m_tracePath.c_str(), -1, path, MAX_PATH, nullptr, nullptr);
+        if (!m_trace.Open(path))
+        {
+            OutputDebugStringA("Unable to create the trace file\n");
+        }
+    }
+
     xefg_swapchain_d3d12_init_params_t params = {};
 #ifdef USE_APP_SWAPCHAIN_OBJECT
     params.pApplicationSwapChain = swapChain;
@@ -956,7 +1015,14 @@ void BasicSample::CreateFSQPipeline()
 // Update frame-based values.
 void BasicSample::OnUpdate()
 {
+    PerfTools::ScopedCpuTimer cpuTimer(m_cpuZones.update);
+
 #if ENABLE_XEFG_SWAPCHAIN
+    if (m_trace.IsOpen())
+    {
+        // Ties the XeLL clock to the trace clock.
+        m_trace.AddXellMarkerTime(m_frameCounter, PerfTools::TraceExporter::Now());
+    }
     ThrowIfFailed(xellAddMarkerData(m_xellContext, m_frameCounter, XELL_SIMULATION_START),
                   "Failed to add XeLL marker XELL_SIMULATION_START");
 
@@ -1162,16 +1228,19 @@ void BasicSample::OnRender()
                   "Failed to add XELL_PRESENT_START marker");
 #endif
 
-    if (m_useAsyncFlip)
-    {
-        ThrowIfFailed(m_swapChain->Present(
-            0, m_fullScreen
-                   ? 0
-                   : DXGI_PRESENT_ALLOW_TEARING)); // DXGI_PRESENT_ALLOW_TEARING not allowed in full screen mode
-    }
-    else
     {
-        ThrowIfFailed(m_swapChain->Present(1, 0));
+        PerfTools::ScopedCpuTimer cpuTimer(m_cpuZones.present);
+        if (m_useAsyncFlip)
+        {
+            ThrowIfFailed(m_swapChain->Present(
+                0, m_fullScreen
+                       ? 0
+                       : DXGI_PRESENT_ALLOW_TEARING)); // DXGI_PRESENT_ALLOW_TEARING not allowed in full screen mode
+        }
+        else
+        {
+            ThrowIfFailed(m_swapChain->Present(1, 0));
+        }
     }
 
 #ifdef ENABLE_XEFG_SWAPCHAIN
@@ -1188,9 +1257,31 @@ void BasicSample::OnRender()
         OutputDebugStringA(ss.str().c_str());
     }
 
+    if (m_trace.IsOpen())
+    {
+        m_trace.AddPresentStatus(PerfTools::TraceExporter::Now(), m_frameCounter, lastPresentStatus);
+
+        // XeLL keeps reports of the last 64 frames, collect well before they are overwritten.
+        if (m_frameCounter % 32 == 31)
+        {
+            ExportXellReports();
+        }
+    }
+#endif
+
+    // XeLL reports complete a few frames late, the latency is refreshed every few frames.
+    bool xellLatencyUpdated = false;
+#ifdef ENABLE_XEFG_SWAPCHAIN
+    if ((m_enableTelemetry || m_enableAnomalyDetector) && m_frameCounter % 8 == 0)
+    {
+        xellLatencyUpdated = UpdateXellLatency();
+    }
 #endif
+    PublishTelemetry();
+    DetectAnomalies(xellLatencyUpdated);
     m_frameCounter++;
     WaitForPreviousFrame();
+    DrainCpuTimers();
 
     m_frameIndex++;
     if (m_frameIndex >= FrameCount)
@@ -1212,16 +1303,81 @@ void BasicSample::OnDestroy()
     }
     CloseHandle(m_fenceEvent);
 
+    if (m_enableCpuTimers)
+    {
+        DrainCpuTimers();
+        PerfTools::CpuTimers::SetEnabled(false);
+        OutputDebugStringA(m_cpuTimerStatistics.FormatReport(m_cpuTimerFrames).c_str());
+    }
+
+    m_telemetry.Close();
+
 #ifdef ENABLE_XEFG_SWAPCHAIN
+    if (m_trace.IsOpen())
+    {
+        ExportXellReports();
+        m_trace.Close();
+    }
+
     m_swapChain.Reset();
     ThrowIfFailed(xefgSwapChainDestroy(m_xefgSwapChain), "Failed to destroy XeSS-FG swap chain context");
     ThrowIfFailed(xellDestroyContext(m_xellContext), "Failed to destroy XeLL context");
+
+    m_logSink.Stop();
+    PerfTools::AsyncLogSink::SetInstance(nullptr);
+    const PerfTools::LogSinkStatistics logStatistics = m_logSink.GetStatistics();
+    if (logStatistics.dropped != 0 || logStatistics.suppressed != 0)
+    {
+        OutputDebugStringA(m_logSink.FormatReport().c_str());
+    }
 #endif
 }
 
+#ifdef ENABLE_XEFG_SWAPCHAIN
+void BasicSample::ExportXellReports()
+{
+    xell_frame_report_t reports[64];
+    if (xellGetFramesReports(m_xellContext, reports) == XELL_RESULT_SUCCESS)
+    {
+        m_trace.AddXellFrameReports(reports, 64);
+    }
+}
+
+// Refresh the simulation to present latency from the newest complete XeLL report.
+bool BasicSample::UpdateXellLatency()
+{
+    xell_frame_report_t reports[64];
+    if (xellGetFramesReports(m_xellContext, reports) != XELL_RESULT_SUCCESS)
+    {
+        return false;
+    }
+
+    const xell_frame_report_t* newest = nullptr;
+    for (const xell_frame_report_t& report : reports)
+    {
+        if (report.m_sim_start_ts != 0 && report.m_present_end_ts > report.m_sim_start_ts &&
+            (newest == nullptr || report.m_frame_id > newest->m_frame_id))
+        {
+            newest = &report;
+        }
+    }
+    if (newest == nullptr || (m_xellLatencyValid && newest->m_frame_id == m_xellLatencyFrameId))
+    {
+        return false;
+    }
+
+    m_xellLatencyMs = (float)((newest->m_present_end_ts - newest->m_sim_start_ts) * 1e-6);
+    m_xellLatencyFrameId = newest->m_frame_id;
+    m_xellLatencyValid = true;
+    return true;
+}
+#endif
+
 // Fill the command list with all the render commands and dependent state.
 void BasicSample::PopulateCommandList()
 {
+    PerfTools::ScopedCpuTimer cpuTimer(m_cpuZones.populateCommandList);
+
     if (!m_useAsyncFlip && (m_frameCounter > 0 && m_frameIndex % FrameCount == 0))
     {
         // Command list allocators can only be reset when the associated 
@@ -1383,6 +1539,8 @@ void BasicSample::WaitForExec()
 
 void BasicSample::WaitForPreviousFrame()
 {
+    PerfTools::ScopedCpuTimer cpuTimer(m_cpuZones.frameWait);
+
     // WAITING FOR THE FRAME TO COMPLETE BEFORE CONTINUING IS NOT BEST PRACTICE.
     // This is code implemented as such for simplicity. This
     // sample illustrates how to use fences for efficient resource usage and to
@@ -1405,4 +1563,75 @@ void BasicSample::WaitForPreviousFrame()
     }
 
     m_backBufferIndex = m_swapChain->GetCurrentBackBufferIndex();
+}
+
+// Move the CPU timer samples of the frame into the statistics and the trace.
+void BasicSample::DrainCpuTimers()
+{
+    if (!m_enableCpuTimers)
+    {
+        return;
+    }
+
+    const std::uint32_t count = PerfTools::CpuTimers::Drain(m_cpuTimerSamples.data(), (std::uint32_t)m_cpuTimerSamples.size());
+    m_cpuTimerStatistics.Add(m_cpuTimerSamples.data(), count);
+#ifdef ENABLE_XEFG_SWAPCHAIN
+    m_trace.AddCpuTimerSamples(m_cpuTimerSamples.data(), count);
+#endif
+    m_cpuTimerFrames++;
+}
+
+// Publish the telemetry of the presented frame. The sim-to-present latency is the one of
+// the newest completed XeLL report, polled every few frames.
+void BasicSample::PublishTelemetry()
+{
+    if (!m_telemetry.IsOpen())
+    {
+        return;
+    }
+
+    PerfTools::TelemetryRecord record = {};
+    record.frameIndex = m_frameCounter;
+#ifdef ENABLE_XEFG_SWAPCHAIN
+    if (m_xellLatencyValid)
+    {
+        record.simToPresentLatencyMs = m_xellLatencyMs;
+        record.validFields |= PerfTools::TelemetrySimToPresentLatency;
+    }
+    record.framesPresented = lastPresentStatus.framesPresented;
+    record.validFields |= PerfTools::TelemetryFramesPresented;
+#endif
+    m_telemetry.Publish(record);
+}
+
+// Feed the anomaly detector with the frame time and each refreshed XeLL latency.
+void BasicSample::DetectAnomalies(bool xellLatencyUpdated)
+{
+    if (!m_enableAnomalyDetector)
+    {
+        return;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    if (m_anomalyFrameTimed)
+    {
+        const std::chrono::duration<double, std::milli> frameTime = now - m_anomalyLastFrameTime;
+        m_anomalyDetector.Add(m_anomalySignals.frameTime, m_frameCounter, frameTime.count());
+    }
+    m_anomalyLastFrameTime = now;
+    m_anomalyFrameTimed = true;
+
+    if (xellLatencyUpdated)
+    {
+        m_anomalyDetector.Add(m_anomalySignals.xellLatency, m_xellLatencyFrameId, m_xellLatencyMs);
+    }
+
+    PerfTools::AnomalyEvent events[4];
+    while (std::uint32_t count = m_anomalyDetector.Drain(events, _countof(events)))
+    {
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            OutputDebugStringA(m_anomalyDetector.FormatEvent(events[i]).c_str());
+        }
+    }
 }
\ No newline at end of file
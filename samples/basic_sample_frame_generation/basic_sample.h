@@ -16,12 +16,19 @@
 #include "DXSample.h"
 
 #include <chrono>
+#include <vector>
+
+#include "anomaly_detector.h"
+#include "async_log_sink.h"
+#include "cpu_timers.h"
+#include "telemetry.h"
 
 #define ENABLE_XEFG_SWAPCHAIN 1
 
 #ifdef ENABLE_XEFG_SWAPCHAIN
 #include "xefg_swapchain_d3d12.h"
 #include "xell_d3d12.h"
+#include "trace_exporter.h"
 #endif
 
 using namespace DirectX;
@@ -156,9 +163,47 @@ private:
     ComPtr<ID3D12DescriptorHeap> m_pDH;
     uint32_t m_descriptorCount = 0;
     uint32_t requiredDescriptorCount = 0;
+
+    PerfTools::TraceExporter m_trace;
+    // XeSS-FG and XeLL log messages, written to the debug output on a background thread
+    PerfTools::AsyncLogSink m_logSink;
+    void ExportXellReports();
+    bool UpdateXellLatency();
 #endif
     UINT m_frameCounter = 0;
 
+    // Telemetry ring read by external processes
+    PerfTools::TelemetryWriter m_telemetry;
+
+    // Simulation to present latency of the newest complete XeLL report
+    float m_xellLatencyMs = 0.0f;
+    bool m_xellLatencyValid = false;
+    std::uint32_t m_xellLatencyFrameId = 0;
+
+    // Online detection on frame times and XeLL latency
+    struct AnomalySignals
+    {
+        std::uint32_t frameTime;
+        std::uint32_t xellLatency;
+    };
+    AnomalySignals m_anomalySignals = {};
+    PerfTools::AnomalyDetector m_anomalyDetector;
+    std::chrono::steady_clock::time_point m_anomalyLastFrameTime;
+    bool m_anomalyFrameTimed = false;
+
+    // CPU scope timers of the frame loop, drained once per frame
+    struct CpuZones
+    {
+        std::uint32_t update;
+        std::uint32_t populateCommandList;
+        std::uint32_t present;
+        std::uint32_t frameWait;
+    };
+    CpuZones m_cpuZones = {};
+    PerfTools::CpuTimerStatistics m_cpuTimerStatistics;
+    std::vector<PerfTools::CpuTimerSample> m_cpuTimerSamples;
+    UINT64 m_cpuTimerFrames = 0;
+
     void LoadDX12();
     void CreateFrameResources();
     void LoadPipeline();
@@ -169,12 +214,9 @@ private:
     void PopulateRenderTargetCommandList(uint32_t srcIndex);
     void WaitForExec();
     void WaitForPreviousFrame();
-#ifdef ENABLE_XEFG_SWAPCHAIN
-    static void LogCallback(const char* message, xefg_swapchain_logging_level_t level, void* userData)
-    {
-        OutputDebugStringA(("[XeSS-FG Runtime][" + std::to_string(level) + "]: " + message + "\n").c_str());
-    }
-#endif
+    void DrainCpuTimers();
+    void PublishTelemetry();
+    void DetectAnomalies(bool xellLatencyUpdated);
 
     // Busy wait for a specified duration
     void BusyWait(std::chrono::microseconds duration)
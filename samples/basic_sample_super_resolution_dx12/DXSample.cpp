@@ -21,7 +21,15 @@ DXSample::DXSample(UINT width, UINT height, std::wstring name) :
     m_height(height),
     m_useWarpDevice(false),
     m_title(name),
-    m_hardwareAdapterId(-1)
+    m_hardwareAdapterId(-1),
+    m_dumpStreamMask(0),
+    m_soakDumpFrames(0),
+    m_soakDumpSeconds(0.f),
+    m_soakDumpBudgetMB(2048),
+    m_enableProfiling(false),
+    m_enableCpuTimers(false),
+    m_enableTelemetry(false),
+    m_enableAnomalyDetector(false)
 {
     WCHAR assetsPath[512];
     GetAssetsPath(assetsPath, _countof(assetsPath));
@@ -133,5 +141,75 @@ void DXSample::ParseCommandLineArgs(WCHAR* argv[], int argc)
             m_hardwareAdapterId = _wtoi(argv[i + 1]);
             i++;
         }
+
+        if ((_wcsnicmp(argv[i], L"-dump_stream", wcslen(argv[i])) == 0 ||
+            _wcsnicmp(argv[i], L"/dump_stream", wcslen(argv[i])) == 0) && (i + 1 < argc))
+        {
+            m_dumpStreamMask = (UINT)wcstoul(argv[i + 1], nullptr, 0);
+            i++;
+        }
+
+        if ((_wcsnicmp(argv[i], L"-soak_dump_frames", wcslen(argv[i])) == 0 ||
+            _wcsnicmp(argv[i], L"/soak_dump_frames", wcslen(argv[i])) == 0) && (i + 1 < argc))
+        {
+            m_soakDumpFrames = (UINT)_wtoi(argv[i + 1]);
+            i++;
+        }
+
+        if ((_wcsnicmp(argv[i], L"-soak_dump_seconds", wcslen(argv[i])) == 0 ||
+            _wcsnicmp(argv[i], L"/soak_dump_seconds", wcslen(argv[i])) == 0) && (i + 1 < argc))
+        {
+            m_soakDumpSeconds = (float)_wtof(argv[i + 1]);
+            i++;
+        }
+
+        if ((_wcsnicmp(argv[i], L"-soak_dump_budget", wcslen(argv[i])) == 0 ||
+            _wcsnicmp(argv[i], L"/soak_dump_budget", wcslen(argv[i])) == 0) && (i + 1 < argc))
+        {
+            m_soakDumpBudgetMB = (UINT)_wtoi(argv[i + 1]);
+            i++;
+        }
+
+        if (_wcsnicmp(argv[i], L"-profiling", wcslen(argv[i])) == 0 ||
+            _wcsnicmp(argv[i], L"/profiling", wcslen(argv[i])) == 0)
+        {
+            m_enableProfiling = true;
+        }
+
+        if ((_wcsnicmp(argv[i], L"-profile_log", wcslen(argv[i])) == 0 ||
+            _wcsnicmp(argv[i], L"/profile_log", wcslen(argv[i])) == 0) && (i + 1 < argc))
+        {
+            m_profileLogPath = argv[i + 1];
+            m_enableProfiling = true;
+            i++;
+        }
+
+        if ((_wcsnicmp(argv[i], L"-trace", wcslen(argv[i])) == 0 ||
+            _wcsnicmp(argv[i], L"/trace", wcslen(argv[i])) == 0) && (i + 1 < argc))
+        {
+            m_tracePath = argv[i + 1];
+            m_enableProfiling = true;
+            i++;
+        }
+
+        if (_wcsnicmp(argv[i], L"-cpu_timers", wcslen(argv[i])) == 0 ||
+            _wcsnicmp(argv[i], L"/cpu_timers", wcslen(argv[i])) == 0)
+        {
+            m_enableCpuTimers = true;
+        }
+
+        if (_wcsnicmp(argv[i], L"-telemetry", wcslen(argv[i])) == 0 ||
+            _wcsnicmp(argv[i], L"/telemetry", wcslen(argv[i])) == 0)
+        {
+            m_enableTelemetry = true;
+            m_enableProfiling = true;
+        }
+
+        if (_wcsnicmp(argv[i], L"-anomaly", wcslen(argv[i])) == 0 ||
+            _wcsnicmp(argv[i], L"/anomaly", wcslen(argv[i])) == 0)
+        {
+            m_enableAnomalyDetector = true;
+            m_enableProfiling = true;
+        }
     }
 }
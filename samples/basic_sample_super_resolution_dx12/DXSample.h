@@ -58,6 +58,32 @@ protected:
     bool m_useWarpDevice;
     INT m_hardwareAdapterId;
 
+    // Elements streamed to the live dump consumer, 0 disables streaming.
+    UINT m_dumpStreamMask;
+
+    // Periodic dumps for soak runs, both intervals 0 disable them.
+    UINT m_soakDumpFrames;
+    float m_soakDumpSeconds;
+    UINT m_soakDumpBudgetMB;
+
+    // Collect XeSS GPU profiling data.
+    bool m_enableProfiling;
+
+    // Binary profiling log, empty disables logging.
+    std::wstring m_profileLogPath;
+
+    // Timeline trace of the XeSS GPU passes, empty disables it.
+    std::wstring m_tracePath;
+
+    // Record CPU scope timers of the frame loop.
+    bool m_enableCpuTimers;
+
+    // Publish frame telemetry to shared memory for external readers.
+    bool m_enableTelemetry;
+
+    // Detect stutters and regressions while running, each event captures a frame dump.
+    bool m_enableAnomalyDetector;
+
 private:
     // Root assets path.
     std::wstring m_assetsPath;
@@ -48,6 +48,13 @@ inline std::string XeSSResultToString(xess_result_t result)
     }
 }
 
+inline std::string ToNarrowPath(const std::wstring& path)
+{
+    char narrow[MAX_PATH];
+    WideCharToMultiByte(CP_ACP, 0, path.c_str(), -1, narrow, MAX_PATH, nullptr, nullptr);
+    return narrow;
+}
+
 inline void ThrowIfFailed(xess_result_t result, const std::string& err)
 {
     if (result > XESS_RESULT_SUCCESS) // warnings
@@ -116,6 +123,19 @@ void BasicSampleD3D12::OnKeyUp(UINT8 key)
         xessStartDump(m_xessContext, &dump_params);
         break;
     }
+    case 0x35:  // Key 5
+        if (m_profiling.IsInitialized())
+        {
+            OutputDebugStringA(m_profiling.FormatReport().c_str());
+            m_profiling.Reset();
+        }
+        if (m_enableCpuTimers)
+        {
+            OutputDebugStringA(m_cpuTimerStatistics.FormatReport(m_cpuTimerFrames).c_str());
+            m_cpuTimerStatistics.Reset();
+            m_cpuTimerFrames = 0;
+        }
+        break;
     case VK_SPACE:
         m_pause = !m_pause;
         break;
@@ -145,6 +165,36 @@ void BasicSampleD3D12::OnInit()
     LoadAssets();
     CreateFSQPipeline();
     PopulateDescriptorHeap();
+    InitFrameReadback();
+
+    if (m_enableCpuTimers)
+    {
+        PerfTools::CpuTimers::Calibrate();
+        m_cpuZones.update = PerfTools::CpuTimers::RegisterZone("OnUpdate");
+        m_cpuZones.populateCommandList = PerfTools::CpuTimers::RegisterZone("PopulateCommandList");
+        m_cpuZones.xessExecute = PerfTools::CpuTimers::RegisterZone("xessD3D12Execute");
+        m_cpuZones.present = PerfTools::CpuTimers::RegisterZone("Present");
+        m_cpuZones.fenceWait = PerfTools::CpuTimers::RegisterZone("MoveToNextFrame fence wait");
+        // One ring worth of samples is the most a single drain can return.
+        m_cpuTimerSamples.resize(PerfTools::CpuTimers::RingCapacity);
+        PerfTools::CpuTimers::SetEnabled(true);
+    }
+
+    if (m_enableTelemetry && !m_telemetry.Create(PerfTools::TelemetryDefaultName))
+    {
+        OutputDebugStringA("Unable to create the telemetry ring\n");
+    }
+
+    if (m_enableAnomalyDetector)
+    {
+        // Ignore stutters too small to be noticed.
+        PerfTools::AnomalySignalConfig frameTimeConfig;
+        frameTimeConfig.minStutterExcess = 2.0;
+        m_anomalySignals.frameTime = m_anomalyDetector.AddSignal("frame time [ms]", frameTimeConfig);
+        PerfTools::AnomalySignalConfig xessConfig;
+        xessConfig.minStutterExcess = 0.2;
+        m_anomalySignals.xessGpuTime = m_anomalyDetector.AddSignal("XeSS GPU time [ms]", xessConfig);
+    }
 }
 
 void BasicSampleD3D12::InitDx()
@@ -258,7 +308,15 @@ void BasicSampleD3D12::InitDx()
 
 void BasicSampleD3D12::InitXess()
 {
+    // The blocking startup calls are timed, pipelines are built ahead of the
+    // initialization so that both phases can be told apart.
+    auto elapsedMs = [](std::chrono::high_resolution_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    };
+    auto startTime = std::chrono::high_resolution_clock::now();
     ThrowIfFailed(xessD3D12CreateContext(m_device.Get(), &m_xessContext), "Unable to create XeSS context");
+    const double createContextMs = elapsedMs(startTime);
 
     if (XESS_RESULT_WARNING_OLD_DRIVER == xessIsOptimalDriver(m_xessContext))
     {
@@ -281,17 +339,24 @@ void BasicSampleD3D12::InitXess()
     m_uavDescriptorSize =
         m_device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
 
+    uint32_t initFlags =
+        #if defined(USE_LOWRES_MV)
+        XESS_INIT_FLAG_NONE;
+        #else
+        XESS_INIT_FLAG_HIGH_RES_MV;
+        #endif
+    if (m_enableProfiling)
+    {
+        initFlags |= XESS_DEBUG_ENABLE_PROFILING;
+    }
+
     xess_d3d12_init_params_t params = {
         /* Output width and height. */
         m_desiredOutputResolution,
         /* Quality setting */
         m_quality,
         /* Initialization flags. */
-        #if defined(USE_LOWRES_MV)
-        XESS_INIT_FLAG_NONE,
-        #else
-        XESS_INIT_FLAG_HIGH_RES_MV,
-        #endif
+        initFlags,
         /* Specfies the node mask for internally created resources on
          * multi-adapter systems. */
         0,
@@ -314,7 +379,48 @@ void BasicSampleD3D12::InitXess()
         NULL
     };
 
+    startTime = std::chrono::high_resolution_clock::now();
+    ThrowIfFailed(xessD3D12BuildPipelines(m_xessContext, nullptr, true, initFlags), "Unable to build XeSS pipelines");
+    const double buildPipelinesMs = elapsedMs(startTime);
+
+    startTime = std::chrono::high_resolution_clock::now();
     ThrowIfFailed(xessD3D12Init(m_xessContext, &params), "Unable to initialize XeSS context");
+    const double initMs = elapsedMs(startTime);
+
+    // No pipeline library is used, every start builds cold unless the driver caches the shaders.
+    char startup[160];
+    sprintf_s(startup, "XeSS startup: create context %.3f ms, build pipelines %.3f ms, init %.3f ms\n",
+        createContextMs, buildPipelinesMs, initMs);
+    OutputDebugStringA(startup);
+
+    if (m_enableProfiling)
+    {
+        m_profiling.Init(m_xessContext, xessGetProfilingData);
+
+        if (!m_profileLogPath.empty())
+        {
+            if (m_profilingLog.Open(ToNarrowPath(m_profileLogPath)))
+            {
+                m_profiling.SetLog(&m_profilingLog);
+            }
+            else
+            {
+                OutputDebugStringA("Unable to create the profiling log\n");
+            }
+        }
+
+        if (!m_tracePath.empty())
+        {
+            if (m_trace.Open(ToNarrowPath(m_tracePath)))
+            {
+                m_profiling.SetTrace(&m_trace);
+            }
+            else
+            {
+                OutputDebugStringA("Unable to create the trace file\n");
+            }
+        }
+    }
 
     // Get optimal input resolution
     ThrowIfFailed(xessGetInputResolution(
@@ -855,6 +961,8 @@ void BasicSampleD3D12::CreateFSQPipeline()
 // Update frame-based values.
 void BasicSampleD3D12::OnUpdate()
 {
+    PerfTools::ScopedCpuTimer cpuTimer(m_cpuZones.update);
+
     if (last_time.time_since_epoch().count() == 0)
     {
         last_time = std::chrono::high_resolution_clock::now();
@@ -914,10 +1022,19 @@ void BasicSampleD3D12::OnRender()
     ID3D12CommandList* ppCommandLists[] = {m_commandList.Get()};
     m_commandQueue->ExecuteCommandLists(_countof(ppCommandLists), ppCommandLists);
 
+    // Poll profiling data of completed frames, never waits for the GPU.
+    m_profiling.Update();
+
     // Present the frame.
-    ThrowIfFailed(m_swapChain->Present(0, 0));
+    {
+        PerfTools::ScopedCpuTimer cpuTimer(m_cpuZones.present);
+        ThrowIfFailed(m_swapChain->Present(0, 0));
+    }
+    PublishTelemetry();
+    DetectAnomalies();
 
     MoveToNextFrame();
+    DrainCpuTimers();
 }
 
 void BasicSampleD3D12::OnDestroy()
@@ -926,14 +1043,48 @@ void BasicSampleD3D12::OnDestroy()
     // cleaned up by the destructor.
     WaitForGpu();
 
+    if (m_enableCpuTimers)
+    {
+        DrainCpuTimers();
+        PerfTools::CpuTimers::SetEnabled(false);
+        OutputDebugStringA(m_cpuTimerStatistics.FormatReport(m_cpuTimerFrames).c_str());
+    }
+
+    if (m_profiling.IsInitialized())
+    {
+        m_profiling.Flush();
+        OutputDebugStringA(m_profiling.FormatReport().c_str());
+        m_profiling.SetLog(nullptr);
+        m_profiling.SetTrace(nullptr);
+        if (m_profilingLog.GetDroppedRecordCount() != 0)
+        {
+            char line[96];
+            sprintf_s(line, "Profiling log: %llu records dropped, more than %u passes\n",
+                (unsigned long long)m_profilingLog.GetDroppedRecordCount(), PerfTools::PassNameTable::MaxNames);
+            OutputDebugStringA(line);
+        }
+        m_profilingLog.Close();
+        m_trace.Close();
+    }
+
     ThrowIfFailed(xessDestroyContext(m_xessContext), "Unable to destroy XeSS context");
 
+    m_dumpStream.Close();
+    m_periodicDump.Stop();
+    m_telemetry.Close();
+
     CloseHandle(m_fenceEvent);
 }
 
 // Fill the command list with all the render commands and dependent state.
 void BasicSampleD3D12::PopulateCommandList()
 {
+    PerfTools::ScopedCpuTimer cpuTimer(m_cpuZones.populateCommandList);
+
+    // The fence wait in MoveToNextFrame guarantees that copies recorded for this
+    // frame index have completed.
+    PublishReadbackFrame();
+
     // Command list allocators can only be reset when the associated
     // command lists have finished execution on the GPU; apps should use
     // fences to determine GPU execution progress.
@@ -1042,7 +1193,18 @@ void BasicSampleD3D12::PopulateCommandList()
         exec_params.pDepthTexture = nullptr;
         #endif
         exec_params.pExposureScaleTexture = 0;
-        ThrowIfFailed(xessD3D12Execute(m_xessContext, m_commandList.Get(), &exec_params), "Unable to run XeSS");
+        if (m_trace.IsOpen())
+        {
+            m_trace.AddXessExecute(PerfTools::TraceExporter::Now());
+        }
+        {
+            PerfTools::ScopedCpuTimer cpuTimer(m_cpuZones.xessExecute);
+            ThrowIfFailed(xessD3D12Execute(m_xessContext, m_commandList.Get(), &exec_params), "Unable to run XeSS");
+        }
+
+        m_readbackJitter[m_frameIndex][0] = exec_params.jitterOffsetX;
+        m_readbackJitter[m_frameIndex][1] = exec_params.jitterOffsetY;
+        RecordReadbackCopies();
     }
 
     // Render XeSS output using full screen quad
@@ -1098,6 +1260,190 @@ void BasicSampleD3D12::PopulateCommandList()
     }
 
     ThrowIfFailed(m_commandList->Close());
+
+    m_frameNumber++;
+}
+
+// Create readback buffers for the elements requested by the dump stream and periodic dumps.
+void BasicSampleD3D12::InitFrameReadback()
+{
+    const bool soakDump = m_soakDumpFrames != 0 || m_soakDumpSeconds > 0.f;
+    const bool periodicDump = soakDump || m_enableAnomalyDetector;
+    if (m_dumpStreamMask == 0 && !periodicDump)
+    {
+        return;
+    }
+
+    // Periodic and anomaly dumps keep everything the sample can read back.
+    const UINT readbackMask = periodicDump ? XESS_DUMP_ALL : m_dumpStreamMask;
+
+    UINT slotDataSize = 0;
+    auto addReadback = [&](xess_dump_element_bits_t element, PerfTools::PixelFormat format,
+        ComPtr<ID3D12Resource>* sources, D3D12_RESOURCE_STATES sourceState)
+    {
+        if ((readbackMask & element) == 0)
+        {
+            return;
+        }
+
+        D3D12_RESOURCE_DESC desc = sources[0]->GetDesc();
+        D3D12_PLACED_SUBRESOURCE_FOOTPRINT footprint;
+        UINT64 totalBytes = 0;
+        m_device->GetCopyableFootprints(&desc, 0, 1, 0, &footprint, nullptr, nullptr, &totalBytes);
+
+        auto heap_props = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_READBACK);
+        auto buffer_desc = CD3DX12_RESOURCE_DESC::Buffer(totalBytes);
+        for (UINT n = 0; n < FrameCount; ++n)
+        {
+            FrameReadback readback{element, format, sources[n].Get(), sourceState, footprint, nullptr};
+            ThrowIfFailed(m_device->CreateCommittedResource(&heap_props, D3D12_HEAP_FLAG_NONE,
+                &buffer_desc, D3D12_RESOURCE_STATE_COPY_DEST, nullptr, IID_PPV_ARGS(&readback.buffer)));
+            readback.buffer->SetName((std::wstring(L"FrameReadback") + std::to_wstring(n)).c_str());
+            m_readbacks[n].push_back(readback);
+        }
+
+        // Rows are stored tightly packed, plus alignment of the element.
+        slotDataSize += (UINT)desc.Width * desc.Height * PerfTools::GetPixelFormatSize(format) + 256;
+    };
+
+    // Depth is typeless in this sample and is not read back.
+    addReadback(XESS_DUMP_INPUT_COLOR, PerfTools::PixelFormat::R16G16B16A16_FLOAT,
+        m_renderTargets, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+    addReadback(XESS_DUMP_INPUT_VELOCITY, PerfTools::PixelFormat::R16G16_FLOAT,
+        m_renderTargetsVelocity, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE);
+    addReadback(XESS_DUMP_OUTPUT, PerfTools::PixelFormat::R16G16B16A16_FLOAT,
+        m_xessOutput, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+
+    if (m_readbacks[0].empty())
+    {
+        OutputDebugStringA("Frame readback: none of the requested elements can be read back\n");
+        return;
+    }
+
+    if (m_dumpStreamMask != 0 &&
+        !m_dumpStream.Create(PerfTools::DumpStreamDefaultName, m_dumpStreamMask, 3, slotDataSize))
+    {
+        throw std::runtime_error("Unable to create dump stream");
+    }
+
+    if (periodicDump)
+    {
+        PerfTools::PeriodicDumpSchedule schedule;
+        schedule.elementsMask = XESS_DUMP_ALL;
+        schedule.frameInterval = m_soakDumpFrames;
+        schedule.secondsInterval = m_soakDumpSeconds;
+        schedule.onDemand = m_enableAnomalyDetector;
+        if (!soakDump)
+        {
+            schedule.folder = "anomaly_dump";
+        }
+        schedule.maxDiskBytes = (std::uint64_t)m_soakDumpBudgetMB << 20;
+        schedule.maxSampleBytes = slotDataSize;
+        if (!m_periodicDump.Start(schedule))
+        {
+            throw std::runtime_error("Unable to start periodic dump to folder " + schedule.folder);
+        }
+    }
+}
+
+// Copy the read back elements of the current frame to its readback buffers.
+void BasicSampleD3D12::RecordReadbackCopies()
+{
+    const bool sampled = m_periodicDump.IsSampleDue(m_frameNumber);
+    if (!m_dumpStream.IsOpen() && !sampled)
+    {
+        return;
+    }
+
+    const std::vector<FrameReadback>& readbacks = m_readbacks[m_frameIndex];
+
+    std::vector<CD3DX12_RESOURCE_BARRIER> transitions;
+    for (const FrameReadback& readback : readbacks)
+    {
+        transitions.push_back(CD3DX12_RESOURCE_BARRIER::Transition(readback.source,
+            readback.sourceState, D3D12_RESOURCE_STATE_COPY_SOURCE));
+    }
+    m_commandList->ResourceBarrier((UINT)transitions.size(), transitions.data());
+
+    for (const FrameReadback& readback : readbacks)
+    {
+        CD3DX12_TEXTURE_COPY_LOCATION dst(readback.buffer.Get(), readback.footprint);
+        CD3DX12_TEXTURE_COPY_LOCATION src(readback.source, 0);
+        m_commandList->CopyTextureRegion(&dst, 0, 0, 0, &src, nullptr);
+    }
+
+    transitions.clear();
+    for (const FrameReadback& readback : readbacks)
+    {
+        transitions.push_back(CD3DX12_RESOURCE_BARRIER::Transition(readback.source,
+            D3D12_RESOURCE_STATE_COPY_SOURCE, readback.sourceState));
+    }
+    m_commandList->ResourceBarrier((UINT)transitions.size(), transitions.data());
+
+    m_readbackPending[m_frameIndex] = true;
+    m_readbackSampled[m_frameIndex] = sampled;
+    m_readbackFrameIndex[m_frameIndex] = m_frameNumber;
+}
+
+// Hand the readback data of a completed frame to the dump stream consumer and periodic dumps.
+void BasicSampleD3D12::PublishReadbackFrame()
+{
+    if (!m_readbackPending[m_frameIndex])
+    {
+        return;
+    }
+    m_readbackPending[m_frameIndex] = false;
+
+    // Frames are dropped when the consumer or the disk lags behind, the application is never blocked.
+    const UINT64 frameIndex = m_readbackFrameIndex[m_frameIndex];
+    const bool stream = m_dumpStream.IsOpen() && m_dumpStream.BeginFrame(frameIndex,
+        m_readbackJitter[m_frameIndex][0], m_readbackJitter[m_frameIndex][1]);
+    const bool sample = m_readbackSampled[m_frameIndex] && m_periodicDump.BeginSample(frameIndex);
+    if (!stream && !sample)
+    {
+        return;
+    }
+
+    for (const FrameReadback& readback : m_readbacks[m_frameIndex])
+    {
+        const D3D12_SUBRESOURCE_FOOTPRINT& footprint = readback.footprint.Footprint;
+        const UINT rowSize = footprint.Width * PerfTools::GetPixelFormatSize(readback.format);
+        std::uint8_t* streamDst = stream ? m_dumpStream.AddElement(
+            readback.element, readback.format, footprint.Width, footprint.Height, rowSize) : nullptr;
+        std::uint8_t* sampleDst = sample ? m_periodicDump.AddElement(
+            readback.element, readback.format, footprint.Width, footprint.Height, rowSize) : nullptr;
+        if (streamDst == nullptr && sampleDst == nullptr)
+        {
+            continue;
+        }
+
+        UINT8* src = nullptr;
+        CD3DX12_RANGE readRange(0, (SIZE_T)footprint.RowPitch * footprint.Height);
+        ThrowIfFailed(readback.buffer->Map(0, &readRange, reinterpret_cast<void**>(&src)));
+        for (UINT y = 0; y < footprint.Height; ++y)
+        {
+            const UINT8* row = src + (SIZE_T)y * footprint.RowPitch;
+            if (streamDst != nullptr)
+            {
+                memcpy(streamDst + (SIZE_T)y * rowSize, row, rowSize);
+            }
+            if (sampleDst != nullptr)
+            {
+                memcpy(sampleDst + (SIZE_T)y * rowSize, row, rowSize);
+            }
+        }
+        CD3DX12_RANGE writeRange(0, 0);
+        readback.buffer->Unmap(0, &writeRange);
+    }
+
+    if (stream)
+    {
+        m_dumpStream.EndFrame();
+    }
+    if (sample)
+    {
+        m_periodicDump.EndSample();
+    }
 }
 
 // Wait for pending GPU work to complete.
@@ -1127,10 +1473,85 @@ void BasicSampleD3D12::MoveToNextFrame()
     // If the next frame is not ready to be rendered yet, wait until it is ready.
     if (m_fence->GetCompletedValue() < m_fenceValues[m_frameIndex])
     {
+        PerfTools::ScopedCpuTimer cpuTimer(m_cpuZones.fenceWait);
         ThrowIfFailed(m_fence->SetEventOnCompletion(m_fenceValues[m_frameIndex], m_fenceEvent));
         WaitForSingleObjectEx(m_fenceEvent, INFINITE, FALSE);
     }
 
     // Set the fence value for the next frame.
     m_fenceValues[m_frameIndex] = currentFenceValue + 1;
+}
+
+// Move the CPU timer samples of the frame into the statistics and the trace.
+void BasicSampleD3D12::DrainCpuTimers()
+{
+    if (!m_enableCpuTimers)
+    {
+        return;
+    }
+
+    const std::uint32_t count = PerfTools::CpuTimers::Drain(m_cpuTimerSamples.data(), (std::uint32_t)m_cpuTimerSamples.size());
+    m_cpuTimerStatistics.Add(m_cpuTimerSamples.data(), count);
+    m_trace.AddCpuTimerSamples(m_cpuTimerSamples.data(), count);
+    m_cpuTimerFrames++;
+}
+
+// Publish the telemetry of the presented frame. The XeSS GPU time is the one of
+// the last polled execution, which lags a few frames behind.
+void BasicSampleD3D12::PublishTelemetry()
+{
+    if (!m_telemetry.IsOpen())
+    {
+        return;
+    }
+
+    PerfTools::TelemetryRecord record = {};
+    record.frameIndex = m_frameNumber;
+    const double xessGpuTimeMs = m_profiling.GetLastExecutionMs();
+    if (xessGpuTimeMs > 0.0)
+    {
+        record.xessGpuTimeMs = (float)xessGpuTimeMs;
+        record.validFields |= PerfTools::TelemetryXessGpuTime;
+    }
+    m_telemetry.Publish(record);
+}
+
+// Feed the anomaly detector and capture the next frame when it reports an event.
+void BasicSampleD3D12::DetectAnomalies()
+{
+    if (!m_enableAnomalyDetector)
+    {
+        return;
+    }
+
+    bool raised = false;
+    const UINT64 now = PerfTools::TraceExporter::Now();
+    if (m_anomalyLastFrameNs != 0)
+    {
+        raised |= m_anomalyDetector.Add(m_anomalySignals.frameTime, m_frameNumber, (now - m_anomalyLastFrameNs) * 1e-6);
+    }
+    m_anomalyLastFrameNs = now;
+
+    // The aggregator keeps only the last polled execution, feed each one once.
+    const UINT64 executions = m_profiling.GetExecutionCount();
+    if (executions != m_anomalyXessExecutions)
+    {
+        raised |= m_anomalyDetector.Add(m_anomalySignals.xessGpuTime, m_frameNumber, m_profiling.GetLastExecutionMs());
+        m_anomalyXessExecutions = executions;
+    }
+
+    if (!raised)
+    {
+        return;
+    }
+
+    m_periodicDump.RequestSample();
+    PerfTools::AnomalyEvent events[4];
+    while (std::uint32_t count = m_anomalyDetector.Drain(events, _countof(events)))
+    {
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            OutputDebugStringA(m_anomalyDetector.FormatEvent(events[i]).c_str());
+        }
+    }
 }
\ No newline at end of file
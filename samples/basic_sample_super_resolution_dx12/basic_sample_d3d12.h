@@ -15,6 +15,14 @@
 
 #include "DXSample.h"
 #include "xess/xess_d3d12.h"
+#include "anomaly_detector.h"
+#include "cpu_timers.h"
+#include "dump_stream.h"
+#include "periodic_dump.h"
+#include "profiling_aggregator.h"
+#include "profiling_log.h"
+#include "telemetry.h"
+#include "trace_exporter.h"
 
 #include <chrono>
 
@@ -146,6 +154,55 @@ private:
     ComPtr<ID3D12Resource> m_xessOutput[FrameCount];
     const xess_quality_settings_t m_quality = XESS_QUALITY_SETTING_PERFORMANCE;
 
+    // CPU copies of frame elements for the live dump stream and periodic dumps
+    struct FrameReadback
+    {
+        xess_dump_element_bits_t element;
+        PerfTools::PixelFormat format;
+        ID3D12Resource* source;
+        D3D12_RESOURCE_STATES sourceState;
+        D3D12_PLACED_SUBRESOURCE_FOOTPRINT footprint;
+        ComPtr<ID3D12Resource> buffer;
+    };
+    PerfTools::DumpStreamWriter m_dumpStream;
+    PerfTools::PeriodicDumper m_periodicDump;
+    std::vector<FrameReadback> m_readbacks[FrameCount];
+    bool m_readbackPending[FrameCount] = {};
+    bool m_readbackSampled[FrameCount] = {};
+    UINT64 m_readbackFrameIndex[FrameCount] = {};
+    float m_readbackJitter[FrameCount][2] = {};
+    UINT64 m_frameNumber = 0;
+
+    PerfTools::ProfilingAggregator m_profiling;
+    PerfTools::ProfilingLogWriter m_profilingLog;
+    PerfTools::TraceExporter m_trace;
+    PerfTools::TelemetryWriter m_telemetry;
+
+    // Online detection on frame times and polled XeSS GPU times
+    struct AnomalySignals
+    {
+        std::uint32_t frameTime;
+        std::uint32_t xessGpuTime;
+    };
+    AnomalySignals m_anomalySignals = {};
+    PerfTools::AnomalyDetector m_anomalyDetector;
+    UINT64 m_anomalyLastFrameNs = 0;
+    UINT64 m_anomalyXessExecutions = 0;
+
+    // CPU scope timers of the frame loop, drained once per frame
+    struct CpuZones
+    {
+        std::uint32_t update;
+        std::uint32_t populateCommandList;
+        std::uint32_t xessExecute;
+        std::uint32_t present;
+        std::uint32_t fenceWait;
+    };
+    CpuZones m_cpuZones = {};
+    PerfTools::CpuTimerStatistics m_cpuTimerStatistics;
+    std::vector<PerfTools::CpuTimerSample> m_cpuTimerSamples;
+    UINT64 m_cpuTimerFrames = 0;
+
     std::chrono::time_point<std::chrono::high_resolution_clock> last_time;
     std::chrono::time_point<std::chrono::high_resolution_clock> last_fps_time;
 
@@ -156,6 +213,13 @@ private:
     void PopulateCommandList();
     void WaitForGpu();
     void MoveToNextFrame();
+    void DrainCpuTimers();
+    void PublishTelemetry();
+    void DetectAnomalies();
+
+    void InitFrameReadback();
+    void RecordReadbackCopies();
+    void PublishReadbackFrame();
 
     void CompileFromFile(LPCWSTR path, const char* entryPoint, const char* shaderModel, UINT compileFlags, ComPtr<ID3DBlob>& shader);
 };
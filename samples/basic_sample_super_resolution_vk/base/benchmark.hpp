@@ -13,12 +13,199 @@
 #include <functional>
 #include <chrono>
 #include <iomanip>
+#include <cmath>
 
 namespace vks
 {
+	/*
+	* Fixed resolution frame time histogram, 10 us buckets up to one second
+	* Longer frames share the last bucket, the exact maximum is tracked separately
+	* Storage is allocated once in reset(), adding frames never allocates
+	*/
+	class FrameTimeHistogram {
+	public:
+		static const uint32_t bucketsPerMs = 100;
+		static const uint32_t bucketCount = 1000 * bucketsPerMs + 1;
+
+		void reset() {
+			buckets.assign(bucketCount, 0);
+			count = 0;
+			max = 0.0;
+		}
+
+		void add(double ms) {
+			uint32_t index = (uint32_t)std::min(std::max(ms, 0.0) * bucketsPerMs, (double)(bucketCount - 1));
+			buckets[index]++;
+			count++;
+			max = std::max(max, ms);
+		}
+
+		// Frame time below or at which the given percentage of frames lies, rounded up to the bucket
+		double percentile(double p) const {
+			if (count == 0) {
+				return 0.0;
+			}
+			uint64_t target = std::max<uint64_t>(1, (uint64_t)std::ceil(std::min(std::max(p, 0.0), 100.0) / 100.0 * count));
+			uint64_t cumulative = 0;
+			for (uint32_t i = 0; i < bucketCount; i++) {
+				cumulative += buckets[i];
+				if (cumulative >= target) {
+					return std::min(bucketUpper(i), max);
+				}
+			}
+			return max;
+		}
+
+		// Average frame time of the slowest fraction of frames, e.g. 0.01 for the 1% low
+		double slowestAverage(double fraction) const {
+			if (count == 0) {
+				return 0.0;
+			}
+			uint64_t target = std::max<uint64_t>(1, (uint64_t)std::ceil(fraction * count));
+			uint64_t taken = 0;
+			double sum = 0.0;
+			for (uint32_t i = bucketCount; i-- > 0 && taken < target;) {
+				uint64_t n = std::min<uint64_t>(buckets[i], target - taken);
+				if (n == 0) {
+					continue;
+				}
+				// Bucket centers, the overflow bucket only holds frames of a second and more
+				double value = (i == bucketCount - 1) ? max : std::min((i + 0.5) / bucketsPerMs, max);
+				sum += n * value;
+				taken += n;
+			}
+			return sum / (double)taken;
+		}
+
+		uint64_t getCount() const { return count; }
+
+	private:
+		static double bucketUpper(uint32_t i) { return (double)(i + 1) / bucketsPerMs; }
+
+		std::vector<uint64_t> buckets;
+		uint64_t count = 0;
+		double max = 0.0;
+	};
+
+	/*
+	* Frame time statistics gathered while the benchmark runs
+	* Mean and standard deviation use Welford's online algorithm
+	* A frame counts as stutter when it takes longer than stutterFactor times
+	* the exponential moving average of the previous frames
+	*/
+	class FrameTimeStatistics {
+	public:
+		double stutterFactor = 2.0;
+
+		void reset() {
+			frameTimes.reset();
+			deltas.reset();
+			count = 0;
+			mean = 0.0;
+			m2 = 0.0;
+			min = std::numeric_limits<double>::max();
+			max = 0.0;
+			previous = 0.0;
+			average = 0.0;
+			deltaSum = 0.0;
+			deltaMax = 0.0;
+			stutterCount = 0;
+		}
+
+		void add(double ms) {
+			count++;
+			double d = ms - mean;
+			mean += d / count;
+			m2 += d * (ms - mean);
+			min = std::min(min, ms);
+			max = std::max(max, ms);
+			frameTimes.add(ms);
+
+			if (count > 1) {
+				double delta = std::abs(ms - previous);
+				deltas.add(delta);
+				deltaSum += delta;
+				deltaMax = std::max(deltaMax, delta);
+				if (ms > stutterFactor * average) {
+					stutterCount++;
+				}
+				average += 0.1 * (ms - average);
+			}
+			else {
+				average = ms;
+			}
+			previous = ms;
+		}
+
+		uint64_t getCount() const { return count; }
+		double getMin() const { return count > 0 ? min : 0.0; }
+		double getMax() const { return max; }
+		double getMean() const { return mean; }
+		double getStdDev() const { return count > 1 ? std::sqrt(m2 / (count - 1)) : 0.0; }
+		double getPercentile(double p) const { return frameTimes.percentile(p); }
+		// Average fps of the slowest fraction of frames
+		double getLowFps(double fraction) const {
+			double ms = frameTimes.slowestAverage(fraction);
+			return ms > 0.0 ? 1000.0 / ms : 0.0;
+		}
+		double getDeltaMean() const { return count > 1 ? deltaSum / (count - 1) : 0.0; }
+		double getDeltaPercentile(double p) const { return deltas.percentile(p); }
+		double getDeltaMax() const { return deltaMax; }
+		uint64_t getStutterCount() const { return stutterCount; }
+
+	private:
+		FrameTimeHistogram frameTimes;
+		FrameTimeHistogram deltas;
+		uint64_t count = 0;
+		double mean = 0.0;
+		double m2 = 0.0;
+		double min = std::numeric_limits<double>::max();
+		double max = 0.0;
+		double previous = 0.0;
+		double average = 0.0;
+		double deltaSum = 0.0;
+		double deltaMax = 0.0;
+		uint64_t stutterCount = 0;
+	};
+
+	/*
+	* Durations of the blocking XeSS startup calls of one context, in milliseconds
+	* The pipeline cache is warm if it held data beyond its header before the pipelines were built
+	* A non-blocking build only starts the build, the remaining build time is part of the initialization
+	*/
+	struct StartupRun {
+		bool warmCache = false;
+		bool nonBlockingBuild = false;
+		bool pipelinesReadyAtInit = false;
+		double createContextMs = 0.0;
+		double buildPipelinesMs = 0.0;
+		double initMs = 0.0;
+		size_t cacheBytesBefore = 0;
+		size_t cacheBytesAfter = 0;
+
+		double totalMs() const { return createContextMs + buildPipelinesMs + initMs; }
+	};
+
+#if defined(_WIN32)
+	// Parent console of the benchmark output, attached on first use and freed at process teardown
+	// Sweeps run a new benchmark per combination, so neither may happen per run
+	class BenchmarkConsole {
+	public:
+		BenchmarkConsole() {
+			AttachConsole(ATTACH_PARENT_PROCESS);
+			freopen_s(&stream, "CONOUT$", "w+", stdout);
+			freopen_s(&stream, "CONOUT$", "w+", stderr);
+		}
+		~BenchmarkConsole() {
+			FreeConsole();
+		}
+	private:
+		FILE *stream = nullptr;
+	};
+#endif
+
 	class Benchmark {
 	private:
-		FILE *stream;
 		VkPhysicalDeviceProperties deviceProps;
 	public:
 		bool active = false;
@@ -26,8 +213,17 @@ namespace vks
 		int outputFrames = -1; // -1 means no frames limit
 		uint32_t warmup = 1;
 		uint32_t duration = 10;
+		// Upper bound of frame times kept for the results file, statistics cover all frames
+		uint32_t maxRecordedFrames = 1 << 20;
 		std::vector<double> frameTimes;
+		FrameTimeStatistics statistics;
 		std::string filename = "";
+		std::string jsonFilename = "";
+		// XeSS startups of the run, added to the JSON summary
+		std::vector<StartupRun> startupRuns;
+		// Time from the start of the sample startup to the first frame, and whether the startup overlapped the XeSS pipeline build
+		double timeToFirstFrameMs = 0.0;
+		bool overlappedStartup = false;
 
 		double runtime = 0.0;
 		uint32_t frameCount = 0;
@@ -36,13 +232,18 @@ namespace vks
 			active = true;
 			this->deviceProps = deviceProps_;
 #if defined(_WIN32)
-			AttachConsole(ATTACH_PARENT_PROCESS);
-			freopen_s(&stream, "CONOUT$", "w+", stdout);
-			freopen_s(&stream, "CONOUT$", "w+", stderr);
+			static BenchmarkConsole console;
 #endif
 			std::ios_base::fmtflags cOutSavedFlags(std::cout.flags());
 			std::cout << std::fixed << std::setprecision(3);
 
+			// Allocate everything up front, the benchmark phase must not allocate
+			statistics.reset();
+			frameTimes.clear();
+			if (outputFrameTimes) {
+				frameTimes.reserve(outputFrames > 0 ? std::min((uint32_t)outputFrames, maxRecordedFrames) : maxRecordedFrames);
+			}
+
 			// Warm up phase to get more stable frame rates
 			{
 				double tMeasured = 0.0;
@@ -61,7 +262,10 @@ namespace vks
 					renderFunc();
 					auto tDiff = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - tStart).count();
 					runtime += tDiff;
-					frameTimes.push_back(tDiff);
+					statistics.add(tDiff);
+					if (frameTimes.size() < frameTimes.capacity()) {
+						frameTimes.push_back(tDiff);
+					}
 					frameCount++;
 					if (outputFrames != -1 && outputFrames == (int)frameCount) break;
 				};
@@ -70,6 +274,11 @@ namespace vks
 				std::cout << "runtime: " << (runtime / 1000.0) << "\n";
 				std::cout << "frames : " << frameCount << "\n";
 				std::cout << "fps    : " << frameCount / (runtime / 1000.0) << "\n";
+				std::cout << "p50/p90/p99/p99.9: " << statistics.getPercentile(50.0) << " / " << statistics.getPercentile(90.0) << " / "
+					<< statistics.getPercentile(99.0) << " / " << statistics.getPercentile(99.9) << " ms" << "\n";
+				std::cout << "1%/0.1% low: " << statistics.getLowFps(0.01) << " / " << statistics.getLowFps(0.001) << " fps" << "\n";
+				std::cout << "stddev : " << statistics.getStdDev() << " ms" << "\n";
+				std::cout << "stutter: " << statistics.getStutterCount() << " frames" << "\n";
 			}
 			std::cout.flags(cOutSavedFlags);
 		}
@@ -87,9 +296,9 @@ namespace vks
 					for (size_t i = 0; i < frameTimes.size(); i++) {
 						result << i << "," << frameTimes[i] << "\n";
 					}
-					double tMin = *std::min_element(frameTimes.begin(), frameTimes.end());
-					double tMax = *std::max_element(frameTimes.begin(), frameTimes.end());
-					double tAvg = std::accumulate(frameTimes.begin(), frameTimes.end(), 0.0) / (double)frameTimes.size();
+					double tMin = statistics.getMin();
+					double tMax = statistics.getMax();
+					double tAvg = statistics.getMean();
 					std::cout << "best   : " << (1000.0 / tMin) << " fps (" << tMin << " ms)" << "\n";
 					std::cout << "worst  : " << (1000.0 / tMax) << " fps (" << tMax << " ms)" << "\n";
 					std::cout << "avg    : " << (1000.0 / tAvg) << " fps (" << tAvg << " ms)" << "\n";
@@ -97,10 +306,111 @@ namespace vks
 				}
 
 				result.flush();
-#if defined(_WIN32)
-				FreeConsole();
-#endif
 			}
 		}
+
+		// Machine readable summary, frame times in milliseconds
+		void saveJson() {
+			std::ofstream result(jsonFilename, std::ios::out);
+			if (!result.is_open()) {
+				return;
+			}
+			std::string device = deviceProps.deviceName;
+			device.erase(std::remove_if(device.begin(), device.end(), [](char c) { return c == '"' || c == '\\'; }), device.end());
+
+			result << std::fixed << std::setprecision(4);
+			result << "{\n";
+			result << "  \"device\": \"" << device << "\",\n";
+			result << "  \"driverVersion\": " << deviceProps.driverVersion << ",\n";
+			result << "  \"runtimeMs\": " << runtime << ",\n";
+			result << "  \"frames\": " << frameCount << ",\n";
+			result << "  \"fps\": " << (runtime > 0.0 ? frameCount / (runtime / 1000.0) : 0.0) << ",\n";
+			result << "  \"frameTimeMs\": {\n";
+			result << "    \"min\": " << statistics.getMin() << ",\n";
+			result << "    \"mean\": " << statistics.getMean() << ",\n";
+			result << "    \"stddev\": " << statistics.getStdDev() << ",\n";
+			result << "    \"p50\": " << statistics.getPercentile(50.0) << ",\n";
+			result << "    \"p90\": " << statistics.getPercentile(90.0) << ",\n";
+			result << "    \"p99\": " << statistics.getPercentile(99.0) << ",\n";
+			result << "    \"p99.9\": " << statistics.getPercentile(99.9) << ",\n";
+			result << "    \"max\": " << statistics.getMax() << "\n";
+			result << "  },\n";
+			result << "  \"lowFps\": {\n";
+			result << "    \"1%\": " << statistics.getLowFps(0.01) << ",\n";
+			result << "    \"0.1%\": " << statistics.getLowFps(0.001) << "\n";
+			result << "  },\n";
+			result << "  \"frameToFrameDeltaMs\": {\n";
+			result << "    \"mean\": " << statistics.getDeltaMean() << ",\n";
+			result << "    \"p99\": " << statistics.getDeltaPercentile(99.0) << ",\n";
+			result << "    \"max\": " << statistics.getDeltaMax() << "\n";
+			result << "  },\n";
+			result << "  \"stutter\": {\n";
+			result << "    \"factor\": " << statistics.stutterFactor << ",\n";
+			result << "    \"frames\": " << statistics.getStutterCount() << ",\n";
+			result << "    \"percent\": " << (frameCount > 0 ? 100.0 * statistics.getStutterCount() / frameCount : 0.0) << "\n";
+			result << "  }";
+			if (!startupRuns.empty()) {
+				result << ",\n";
+				saveStartupJson(result);
+			}
+			result << "\n}\n";
+			result.flush();
+		}
+
+	private:
+		// Mean, min and max of every startup phase per cache state, followed by the individual runs
+		// Runs with a non-blocking build are left out of the statistics, as their phases are not comparable
+		void saveStartupJson(std::ofstream& result) const {
+			typedef double (*PhaseFunc)(const StartupRun&);
+			const std::pair<const char*, PhaseFunc> phases[] = {
+				{ "createContextMs", [](const StartupRun& run) { return run.createContextMs; } },
+				{ "buildPipelinesMs", [](const StartupRun& run) { return run.buildPipelinesMs; } },
+				{ "initMs", [](const StartupRun& run) { return run.initMs; } },
+				{ "totalMs", [](const StartupRun& run) { return run.totalMs(); } },
+			};
+
+			result << "  \"startup\": {\n";
+			result << "    \"timeToFirstFrameMs\": " << timeToFirstFrameMs << ",\n";
+			result << "    \"overlapped\": " << (overlappedStartup ? "true" : "false") << ",\n";
+			for (bool warm : { false, true }) {
+				uint32_t count = 0;
+				for (const StartupRun& run : startupRuns) {
+					count += run.warmCache == warm && !run.nonBlockingBuild ? 1 : 0;
+				}
+				result << "    \"" << (warm ? "warm" : "cold") << "\": {\n";
+				result << "      \"runs\": " << count;
+				for (const auto& phase : phases) {
+					double sum = 0.0;
+					double min = std::numeric_limits<double>::max();
+					double max = 0.0;
+					for (const StartupRun& run : startupRuns) {
+						if (run.warmCache == warm && !run.nonBlockingBuild) {
+							const double ms = phase.second(run);
+							sum += ms;
+							min = std::min(min, ms);
+							max = std::max(max, ms);
+						}
+					}
+					result << ",\n      \"" << phase.first << "\": { \"mean\": " << (count > 0 ? sum / count : 0.0)
+						<< ", \"min\": " << (count > 0 ? min : 0.0) << ", \"max\": " << max << " }";
+				}
+				result << "\n    },\n";
+			}
+			result << "    \"runs\": [\n";
+			for (size_t i = 0; i < startupRuns.size(); i++) {
+				const StartupRun& run = startupRuns[i];
+				result << "      { \"cache\": \"" << (run.warmCache ? "warm" : "cold") << "\""
+					<< ", \"nonBlockingBuild\": " << (run.nonBlockingBuild ? "true" : "false")
+					<< ", \"pipelinesReadyAtInit\": " << (run.pipelinesReadyAtInit ? "true" : "false")
+					<< ", \"createContextMs\": " << run.createContextMs
+					<< ", \"buildPipelinesMs\": " << run.buildPipelinesMs
+					<< ", \"initMs\": " << run.initMs
+					<< ", \"cacheBytesBefore\": " << run.cacheBytesBefore
+					<< ", \"cacheBytesAfter\": " << run.cacheBytesAfter << " }"
+					<< (i + 1 < startupRuns.size() ? ",\n" : "\n");
+			}
+			result << "    ]\n";
+			result << "  }";
+		}
 	};
-}
\ No newline at end of file
+}
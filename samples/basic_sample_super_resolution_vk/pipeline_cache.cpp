@@ -0,0 +1,173 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#include "pipeline_cache.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+namespace
+{
+    /**
+     * Checks the header written by the driver that created the data.
+     * @return empty if the data can be used with the device, the reason otherwise
+     */
+    std::string ValidateHeader(const std::vector<char>& data, const VkPhysicalDeviceProperties& properties)
+    {
+        VkPipelineCacheHeaderVersionOne header;
+        if (data.size() < sizeof(header))
+        {
+            return "file too small";
+        }
+        std::memcpy(&header, data.data(), sizeof(header));
+
+        if (header.headerSize < sizeof(header) || header.headerSize > data.size())
+        {
+            return "invalid header size";
+        }
+        if (header.headerVersion != VK_PIPELINE_CACHE_HEADER_VERSION_ONE)
+        {
+            return "unknown header version";
+        }
+        if (header.vendorID != properties.vendorID || header.deviceID != properties.deviceID)
+        {
+            return "created for another device";
+        }
+        if (std::memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) != 0)
+        {
+            return "created by another driver version";
+        }
+        return std::string();
+    }
+}
+
+bool PipelineCacheFile::Load(VkDevice device, const VkPhysicalDeviceProperties& properties, const std::string& path,
+    bool ignoreFile)
+{
+    Destroy();
+    m_device = device;
+    m_path = path;
+    m_loadedSize = 0;
+    m_rejectReason.clear();
+
+    std::vector<char> data;
+    if (!ignoreFile)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (file.is_open())
+        {
+            data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            m_rejectReason = ValidateHeader(data, properties);
+            if (!m_rejectReason.empty())
+            {
+                data.clear();
+            }
+        }
+    }
+
+    VkPipelineCacheCreateInfo pipelineCacheCI{};
+    pipelineCacheCI.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+    pipelineCacheCI.initialDataSize = data.size();
+    pipelineCacheCI.pInitialData = data.empty() ? nullptr : data.data();
+    VkResult result = vkCreatePipelineCache(m_device, &pipelineCacheCI, nullptr, &m_cache);
+    if (result != VK_SUCCESS && !data.empty())
+    {
+        // The driver may still refuse data that passed the header checks.
+        m_rejectReason = "rejected by the driver";
+        pipelineCacheCI.initialDataSize = 0;
+        pipelineCacheCI.pInitialData = nullptr;
+        result = vkCreatePipelineCache(m_device, &pipelineCacheCI, nullptr, &m_cache);
+    }
+    else
+    {
+        m_loadedSize = data.size();
+    }
+
+    if (result != VK_SUCCESS)
+    {
+        m_cache = VK_NULL_HANDLE;
+        return false;
+    }
+    return true;
+}
+
+bool PipelineCacheFile::Save(const std::vector<VkPipelineCache>& sources)
+{
+    if (m_cache == VK_NULL_HANDLE)
+    {
+        return false;
+    }
+
+    std::vector<VkPipelineCache> valid;
+    for (VkPipelineCache source : sources)
+    {
+        if (source != VK_NULL_HANDLE && source != m_cache)
+        {
+            valid.push_back(source);
+        }
+    }
+    if (!valid.empty() && vkMergePipelineCaches(m_device, m_cache, (uint32_t)valid.size(), valid.data()) != VK_SUCCESS)
+    {
+        return false;
+    }
+
+    // The size may grow between the two calls if other threads add pipelines.
+    std::size_t size = 0;
+    std::vector<char> data;
+    VkResult result;
+    do
+    {
+        if (vkGetPipelineCacheData(m_device, m_cache, &size, nullptr) != VK_SUCCESS)
+        {
+            return false;
+        }
+        data.resize(size);
+        result = vkGetPipelineCacheData(m_device, m_cache, &size, data.data());
+    } while (result == VK_INCOMPLETE);
+    if (result != VK_SUCCESS)
+    {
+        return false;
+    }
+
+    const std::string temporaryPath = m_path + ".tmp";
+    bool written;
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        written = file.write(data.data(), (std::streamsize)size) && file.flush();
+    }
+
+    std::error_code ec;
+    if (written)
+    {
+        // Replaces the old file, readers see either the old or the new cache.
+        std::filesystem::rename(temporaryPath, m_path, ec);
+    }
+    if (!written || ec)
+    {
+        std::filesystem::remove(temporaryPath, ec);
+        return false;
+    }
+    return true;
+}
+
+void PipelineCacheFile::Destroy()
+{
+    if (m_cache != VK_NULL_HANDLE)
+    {
+        vkDestroyPipelineCache(m_device, m_cache, nullptr);
+        m_cache = VK_NULL_HANDLE;
+    }
+}
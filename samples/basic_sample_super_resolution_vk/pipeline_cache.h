@@ -0,0 +1,69 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <vulkan/vulkan.h>
+
+/**
+ * Pipeline cache persisted between runs of the sample.
+ *
+ * Load fills the cache from the file if its VkPipelineCacheHeaderVersionOne
+ * header matches the vendor ID, device ID and pipeline cache UUID of the
+ * device, otherwise the cache starts empty. Save merges other caches into it
+ * and replaces the file atomically: the data is written to a temporary file
+ * that is then renamed over the old one, so an interrupted save never leaves a
+ * truncated cache behind.
+ */
+class PipelineCacheFile
+{
+public:
+    /**
+     * Creates the cache, filled from the file if it is valid for the device.
+     * @param path - cache file, read if it exists and written by Save
+     * @param ignoreFile - start empty even if the file is valid, e.g. to measure cold starts
+     * @return false if the pipeline cache cannot be created
+     */
+    bool Load(VkDevice device, const VkPhysicalDeviceProperties& properties, const std::string& path,
+        bool ignoreFile = false);
+
+    /**
+     * Merges the given caches into the cache and writes it to the file.
+     * @param sources - caches of the same device, left unchanged
+     * @return false if the cache data cannot be retrieved or written
+     */
+    bool Save(const std::vector<VkPipelineCache>& sources = {});
+
+    /** Destroys the cache without saving it. */
+    void Destroy();
+
+    VkPipelineCache Get() const { return m_cache; }
+
+    /** @return size of the file data the cache was created from, 0 if it started empty */
+    std::size_t GetLoadedSize() const { return m_loadedSize; }
+
+    /** @return why the file was not used, empty if it was used or does not exist */
+    const std::string& GetRejectReason() const { return m_rejectReason; }
+
+private:
+    VkDevice m_device = VK_NULL_HANDLE;
+    VkPipelineCache m_cache = VK_NULL_HANDLE;
+    std::string m_path;
+    std::size_t m_loadedSize = 0;
+    std::string m_rejectReason;
+};
@@ -0,0 +1,185 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#include "task_graph.h"
+
+#include <cassert>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+#include <utility>
+
+TaskGraph::TaskId TaskGraph::Add(const std::string& name, std::function<void()> func,
+    std::initializer_list<TaskId> dependencies, bool mainThread)
+{
+    const TaskId id = m_tasks.size();
+    Task task;
+    task.name = name;
+    task.func = std::move(func);
+    task.mainThread = mainThread;
+    for (TaskId dependency : dependencies)
+    {
+        assert(dependency < id);
+        m_tasks[dependency].dependents.push_back(id);
+        task.dependencyCount++;
+    }
+    m_tasks.push_back(std::move(task));
+    return id;
+}
+
+void TaskGraph::Run(uint32_t workerCount)
+{
+    m_start = std::chrono::steady_clock::now();
+    m_ready.clear();
+    m_readyMain.clear();
+    m_finished = 0;
+    m_running = 0;
+    m_error = nullptr;
+    for (Task& task : m_tasks)
+    {
+        task.pendingDependencies = task.dependencyCount;
+    }
+
+    if (workerCount == 0)
+    {
+        // The tasks are added after their dependencies, so the order of addition is a valid order of execution
+        for (TaskId id = 0; id < m_tasks.size() && !m_error; id++)
+        {
+            Execute(id, 0);
+        }
+    }
+    else
+    {
+        for (TaskId id = 0; id < m_tasks.size(); id++)
+        {
+            if (m_tasks[id].dependencyCount == 0)
+            {
+                (m_tasks[id].mainThread ? m_readyMain : m_ready).push_back(id);
+            }
+        }
+
+        std::vector<std::thread> workers;
+        for (uint32_t i = 1; i <= workerCount; i++)
+        {
+            workers.emplace_back(&TaskGraph::WorkerLoop, this, i);
+        }
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        for (;;)
+        {
+            m_cv.wait(lock, [this]
+                { return Done() || (!m_readyMain.empty() && !m_error); });
+            if (Done())
+            {
+                break;
+            }
+            const TaskId id = m_readyMain.front();
+            m_readyMain.erase(m_readyMain.begin());
+            m_running++;
+            lock.unlock();
+            Execute(id, 0);
+            lock.lock();
+        }
+        lock.unlock();
+
+        for (std::thread& worker : workers)
+        {
+            worker.join();
+        }
+    }
+
+    m_totalMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count();
+    if (m_error)
+    {
+        std::rethrow_exception(m_error);
+    }
+}
+
+std::string TaskGraph::FormatReport() const
+{
+    std::ostringstream report;
+    report << std::fixed << std::setprecision(3);
+    report << "Startup tasks [ms]\n";
+    report << std::left << std::setw(28) << "task" << std::right << std::setw(10) << "start" << std::setw(10) << "end"
+           << std::setw(10) << "duration" << std::setw(8) << "thread" << "\n";
+    for (const Task& task : m_tasks)
+    {
+        report << std::left << std::setw(28) << task.name << std::right << std::setw(10) << task.startMs << std::setw(10)
+               << task.endMs << std::setw(10) << task.endMs - task.startMs << std::setw(8) << task.thread << "\n";
+    }
+    report << std::left << std::setw(28) << "total" << std::right << std::setw(20) << m_totalMs << "\n";
+    return report.str();
+}
+
+bool TaskGraph::Done() const
+{
+    return m_finished == m_tasks.size() || (m_error && m_running == 0);
+}
+
+void TaskGraph::Execute(TaskId id, uint32_t thread)
+{
+    Task& task = m_tasks[id];
+    task.thread = thread;
+    task.startMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count();
+    std::exception_ptr error;
+    try
+    {
+        task.func();
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+    }
+    task.endMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (error && !m_error)
+    {
+        m_error = error;
+    }
+    if (m_running > 0)
+    {
+        m_running--;
+    }
+    m_finished++;
+    for (TaskId dependent : task.dependents)
+    {
+        if (--m_tasks[dependent].pendingDependencies == 0)
+        {
+            (m_tasks[dependent].mainThread ? m_readyMain : m_ready).push_back(dependent);
+        }
+    }
+    m_cv.notify_all();
+}
+
+void TaskGraph::WorkerLoop(uint32_t thread)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;)
+    {
+        m_cv.wait(lock, [this]
+            { return Done() || (!m_ready.empty() && !m_error); });
+        if (Done())
+        {
+            return;
+        }
+        // Oldest first, so that tasks start in the order they became ready
+        const TaskId id = m_ready.front();
+        m_ready.erase(m_ready.begin());
+        m_running++;
+        lock.unlock();
+        Execute(id, thread);
+        lock.lock();
+    }
+}
@@ -0,0 +1,98 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * Dependency graph of startup tasks executed on a set of worker threads.
+ *
+ * Tasks are added in an order where every dependency precedes its dependents
+ * and are started as soon as all their dependencies are finished. Tasks bound
+ * to the main thread, e.g. the ones that use the window or the queue, run on
+ * the thread calling Run. Without workers all tasks run on the calling thread
+ * in the order they were added, which gives the serial reference startup.
+ * If a task throws, no further tasks are started and Run rethrows the first
+ * exception once the running tasks are finished.
+ */
+class TaskGraph
+{
+public:
+    using TaskId = std::size_t;
+
+    /**
+     * Adds a task.
+     * @param name - name of the task in the report
+     * @param func - work of the task
+     * @param dependencies - tasks that must be finished before the task starts
+     * @param mainThread - run the task on the thread calling Run
+     * @return id of the task, used as dependency of later tasks
+     */
+    TaskId Add(const std::string& name, std::function<void()> func, std::initializer_list<TaskId> dependencies = {},
+        bool mainThread = false);
+
+    /**
+     * Runs all tasks and returns when they are finished.
+     * @param workerCount - number of worker threads, 0 runs all tasks on the calling thread
+     */
+    void Run(uint32_t workerCount);
+
+    /** @return duration of the last Run in milliseconds */
+    double GetTotalMs() const { return m_totalMs; }
+
+    /** @return start and end of every task relative to the start of the last Run and the thread it ran on */
+    std::string FormatReport() const;
+
+private:
+    struct Task
+    {
+        std::string name;
+        std::function<void()> func;
+        std::vector<TaskId> dependents;
+        bool mainThread = false;
+        uint32_t dependencyCount = 0;
+        // State of the current Run
+        uint32_t pendingDependencies = 0;
+        uint32_t thread = 0;
+        double startMs = 0.0;
+        double endMs = 0.0;
+    };
+
+    /** @return true if all tasks are finished or a task failed and no task is running anymore */
+    bool Done() const;
+    void Execute(TaskId id, uint32_t thread);
+    void WorkerLoop(uint32_t thread);
+
+    std::vector<Task> m_tasks;
+    std::chrono::steady_clock::time_point m_start;
+    double m_totalMs = 0.0;
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::vector<TaskId> m_ready;
+    std::vector<TaskId> m_readyMain;
+    std::size_t m_finished = 0;
+    std::size_t m_running = 0;
+    std::exception_ptr m_error;
+};
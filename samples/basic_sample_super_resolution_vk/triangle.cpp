@@ -12,15 +12,15 @@
 * This code is licensed under the MIT license (MIT) (http://opensource.org/licenses/MIT)
 */
 
-//#define USE_LOWRES_MV 1
-
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <assert.h>
 #include <fstream>
+#include <sstream>
 #include <vector>
 #include <exception>
+#include <thread>
 #include <Windows.h>
 
 #include <vulkan/vulkan.h>
@@ -28,8 +28,15 @@
 
 // XeSS-related utilities
 #include "utils.h"
+#include "pipeline_cache.h"
+#include "task_graph.h"
 
 #include "xess/xess_vk.h"
+#include "xess/xess_debug.h"
+
+#include "image_metrics.h"
+#include "pipeline_prewarm.h"
+#include "profiling_aggregator.h"
 
 // Set to "true" to enable Vulkan's validation layers (see vulkandebug.cpp for details)
 #if defined(_DEBUG)
@@ -42,6 +49,10 @@
 // This number defines how many frames may be worked on simultaneously at once
 #define MAX_CONCURRENT_FRAMES 2
 
+// Number of frames between writing the GPU timestamps of a frame and reading them back
+// Larger than the number of frames in flight, so that the results are available without waiting for the GPU
+#define GPU_TIMESTAMP_LATENCY (MAX_CONCURRENT_FRAMES + 1)
+
 class VulkanExample : public VulkanExampleBase
 {
 public:
@@ -140,9 +151,164 @@ public:
 	// Jitter
 	std::vector<std::pair<float, float>> m_haltonPointSet;
 	std::size_t m_haltonIndex = 0;
-	float jitter[2];
+	float jitter[2] = { 0.f, 0.f };
+	float previousJitter[2] = { 0.f, 0.f };
+
+	xess_quality_settings_t xessQuality = XESS_QUALITY_SETTING_PERFORMANCE;
+
+	// XeSS initialization flags, set with --xessflags and toggled at runtime with the keys 1 to 5
+	// Without XESS_INIT_FLAG_HIGH_RES_MV motion vectors are rendered at input resolution and depth is passed to XeSS
+	uint32_t xessInitFlags = XESS_INIT_FLAG_HIGH_RES_MV;
+
+	// Init flags switchable at runtime, each one is toggled relative to the default flags
+	// Low resolution motion vectors are selected by clearing XESS_INIT_FLAG_HIGH_RES_MV
+	struct InitFlagOption {
+		uint32_t flag;
+		const char* name;
+		uint32_t key;
+	};
+	const std::array<InitFlagOption, 5> initFlagOptions = { {
+		{ XESS_INIT_FLAG_HIGH_RES_MV, "lowresmv", '1' },
+		{ XESS_INIT_FLAG_ENABLE_AUTOEXPOSURE, "autoexposure", '2' },
+		{ XESS_INIT_FLAG_RESPONSIVE_PIXEL_MASK, "responsivemask", '3' },
+		{ XESS_INIT_FLAG_LDR_INPUT_COLOR, "ldrinput", '4' },
+		{ XESS_INIT_FLAG_JITTERED_MV, "jitteredmv", '5' },
+	} };
+
+	// Storage requirements reported by XeSS for the current initialization
+	xess_properties_t xessProperties{};
+
+	// Forces the XeSS 1.x scale factors for all quality settings
+	bool xessLegacyScaleFactors = false;
+
+	// Adds XESS_DEBUG_ENABLE_PROFILING to the init flags, the profiler folds the GPU durations into histograms
+	bool xessProfiling = false;
+	PerfTools::ProfilingAggregator xessProfiler;
+
+	// Pipeline cache of XeSS and the sample pipelines, loaded from disk at startup and saved on exit
+	// A build into it is cold if the file was missing, rejected or ignored with --coldpipelinecache
+	PipelineCacheFile pipelineCacheFile;
+
+	// Temporary contexts that build the pipelines of other init flags into the persistent pipeline cache
+	class XessPrewarmBackend : public PerfTools::PrewarmBackend {
+	public:
+		explicit XessPrewarmBackend(VulkanExample& example_) : example(example_) {}
+
+		xess_context_handle_t BeginBuild(uint32_t initFlags) override
+		{
+			xess_context_handle_t context = nullptr;
+			auto status = xessVKCreateContext(example.instance, example.physicalDevice, example.device, &context);
+			if (status != XESS_RESULT_SUCCESS) {
+				return nullptr;
+			}
+			if (example.xessNetworkModel != XESS_NETWORK_MODEL_UNKNOWN) {
+				status = xessSelectNetworkModel(context, example.xessNetworkModel);
+			}
+			if (status == XESS_RESULT_SUCCESS) {
+				status = xessVKBuildPipelines(context, example.pipelineCacheFile.Get(), false, initFlags);
+			}
+			if (status != XESS_RESULT_SUCCESS) {
+				xessDestroyContext(context);
+				return nullptr;
+			}
+			return context;
+		}
 
-	const xess_quality_settings_t xessQuality = XESS_QUALITY_SETTING_PERFORMANCE;
+		xess_result_t GetBuildStatus(xess_context_handle_t context) override
+		{
+			return xessGetPipelineBuildStatus(context);
+		}
+
+		void EndBuild(xess_context_handle_t context) override
+		{
+			xessDestroyContext(context);
+		}
+
+	private:
+		VulkanExample& example;
+	};
+	// Started with the render loop if --prewarm is set, must be stopped before the pipeline cache is saved
+	XessPrewarmBackend xessPrewarmBackend{ *this };
+	PerfTools::PipelinePrewarmer xessPrewarmer{ xessPrewarmBackend };
+
+	// Startup of the sample, its tasks run on worker threads while XeSS builds its pipelines unless --serialstartup is set
+	TaskGraph startupTasks;
+	std::chrono::high_resolution_clock::time_point startupStart;
+	vks::StartupRun xessStartup;
+
+	// Shader modules loaded by a startup task, destroyed once the pipelines are created
+	struct ShaderModules {
+		VkShaderModule vertex = VK_NULL_HANDLE;
+		VkShaderModule fragment = VK_NULL_HANDLE;
+	};
+	ShaderModules triangleShaders;
+	ShaderModules velocityShaders;
+	ShaderModules quadShaders;
+
+	// Passes recorded by render, each one is bracketed by timestamps and labeled with debug utils markers
+	enum GpuPass : uint32_t {
+		GPU_PASS_COLOR,
+		GPU_PASS_VELOCITY,
+		GPU_PASS_XESS,
+		GPU_PASS_FINAL,
+		GPU_PASS_COUNT
+	};
+	struct GpuPassInfo {
+		const char* name;
+		glm::vec4 labelColor;
+	};
+	const std::array<GpuPassInfo, GPU_PASS_COUNT> gpuPasses = { {
+		{ "color", glm::vec4(0.8f, 0.2f, 0.2f, 1.0f) },
+		{ "velocity", glm::vec4(0.2f, 0.8f, 0.2f, 1.0f) },
+		{ "xess", glm::vec4(0.2f, 0.4f, 0.9f, 1.0f) },
+		{ "final", glm::vec4(0.8f, 0.8f, 0.2f, 1.0f) },
+	} };
+
+	// GPU durations of the passes, enabled with --passtimers
+	// Every frame writes its timestamps into one of GPU_TIMESTAMP_LATENCY slots of the query pool, the slot is read back when it is reused
+	bool gpuPassTimers = false;
+	struct {
+		VkQueryPool pool = VK_NULL_HANDLE;
+		// Nanoseconds per timestamp tick
+		double period = 0.0;
+		uint64_t validMask = ~0ull;
+		// Frame number whose timestamps a slot holds, UINT64_MAX if the slot holds none
+		std::array<uint64_t, GPU_TIMESTAMP_LATENCY> slotFrame{};
+		uint64_t frame = 0;
+		// Frames dropped because their timestamps were not yet available when read back
+		uint64_t unavailableFrames = 0;
+	} gpuTimestamps;
+	PerfTools::ProfilingAggregator gpuPassProfiler;
+
+	// Fragment and compute shader invocations of the passes, collected with the pass timers if the device supports pipeline statistics
+	// Uses the slots of the timestamps, one query per pass
+	struct GpuPassCounters {
+		uint64_t frames = 0;
+		uint64_t fragmentInvocations = 0;
+		uint64_t computeInvocations = 0;
+	};
+	struct {
+		VkQueryPool pool = VK_NULL_HANDLE;
+		std::array<GpuPassCounters, GPU_PASS_COUNT> passes{};
+	} gpuStatistics;
+
+	// Per frame summary of a pass: GPU time, mean shader invocations and estimated memory traffic
+	struct GpuPassResult {
+		PerfTools::PassStatistics time{};
+		double fragmentInvocations = 0.0;
+		double computeInvocations = 0.0;
+		uint64_t bytesRead = 0;
+		uint64_t bytesWritten = 0;
+	};
+
+	// Network model selected before XeSS initialization, XESS_NETWORK_MODEL_UNKNOWN keeps the default model
+	xess_network_model_t xessNetworkModel = XESS_NETWORK_MODEL_UNKNOWN;
+
+	// Discards the XeSS history with the next execution
+	bool xessResetHistory = false;
+
+	// Simulation time step in seconds, replaces the measured frame time if greater than zero so that input sequences replay identically
+	double fixedFrameTime = 0.0;
 
 	xess_context_handle_t xessContext = nullptr;
 
@@ -188,6 +354,17 @@ public:
 	uint32_t velocityHeight = 0;
 
 	FrameBufferAttachment xessOutput;
+
+	// Responsive pixel mask at input resolution for XESS_INIT_FLAG_RESPONSIVE_PIXEL_MASK, no pixel is marked as responsive
+	FrameBufferAttachment responsiveMask;
+
+	// Network model sweep: supersampled reference of the current frame and host visible copies of reference and XeSS output
+	struct {
+		FrameBufferAttachment color, depth, resolved;
+		VkFramebuffer frameBuffer = VK_NULL_HANDLE;
+		vks::Buffer outputCopy;
+		vks::Buffer referenceCopy;
+	} qualityCapture;
 	
 	VulkanExample() : VulkanExampleBase(ENABLE_VALIDATION)
 	{
@@ -212,9 +389,16 @@ public:
 
 	~VulkanExample()
 	{
+		xessPrewarmer.Cancel();
+		xessPrewarmer.Wait();
 		auto status = xessDestroyContext(xessContext);
 		assert(status == XESS_RESULT_SUCCESS);
 		(void)status;
+		// The base class cache holds pipelines created outside of the sample, e.g. by the UI overlay
+		if (!pipelineCacheFile.Save({ pipelineCache })) {
+			std::cout << "Unable to save the pipeline cache\n";
+		}
+		pipelineCacheFile.Destroy();
 
 		// Clean up used Vulkan resources
 		// Note: Inherited destructor cleans up resources stored in base class
@@ -228,6 +412,7 @@ public:
 
 		offscreenFrameBuffers.velocity.destroy(device);
 		offscreenFrameBuffers.velocity.velocity.destroy(device);
+		responsiveMask.destroy(device);
 
 		xessOutput.destroy(device);
 
@@ -245,6 +430,9 @@ public:
 
 		vkDestroyCommandPool(device, commandPool, nullptr);
 
+		vkDestroyQueryPool(device, gpuTimestamps.pool, nullptr);
+		vkDestroyQueryPool(device, gpuStatistics.pool, nullptr);
+
 		for (uint32_t i = 0; i < MAX_CONCURRENT_FRAMES; i++)
 		{
 			vkDestroyFence(device, waitFences[i], nullptr);
@@ -263,6 +451,47 @@ public:
 				m_pause = !m_pause;
 				break;
 		}
+
+		for (const InitFlagOption& option : initFlagOptions) {
+			if (key == option.key) {
+				xessInitFlags ^= option.flag;
+				std::cout << "XeSS init flags: " << describeInitFlags(xessInitFlags)
+					<< (xessPrewarmer.IsPrewarmed(getXessInitFlags()) ? " (pipelines prewarmed)" : "") << "\n";
+				// Re-initializes XeSS and recreates the inputs that depend on the flags
+				resizeRenderTargets(width, height);
+			}
+		}
+	}
+
+	// Names of the init flags that differ from the default flags, joined by '+'
+	std::string describeInitFlags(uint32_t flags)
+	{
+		std::string description;
+		for (const InitFlagOption& option : initFlagOptions) {
+			if ((flags ^ XESS_INIT_FLAG_HIGH_RES_MV) & option.flag) {
+				description += (description.empty() ? "" : "+") + std::string(option.name);
+			}
+		}
+		return description.empty() ? "default" : description;
+	}
+
+	// Parse a comma separated list of init flag names, e.g. "lowresmv,autoexposure"
+	uint32_t parseInitFlags(const std::string& list)
+	{
+		uint32_t flags = XESS_INIT_FLAG_HIGH_RES_MV;
+		std::stringstream stream(list);
+		std::string name;
+		while (std::getline(stream, name, ',')) {
+			if (name.empty()) {
+				continue;
+			}
+			auto option = std::find_if(initFlagOptions.begin(), initFlagOptions.end(), [&name](const InitFlagOption& o) { return name == o.name; });
+			if (option == initFlagOptions.end()) {
+				throw std::runtime_error("Unknown XeSS init flag " + name);
+			}
+			flags ^= option->flag;
+		}
+		return flags;
 	}
 
 	// This function is used to request a device memory type that supports all the property flags we request (e.g. device local, host visible)
@@ -296,6 +525,10 @@ public:
 		{
 			throw std::runtime_error("Unable to get required XeSS device features");
 		}
+		// Optional, pipeline statistics of the pass timers
+		if (deviceFeatures.pipelineStatisticsQuery) {
+			enabledFeatures.features.pipelineStatisticsQuery = VK_TRUE;
+		}
 	}
 
 	void getEnabledExtensions() override
@@ -317,25 +550,71 @@ public:
 		}
 	}
 
-	void setupXess()
+	static double elapsedMs(std::chrono::high_resolution_clock::time_point start)
 	{
-		auto status = xessVKCreateContext(instance, physicalDevice, device, &xessContext);
+		return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+	}
+
+	VkPipelineCache createEmptyPipelineCache()
+	{
+		VkPipelineCacheCreateInfo pipelineCacheCI{};
+		pipelineCacheCI.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+		VkPipelineCache cache;
+		VK_CHECK_RESULT(vkCreatePipelineCache(device, &pipelineCacheCI, nullptr, &cache));
+		return cache;
+	}
+
+	size_t getPipelineCacheSize(VkPipelineCache cache)
+	{
+		size_t size = 0;
+		VK_CHECK_RESULT(vkGetPipelineCacheData(device, cache, &size, nullptr));
+		return size;
+	}
+
+	// Build the XeSS pipelines into the given cache and record the duration of the build
+	// A non-blocking build only starts the build, xessVKInit waits for its completion
+	void buildXessPipelines(xess_context_handle_t context, VkPipelineCache cache, vks::StartupRun& run, bool blocking = true)
+	{
+		run.cacheBytesBefore = getPipelineCacheSize(cache);
+		run.warmCache = run.cacheBytesBefore > sizeof(VkPipelineCacheHeaderVersionOne);
+		run.nonBlockingBuild = !blocking;
+		auto tStart = std::chrono::high_resolution_clock::now();
+		auto status = xessVKBuildPipelines(context, cache, blocking, getXessInitFlags());
+		run.buildPipelinesMs = elapsedMs(tStart);
 		if (status != XESS_RESULT_SUCCESS)
 		{
-			throw std::runtime_error("Unable to create XeSS context");
+			throw std::runtime_error("Unable to build XeSS pipelines");
+		}
+		if (blocking) {
+			run.cacheBytesAfter = getPipelineCacheSize(cache);
 		}
+	}
 
-		if (XESS_RESULT_WARNING_OLD_DRIVER == xessIsOptimalDriver(xessContext))
+	void loadPipelineCache()
+	{
+		const std::string cachePath = commandLineParser.getValueAsString("pipelinecache", "pipeline_cache.bin");
+		if (!pipelineCacheFile.Load(device, deviceProperties, cachePath, commandLineParser.isSet("coldpipelinecache")))
 		{
-			MessageBox(NULL, L"Please install the latest graphics driver from your vendor for optimal Intel(R) XeSS performance and visual quality", L"Important notice", MB_OK | MB_TOPMOST | MB_ICONINFORMATION);
+			throw std::runtime_error("Unable to create pipeline cache");
 		}
+		if (!pipelineCacheFile.GetRejectReason().empty()) {
+			std::cout << "Pipeline cache " << cachePath << " not used: " << pipelineCacheFile.GetRejectReason() << "\n";
+		}
+	}
 
-		xess_properties_t props;
-		xess_2d_t outputResoulution = { width, height };
-		status = xessGetProperties(xessContext, &outputResoulution, &props);
+	void createXessContext(vks::StartupRun& startup)
+	{
+		auto tStart = std::chrono::high_resolution_clock::now();
+		auto status = xessVKCreateContext(instance, physicalDevice, device, &xessContext);
+		startup.createContextMs = elapsedMs(tStart);
 		if (status != XESS_RESULT_SUCCESS)
 		{
-			throw std::runtime_error("Unable to get XeSS props");
+			throw std::runtime_error("Unable to create XeSS context");
+		}
+
+		if (!settings.headless && XESS_RESULT_WARNING_OLD_DRIVER == xessIsOptimalDriver(xessContext))
+		{
+			MessageBox(NULL, L"Please install the latest graphics driver from your vendor for optimal Intel(R) XeSS performance and visual quality", L"Important notice", MB_OK | MB_TOPMOST | MB_ICONINFORMATION);
 		}
 
 		xess_version_t xefx_version;
@@ -344,28 +623,24 @@ public:
 		{
 			throw std::runtime_error("Unable to get XeFX version");
 		}
-#if 0
-		D3D12_HEAP_DESC textures_heap_desc{ props.tempTextureHeapSize,
-			{D3D12_HEAP_TYPE_DEFAULT, D3D12_CPU_PAGE_PROPERTY_UNKNOWN, D3D12_MEMORY_POOL_UNKNOWN, 0, 0},
-			0, D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES };
+	}
 
-		m_device->CreateHeap(&textures_heap_desc, IID_PPV_ARGS(&m_texturesHeap));
-		m_texturesHeap->SetName(L"xess_textures_heap");
+	// Init flags passed to XeSS, including the debug flags
+	uint32_t getXessInitFlags() const
+	{
+		return xessInitFlags | (xessProfiling ? XESS_DEBUG_ENABLE_PROFILING : 0u);
+	}
 
-		m_uavDescriptorSize =
-			m_device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
-#endif
-		xess_vk_init_params_t params = {
+	// Initialization parameters for the current output resolution and settings
+	xess_vk_init_params_t getXessInitParams(VkPipelineCache cache) const
+	{
+		return {
 			/* Output width and height */
 			{width, height},
 			/* Quality setting */
 			xessQuality,
 			/* Initialization flags. */
-			#if defined(USE_LOWRES_MV)
-			XESS_INIT_FLAG_NONE,
-			#else
-			XESS_INIT_FLAG_HIGH_RES_MV,
-			#endif
+			getXessInitFlags(),
 			/* Specfies the node mask for internally created resources on
 			 * multi-adapter systems. */
 			0,
@@ -384,28 +659,101 @@ public:
 			nullptr,
 			/* Offset in the externally allocated heap for temporary textures storage. */
 			0,
-			/* No pipeline library */
-			NULL
+			/* Pipeline cache, must be the one passed to xessVKBuildPipelines */
+			cache
 		};
+	}
 
-		status = xessVKInit(xessContext, &params);
+	// Settings that must be applied before the pipelines are built
+	void configureXess()
+	{
+		auto status = xessForceLegacyScaleFactors(xessContext, xessLegacyScaleFactors);
 		if (status != XESS_RESULT_SUCCESS)
 		{
-			throw std::runtime_error("Unable to get XeSS props");
+			throw std::runtime_error("Unable to set XeSS scale factors");
 		}
 
-		// Get optimal input resolution
-		xess_2d_t outputResolution = { width, height };
-		status = xessGetInputResolution(xessContext, &outputResolution, xessQuality, &xessInputResolution);
+		if (xessNetworkModel != XESS_NETWORK_MODEL_UNKNOWN) {
+			status = xessSelectNetworkModel(xessContext, xessNetworkModel);
+			if (status != XESS_RESULT_SUCCESS)
+			{
+				throw std::runtime_error("Unable to select XeSS network model");
+			}
+		}
+	}
 
+	// Optimal input resolution for the current output resolution, quality and scale factors, valid before initialization
+	void updateXessInputResolution()
+	{
+		xess_2d_t outputResolution = { width, height };
+		auto status = xessGetInputResolution(xessContext, &outputResolution, xessQuality, &xessInputResolution);
 		if (status != XESS_RESULT_SUCCESS)
 		{
 			throw std::runtime_error("Unable to get XeSS props");
 		}
 		camera.setPerspective(60.0f, (float)xessInputResolution.x / (float)xessInputResolution.y, 1.0f, 256.0f);
+	}
+
+	// (Re)initialize XeSS for the current output resolution and settings and create its output image
+	// The caller must ensure that no XeSS execution is pending on the GPU
+	// At startup XeSS is already configured and its pipelines were built by the startup tasks, so that the phases are timed separately
+	void initXess(vks::StartupRun* startup = nullptr)
+	{
+		if (startup == nullptr) {
+			configureXess();
+		}
+
+		xess_properties_t props;
+		xess_2d_t outputResoulution = { width, height };
+		xess_result_t status = xessGetProperties(xessContext, &outputResoulution, &props);
+		if (status != XESS_RESULT_SUCCESS)
+		{
+			throw std::runtime_error("Unable to get XeSS props");
+		}
+#if 0
+		D3D12_HEAP_DESC textures_heap_desc{ props.tempTextureHeapSize,
+			{D3D12_HEAP_TYPE_DEFAULT, D3D12_CPU_PAGE_PROPERTY_UNKNOWN, D3D12_MEMORY_POOL_UNKNOWN, 0, 0},
+			0, D3D12_HEAP_FLAG_ALLOW_ONLY_NON_RT_DS_TEXTURES };
+
+		m_device->CreateHeap(&textures_heap_desc, IID_PPV_ARGS(&m_texturesHeap));
+		m_texturesHeap->SetName(L"xess_textures_heap");
+
+		m_uavDescriptorSize =
+			m_device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+#endif
+		xess_vk_init_params_t params = getXessInitParams(pipelineCacheFile.Get());
+
+		// Whether the overlapped startup hid the whole build, otherwise xessVKInit waits for the rest of it
+		if (startup != nullptr && startup->nonBlockingBuild) {
+			startup->pipelinesReadyAtInit = xessGetPipelineBuildStatus(xessContext) == XESS_RESULT_SUCCESS;
+		}
+
+		auto tStart = std::chrono::high_resolution_clock::now();
+		status = xessVKInit(xessContext, &params);
+		if (startup != nullptr) {
+			startup->initMs = elapsedMs(tStart);
+			if (startup->nonBlockingBuild) {
+				startup->cacheBytesAfter = getPipelineCacheSize(pipelineCacheFile.Get());
+			}
+		}
+		if (status != XESS_RESULT_SUCCESS)
+		{
+			throw std::runtime_error("Unable to get XeSS props");
+		}
+
+		// Query again after initialization, so that the reported sizes reflect the current flags
+		status = xessGetProperties(xessContext, &outputResoulution, &xessProperties);
+		if (status != XESS_RESULT_SUCCESS)
+		{
+			throw std::runtime_error("Unable to get XeSS props");
+		}
+
+		// Get optimal input resolution
+		updateXessInputResolution();
 
 		// Xess output
-		createAttachment(VK_FORMAT_R16G16B16A16_UNORM, VK_IMAGE_USAGE_STORAGE_BIT, &xessOutput, width, height);
+		// Transfer source for the read back of the network model sweep
+		createAttachment(VK_FORMAT_R16G16B16A16_UNORM, VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT, &xessOutput, width, height);
 	}
 
 	// Create a frame buffer attachment
@@ -504,6 +852,239 @@ public:
 		VK_CHECK_RESULT(vkAllocateCommandBuffers(device, &cmdBufAllocateInfo, commandBuffers.data()));
 	}
 
+	// Create the timestamp query pool for the pass timers, the pass timers are disabled if the queue does not support timestamps
+	void createGpuTimestamps()
+	{
+		const uint32_t validBits = vulkanDevice->queueFamilyProperties[swapChain.queueNodeIndex].timestampValidBits;
+		if (!vulkanDevice->properties.limits.timestampComputeAndGraphics || validBits == 0) {
+			std::cout << "GPU timestamps are not supported, pass timers are disabled\n";
+			gpuPassTimers = false;
+			return;
+		}
+		gpuTimestamps.period = vulkanDevice->properties.limits.timestampPeriod;
+		gpuTimestamps.validMask = validBits >= 64 ? ~0ull : ((1ull << validBits) - 1);
+		gpuTimestamps.slotFrame.fill(UINT64_MAX);
+
+		VkQueryPoolCreateInfo queryPoolCI{};
+		queryPoolCI.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+		queryPoolCI.queryType = VK_QUERY_TYPE_TIMESTAMP;
+		queryPoolCI.queryCount = GPU_TIMESTAMP_LATENCY * GPU_PASS_COUNT * 2;
+		VK_CHECK_RESULT(vkCreateQueryPool(device, &queryPoolCI, nullptr, &gpuTimestamps.pool));
+
+		if (deviceFeatures.pipelineStatisticsQuery) {
+			queryPoolCI.queryType = VK_QUERY_TYPE_PIPELINE_STATISTICS;
+			queryPoolCI.queryCount = GPU_TIMESTAMP_LATENCY * GPU_PASS_COUNT;
+			queryPoolCI.pipelineStatistics = VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT | VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT;
+			VK_CHECK_RESULT(vkCreateQueryPool(device, &queryPoolCI, nullptr, &gpuStatistics.pool));
+		} else {
+			std::cout << "Pipeline statistics are not supported, only pass times are measured\n";
+		}
+
+		gpuPassProfiler.Init(nullptr, nullptr);
+	}
+
+	// Read back the timestamps and statistics held by a slot without waiting for the GPU and add them to the pass results
+	void readGpuTimestamps(uint32_t slot)
+	{
+		const uint64_t frameNumber = gpuTimestamps.slotFrame[slot];
+		if (frameNumber == UINT64_MAX) {
+			return;
+		}
+		gpuTimestamps.slotFrame[slot] = UINT64_MAX;
+
+		// Value and availability of every query
+		uint64_t results[GPU_PASS_COUNT * 2][2] = {};
+		VkResult result = vkGetQueryPoolResults(device, gpuTimestamps.pool, slot * GPU_PASS_COUNT * 2, GPU_PASS_COUNT * 2, sizeof(results), results,
+			sizeof(results[0]), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+		bool available = result == VK_SUCCESS || result == VK_NOT_READY;
+		for (uint32_t query = 0; query < GPU_PASS_COUNT * 2; query++) {
+			available = available && results[query][1] != 0;
+		}
+
+		// Fragment and compute invocations, then availability, in the order of the statistic bits
+		uint64_t statistics[GPU_PASS_COUNT][3] = {};
+		if (gpuStatistics.pool != VK_NULL_HANDLE) {
+			result = vkGetQueryPoolResults(device, gpuStatistics.pool, slot * GPU_PASS_COUNT, GPU_PASS_COUNT, sizeof(statistics), statistics,
+				sizeof(statistics[0]), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+			available = available && (result == VK_SUCCESS || result == VK_NOT_READY);
+			for (uint32_t pass = 0; pass < GPU_PASS_COUNT; pass++) {
+				available = available && statistics[pass][2] != 0;
+			}
+		}
+
+		if (!available) {
+			gpuTimestamps.unavailableFrames++;
+			return;
+		}
+
+		if (gpuStatistics.pool != VK_NULL_HANDLE) {
+			for (uint32_t pass = 0; pass < GPU_PASS_COUNT; pass++) {
+				gpuStatistics.passes[pass].frames++;
+				gpuStatistics.passes[pass].fragmentInvocations += statistics[pass][0];
+				gpuStatistics.passes[pass].computeInvocations += statistics[pass][1];
+			}
+		}
+
+		const char* names[GPU_PASS_COUNT];
+		double durations[GPU_PASS_COUNT];
+		for (uint32_t pass = 0; pass < GPU_PASS_COUNT; pass++) {
+			const uint64_t ticks = (results[pass * 2 + 1][0] - results[pass * 2][0]) & gpuTimestamps.validMask;
+			names[pass] = gpuPasses[pass].name;
+			durations[pass] = (double)ticks * gpuTimestamps.period * 1e-9;
+		}
+		xess_profiled_frame_data_t frame{ frameNumber, GPU_PASS_COUNT, names, durations };
+		xess_profiling_data_t data{ 1, &frame, 0 };
+		gpuPassProfiler.Accumulate(data);
+	}
+
+	// Label a pass for debugging tools and write its start timestamp
+	void beginGpuPass(VkCommandBuffer cmdBuffer, GpuPass pass)
+	{
+		vks::debugutils::cmdBeginLabel(cmdBuffer, gpuPasses[pass].name, gpuPasses[pass].labelColor);
+		if (gpuPassTimers) {
+			const uint32_t slot = (uint32_t)(gpuTimestamps.frame % GPU_TIMESTAMP_LATENCY);
+			vkCmdWriteTimestamp(cmdBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, gpuTimestamps.pool, (slot * GPU_PASS_COUNT + pass) * 2);
+			if (gpuStatistics.pool != VK_NULL_HANDLE) {
+				vkCmdBeginQuery(cmdBuffer, gpuStatistics.pool, slot * GPU_PASS_COUNT + pass, 0);
+			}
+		}
+	}
+
+	void endGpuPass(VkCommandBuffer cmdBuffer, GpuPass pass)
+	{
+		if (gpuPassTimers) {
+			const uint32_t slot = (uint32_t)(gpuTimestamps.frame % GPU_TIMESTAMP_LATENCY);
+			if (gpuStatistics.pool != VK_NULL_HANDLE) {
+				vkCmdEndQuery(cmdBuffer, gpuStatistics.pool, slot * GPU_PASS_COUNT + pass);
+			}
+			vkCmdWriteTimestamp(cmdBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, gpuTimestamps.pool, (slot * GPU_PASS_COUNT + pass) * 2 + 1);
+		}
+		vks::debugutils::cmdEndLabel(cmdBuffer);
+	}
+
+	// Read back all slots still holding results, the caller must ensure that the GPU is idle
+	void flushGpuTimestamps()
+	{
+		for (uint32_t i = 1; i <= GPU_TIMESTAMP_LATENCY; i++) {
+			readGpuTimestamps((uint32_t)((gpuTimestamps.frame + i) % GPU_TIMESTAMP_LATENCY));
+		}
+	}
+
+	void resetGpuPassResults()
+	{
+		gpuPassProfiler.Reset();
+		gpuStatistics.passes.fill(GpuPassCounters{});
+		gpuTimestamps.unavailableFrames = 0;
+	}
+
+	// Size of a pixel in bytes for the formats used by this sample, 0 for other formats
+	static uint32_t formatSize(VkFormat format)
+	{
+		switch (format) {
+		case VK_FORMAT_R8_UNORM:
+			return 1;
+		case VK_FORMAT_D16_UNORM:
+			return 2;
+		case VK_FORMAT_D16_UNORM_S8_UINT:
+			return 3;
+		case VK_FORMAT_R8G8B8A8_UNORM:
+		case VK_FORMAT_R8G8B8A8_SRGB:
+		case VK_FORMAT_B8G8R8A8_UNORM:
+		case VK_FORMAT_B8G8R8A8_SRGB:
+		case VK_FORMAT_A2B10G10R10_UNORM_PACK32:
+		case VK_FORMAT_R16G16_SFLOAT:
+		case VK_FORMAT_D24_UNORM_S8_UINT:
+		case VK_FORMAT_X8_D24_UNORM_PACK32:
+		case VK_FORMAT_D32_SFLOAT:
+			return 4;
+		case VK_FORMAT_D32_SFLOAT_S8_UINT:
+			return 5;
+		case VK_FORMAT_R16G16B16A16_UNORM:
+		case VK_FORMAT_R16G16B16A16_SFLOAT:
+			return 8;
+		default:
+			return 0;
+		}
+	}
+
+	// Estimated bytes a pass reads and writes per frame, every pixel of the images it accesses is counted once
+	// Caches, compression and the depth test are ignored. For XeSS only its inputs and output are known, not its internal resources
+	void estimateGpuPassTraffic(GpuPass pass, uint64_t& bytesRead, uint64_t& bytesWritten)
+	{
+		const uint64_t inputPixels = (uint64_t)xessInputResolution.x * xessInputResolution.y;
+		const uint64_t velocityPixels = (uint64_t)velocityWidth * velocityHeight;
+		const uint64_t outputPixels = (uint64_t)width * height;
+		bytesRead = 0;
+		bytesWritten = 0;
+		switch (pass) {
+		case GPU_PASS_COLOR:
+			// Color and depth are cleared and stored
+			bytesWritten = inputPixels * (formatSize(offscreenFrameBuffers.render.color.format) + formatSize(offscreenFrameBuffers.render.depth.format));
+			break;
+		case GPU_PASS_VELOCITY:
+			bytesWritten = velocityPixels * formatSize(offscreenFrameBuffers.velocity.velocity.format);
+			break;
+		case GPU_PASS_XESS:
+			bytesRead = inputPixels * formatSize(offscreenFrameBuffers.render.color.format) + velocityPixels * formatSize(offscreenFrameBuffers.velocity.velocity.format);
+			if ((xessInitFlags & XESS_INIT_FLAG_HIGH_RES_MV) == 0) {
+				bytesRead += inputPixels * formatSize(offscreenFrameBuffers.render.depth.format);
+			}
+			if (xessInitFlags & XESS_INIT_FLAG_RESPONSIVE_PIXEL_MASK) {
+				bytesRead += inputPixels * formatSize(responsiveMask.format);
+			}
+			bytesWritten = outputPixels * formatSize(xessOutput.format);
+			break;
+		case GPU_PASS_FINAL:
+			bytesRead = outputPixels * formatSize(xessOutput.format);
+			bytesWritten = outputPixels * formatSize(swapChain.colorFormat);
+			break;
+		default:
+			break;
+		}
+	}
+
+	GpuPassResult getGpuPassResult(GpuPass pass)
+	{
+		GpuPassResult result;
+		for (uint32_t i = 0; i < gpuPassProfiler.GetPassCount(); i++) {
+			PerfTools::PassStatistics statistics = gpuPassProfiler.GetPassStatistics(i);
+			if (strcmp(statistics.name, gpuPasses[pass].name) == 0) {
+				result.time = statistics;
+			}
+		}
+		const GpuPassCounters& counters = gpuStatistics.passes[pass];
+		if (counters.frames != 0) {
+			result.fragmentInvocations = (double)counters.fragmentInvocations / (double)counters.frames;
+			result.computeInvocations = (double)counters.computeInvocations / (double)counters.frames;
+		}
+		estimateGpuPassTraffic(pass, result.bytesRead, result.bytesWritten);
+		return result;
+	}
+
+	// Table of the mean shader invocations and memory traffic of every pass, with throughputs over the mean GPU time of the pass
+	// A pass close to the memory bandwidth of the device is bandwidth limited, a pass with a high invocation rate but low bandwidth is ALU limited
+	std::string formatGpuPassReport()
+	{
+		std::stringstream report;
+		report << std::fixed << std::setprecision(2);
+		report << "Sample GPU pass counters per frame, " << width << "x" << height << " from " << xessInputResolution.x << "x" << xessInputResolution.y << "\n";
+		report << std::left << std::setw(10) << "pass" << std::right << std::setw(14) << "fragment_inv" << std::setw(14) << "compute_inv"
+			<< std::setw(10) << "read_MB" << std::setw(11) << "write_MB" << std::setw(8) << "GB/s" << std::setw(10) << "Ginv/s" << "\n";
+		for (uint32_t pass = 0; pass < GPU_PASS_COUNT; pass++) {
+			const GpuPassResult r = getGpuPassResult((GpuPass)pass);
+			const double seconds = r.time.meanMs * 1e-3;
+			const double bandwidth = seconds > 0.0 ? (double)(r.bytesRead + r.bytesWritten) / seconds * 1e-9 : 0.0;
+			const double invocationRate = seconds > 0.0 ? (r.fragmentInvocations + r.computeInvocations) / seconds * 1e-9 : 0.0;
+			report << std::left << std::setw(10) << gpuPasses[pass].name << std::right << std::setw(14) << std::setprecision(0) << r.fragmentInvocations
+				<< std::setw(14) << r.computeInvocations << std::setprecision(2) << std::setw(10) << (double)r.bytesRead * 1e-6
+				<< std::setw(11) << (double)r.bytesWritten * 1e-6 << std::setw(8) << bandwidth << std::setw(10) << invocationRate << "\n";
+		}
+		if (gpuStatistics.pool == VK_NULL_HANDLE) {
+			report << "Invocations are not available without pipeline statistics\n";
+		}
+		return report.str();
+	}
+
 	// Prepare vertex and index buffers for an indexed triangle
 	// Also uploads them to device local memory using staging and initializes vertex input and attribute binding to match the vertex shader
 	void createVertexBuffer()
@@ -742,26 +1323,54 @@ public:
 			allocInfo.pSetLayouts = &fsqDescriptorSetLayout;
 			VK_CHECK_RESULT(vkAllocateDescriptorSets(device, &allocInfo, &fsqDescriptorSet));
 
-			// Update the descriptor set determining the shader binding points
-			// For every binding point used in a shader there needs to be one
-			// descriptor set matching that binding point
-			VkWriteDescriptorSet writeDescriptorSet{};
+			updateFsqDescriptorSet();
+		}
+	}
 
-			// The image + sampler  information is passed using a descriptor info structure
-			VkDescriptorImageInfo imageInfo{};
-			imageInfo.sampler = fsqSampler;
-			imageInfo.imageView = xessOutput.view;
-			imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	// Point the full screen quad descriptor set to the current XeSS output image
+	void updateFsqDescriptorSet()
+	{
+		// Update the descriptor set determining the shader binding points
+		// For every binding point used in a shader there needs to be one
+		// descriptor set matching that binding point
+		VkWriteDescriptorSet writeDescriptorSet{};
+
+		// The image + sampler  information is passed using a descriptor info structure
+		VkDescriptorImageInfo imageInfo{};
+		imageInfo.sampler = fsqSampler;
+		imageInfo.imageView = xessOutput.view;
+		imageInfo.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+		// Binding 0 : Uniform buffer
+		writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		writeDescriptorSet.dstSet = fsqDescriptorSet;
+		writeDescriptorSet.descriptorCount = 1;
+		writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		writeDescriptorSet.pImageInfo = &imageInfo;
+		writeDescriptorSet.dstBinding = 0;
+		vkUpdateDescriptorSets(device, 1, &writeDescriptorSet, 0, nullptr);
+	}
 
-			// Binding 0 : Uniform buffer
-			writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-			writeDescriptorSet.dstSet = fsqDescriptorSet;
-			writeDescriptorSet.descriptorCount = 1;
-			writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-			writeDescriptorSet.pImageInfo = &imageInfo;
-			writeDescriptorSet.dstBinding = 0;
-			vkUpdateDescriptorSets(device, 1, &writeDescriptorSet, 0, nullptr);
-		}
+	// Recreate everything sized by the output resolution or by the XeSS input resolution derived from it
+	// Note: Override of virtual function in the base class and called from within VulkanExampleBase::windowResize after the device is idle
+	void windowResized() override
+	{
+		xessOutput.destroy(device);
+		offscreenFrameBuffers.render.destroy(device);
+		offscreenFrameBuffers.render.color.destroy(device);
+		offscreenFrameBuffers.render.depth.destroy(device);
+		offscreenFrameBuffers.velocity.destroy(device);
+		offscreenFrameBuffers.velocity.velocity.destroy(device);
+		responsiveMask.destroy(device);
+		responsiveMask = FrameBufferAttachment();
+		vkDestroyBuffer(device, vertices.buffer, nullptr);
+		vkFreeMemory(device, vertices.memory, nullptr);
+
+		initXess();
+		prepareOffscreenFramebuffers();
+		// The triangle is scaled by the aspect ratio of the input resolution
+		createVertexBuffer();
+		updateFsqDescriptorSet();
 	}
 
 	// Create a frame buffer for each swap chain image
@@ -810,7 +1419,7 @@ public:
 		attachments[0].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;                 // We don't use stencil, so don't care for load
 		attachments[0].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;               // Same for store
 		attachments[0].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;                       // Layout at render pass start. Initial doesn't matter, so we use undefined
-		attachments[0].finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;                   // Layout to which the attachment is transitioned when the render pass is finished
+		attachments[0].finalLayout = settings.headless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR; // Layout to which the attachment is transitioned when the render pass is finished (not presented in headless mode)
 
 		// Setup attachment references
 		VkAttachmentReference colorReference{};
@@ -914,14 +1523,14 @@ public:
 
 	void prepareOffscreenFramebuffers()
 	{
-		
-#if defined(USE_LOWRES_MV)
-		velocityWidth = xessInputResolution.x;
-		velocityHeight = xessInputResolution.y;
-#else
-		velocityWidth = width;
-		velocityHeight = height;
-#endif
+		const bool lowResMotionVectors = (xessInitFlags & XESS_INIT_FLAG_HIGH_RES_MV) == 0;
+		if (lowResMotionVectors) {
+			velocityWidth = xessInputResolution.x;
+			velocityHeight = xessInputResolution.y;
+		} else {
+			velocityWidth = width;
+			velocityHeight = height;
+		}
 
 		offscreenFrameBuffers.render.setSize(xessInputResolution.x, xessInputResolution.y);
 
@@ -940,6 +1549,18 @@ public:
 		// Velocity
 		createAttachment(VK_FORMAT_R16G16_SFLOAT, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, &offscreenFrameBuffers.velocity.velocity, velocityWidth, velocityHeight);
 
+		// Responsive pixel mask, cleared once as the sample has no content that needs it
+		if (xessInitFlags & XESS_INIT_FLAG_RESPONSIVE_PIXEL_MASK) {
+			createAttachment(VK_FORMAT_R8_UNORM, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT, &responsiveMask, xessInputResolution.x, xessInputResolution.y);
+			VkCommandBuffer cmdBuffer = vulkanDevice->createCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
+			VkImageSubresourceRange colorRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+			vks::tools::setImageLayout(cmdBuffer, responsiveMask.image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, colorRange);
+			VkClearColorValue clearColor = { { 0.0f, 0.0f, 0.0f, 0.0f } };
+			vkCmdClearColorImage(cmdBuffer, responsiveMask.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &clearColor, 1, &colorRange);
+			vks::tools::setImageLayout(cmdBuffer, responsiveMask.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, colorRange);
+			vulkanDevice->flushCommandBuffer(cmdBuffer, queue);
+		}
+
 		// Render passes
 		{
 			std::array<VkAttachmentDescription, 2> attachmentDescs = {};
@@ -952,11 +1573,7 @@ public:
 				attachmentDescs[i].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
 				attachmentDescs[i].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
 				attachmentDescs[i].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-#if defined(USE_LOWRES_MV)
-				attachmentDescs[i].finalLayout = (i == 1) ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-#else
-				attachmentDescs[i].finalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-#endif
+				attachmentDescs[i].finalLayout = (lowResMotionVectors && i == 1) ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
 			}
 
 			// Formats
@@ -979,13 +1596,13 @@ public:
 			// Use subpass dependencies for attachment layout transitions
 			std::array<VkSubpassDependency, 2> dependencies;
 
-#if defined(USE_LOWRES_MV)
-			VkPipelineStageFlags attachmentWriteStages = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
-			VkAccessFlags attachmentAccess = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-#else
+			// Depth is only read by XeSS with low resolution motion vectors
 			VkPipelineStageFlags attachmentWriteStages = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
 			VkAccessFlags attachmentAccess = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-#endif
+			if (lowResMotionVectors) {
+				attachmentWriteStages |= VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+				attachmentAccess |= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+			}
 
 			dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
 			dependencies[0].dstSubpass = 0;
@@ -1085,6 +1702,17 @@ public:
 		}
 	}
 
+	// Load the shaders of all pipelines, independent of the render passes so that it can run before they exist
+	void createShaderModules()
+	{
+		triangleShaders.vertex = loadSPIRVShader(getShadersPath() + "triangle/triangle.vert.spv");
+		triangleShaders.fragment = loadSPIRVShader(getShadersPath() + "triangle/triangle.frag.spv");
+		velocityShaders.vertex = loadSPIRVShader(getShadersPath() + "triangle/velocity.vert.spv");
+		velocityShaders.fragment = loadSPIRVShader(getShadersPath() + "triangle/velocity.frag.spv");
+		quadShaders.vertex = loadSPIRVShader(getShadersPath() + "triangle/quad.vert.spv");
+		quadShaders.fragment = loadSPIRVShader(getShadersPath() + "triangle/quad.frag.spv");
+	}
+
 	void createPipelines()
 	{
 		// Create the graphics pipeline used in this example
@@ -1211,8 +1839,8 @@ public:
 		shaderStages[0].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
 		// Set pipeline stage for this shader
 		shaderStages[0].stage = VK_SHADER_STAGE_VERTEX_BIT;
-		// Load binary SPIR-V shader
-		shaderStages[0].module = loadSPIRVShader(getShadersPath() + "triangle/triangle.vert.spv");
+		// Binary SPIR-V shader loaded by createShaderModules
+		shaderStages[0].module = triangleShaders.vertex;
 		// Main entry point for the shader
 		shaderStages[0].pName = "main";
 		assert(shaderStages[0].module != VK_NULL_HANDLE);
@@ -1221,8 +1849,8 @@ public:
 		shaderStages[1].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
 		// Set pipeline stage for this shader
 		shaderStages[1].stage = VK_SHADER_STAGE_FRAGMENT_BIT;
-		// Load binary SPIR-V shader
-		shaderStages[1].module = loadSPIRVShader(getShadersPath() + "triangle/triangle.frag.spv");
+		// Binary SPIR-V shader loaded by createShaderModules
+		shaderStages[1].module = triangleShaders.fragment;
 		// Main entry point for the shader
 		shaderStages[1].pName = "main";
 		assert(shaderStages[1].module != VK_NULL_HANDLE);
@@ -1242,36 +1870,36 @@ public:
 		pipelineCI.pDynamicState = &dynamicStateCI;
 
 		// Create rendering pipeline using the specified states
-		VK_CHECK_RESULT(vkCreateGraphicsPipelines(device, pipelineCache, 1, &pipelineCI, nullptr, &pipeline));
+		VK_CHECK_RESULT(vkCreateGraphicsPipelines(device, pipelineCacheFile.Get(), 1, &pipelineCI, nullptr, &pipeline));
 
 		// Shader modules are no longer needed once the graphics pipeline has been created
 		vkDestroyShaderModule(device, shaderStages[0].module, nullptr);
 		vkDestroyShaderModule(device, shaderStages[1].module, nullptr);
 
 		// Vertex shader
-		shaderStages[0].module = loadSPIRVShader(getShadersPath() + "triangle/velocity.vert.spv");
+		shaderStages[0].module = velocityShaders.vertex;
 		// Fragment shader
-		shaderStages[1].module = loadSPIRVShader(getShadersPath() + "triangle/velocity.frag.spv");
+		shaderStages[1].module = velocityShaders.fragment;
 
 		pipelineCI.renderPass = offscreenFrameBuffers.velocity.renderPass;
 
 		// Create rendering pipeline using the specified states
-		VK_CHECK_RESULT(vkCreateGraphicsPipelines(device, pipelineCache, 1, &pipelineCI, nullptr, &velocityPipeline));
+		VK_CHECK_RESULT(vkCreateGraphicsPipelines(device, pipelineCacheFile.Get(), 1, &pipelineCI, nullptr, &velocityPipeline));
 
 		// Shader modules are no longer needed once the graphics pipeline has been created
 		vkDestroyShaderModule(device, shaderStages[0].module, nullptr);
 		vkDestroyShaderModule(device, shaderStages[1].module, nullptr);
 
 		// Vertex shader
-		shaderStages[0].module = loadSPIRVShader(getShadersPath() + "triangle/quad.vert.spv");
+		shaderStages[0].module = quadShaders.vertex;
 		// Fragment shader
-		shaderStages[1].module = loadSPIRVShader(getShadersPath() + "triangle/quad.frag.spv");
+		shaderStages[1].module = quadShaders.fragment;
 
 		pipelineCI.renderPass = renderPass;
 		pipelineCI.layout = fsqPipelineLayout;
 
 		// Create rendering pipeline using the specified states
-		VK_CHECK_RESULT(vkCreateGraphicsPipelines(device, pipelineCache, 1, &pipelineCI, nullptr, &fsqPipeline));
+		VK_CHECK_RESULT(vkCreateGraphicsPipelines(device, pipelineCacheFile.Get(), 1, &pipelineCI, nullptr, &fsqPipeline));
 
 		// Shader modules are no longer needed once the graphics pipeline has been created
 		vkDestroyShaderModule(device, shaderStages[0].module, nullptr);
@@ -1337,24 +1965,83 @@ public:
 		VK_CHECK_RESULT(vkCreateSampler(device, &samplerCI, nullptr, &fsqSampler));
 	}
 
-	void prepare()
+	// Startup task graph, the XeSS pipeline build is started as early as possible and xessVKInit runs once everything else is ready
+	// The sample has no textures to load, its assets are the vertex buffer, the shader modules and the attachments
+	// Tasks that use the queue or the command pool of the device depend on each other, as both must be externally synchronized
+	void addStartupTasks(bool overlapped)
 	{
-		setupXess();
-		VulkanExampleBase::prepare();
-		prepareOffscreenFramebuffers();
-		createSynchronizationPrimitives();
-		createCommandBuffers();
-		createVertexBuffer();
-		createUniformBuffers();
-		createSampler();
-		createDescriptorSetLayout();
-		createDescriptorPool();
-		createDescriptorSets();
+		TaskGraph& tasks = startupTasks;
+		auto cacheTask = tasks.Add("load pipeline cache", [this] { loadPipelineCache(); });
+		auto contextTask = tasks.Add("create XeSS context", [this] { createXessContext(xessStartup); }, {}, true);
+		auto buildTask = tasks.Add("build XeSS pipelines", [this, overlapped] {
+			configureXess();
+			buildXessPipelines(xessContext, pipelineCacheFile.Get(), xessStartup, !overlapped);
+		}, { cacheTask, contextTask });
+		// Window, swap chain and the framebuffers of the base class, may resize the output
+		auto swapChainTask = tasks.Add("swap chain", [this] { VulkanExampleBase::prepare(); }, {}, true);
+		// The queue family is selected with the surface of the swap chain
+		auto commandsTask = tasks.Add("command buffers", [this] {
+			createSynchronizationPrimitives();
+			createCommandBuffers();
+			if (gpuPassTimers) {
+				createGpuTimestamps();
+			}
+		}, { swapChainTask });
+		// The input resolution depends on the scale factors set before the build
+		auto attachmentsTask = tasks.Add("offscreen framebuffers", [this] {
+			updateXessInputResolution();
+			prepareOffscreenFramebuffers();
+		}, { buildTask, swapChainTask });
+		// Sized by the input resolution, submits after the clear of the attachments
+		auto verticesTask = tasks.Add("vertex upload", [this] { createVertexBuffer(); }, { commandsTask, attachmentsTask });
+		auto uniformsTask = tasks.Add("uniform buffers", [this] { createUniformBuffers(); });
+		auto samplerTask = tasks.Add("sampler", [this] { createSampler(); });
+		auto layoutsTask = tasks.Add("descriptor set layouts", [this] { createDescriptorSetLayout(); });
+		auto poolTask = tasks.Add("descriptor pool", [this] { createDescriptorPool(); });
+		auto shadersTask = tasks.Add("shader modules", [this] { createShaderModules(); });
+		auto pipelinesTask = tasks.Add("pipelines", [this] { createPipelines(); }, { cacheTask, swapChainTask, attachmentsTask, layoutsTask, shadersTask });
+		auto initTask = tasks.Add("init XeSS", [this] { initXess(&xessStartup); },
+			{ buildTask, commandsTask, verticesTask, uniformsTask, samplerTask, poolTask, pipelinesTask }, true);
+		// The full screen quad samples the XeSS output, which exists after the initialization
+		tasks.Add("descriptor sets", [this] { createDescriptorSets(); }, { initTask }, true);
+	}
 
-		createPipelines();
+	void prepare()
+	{
+		startupStart = std::chrono::high_resolution_clock::now();
+		if (commandLineParser.isSet("xessflags")) {
+			xessInitFlags = parseInitFlags(commandLineParser.getValueAsString("xessflags", ""));
+		}
+		// The quality sweep reports the passes next to the frame times
+		gpuPassTimers = commandLineParser.isSet("passtimers") || commandLineParser.isSet("sweep");
+
+		// The serial startup runs the same tasks in order on this thread with a blocking pipeline build, as reference for the overlapped one
+		const bool overlapped = !commandLineParser.isSet("serialstartup");
+		addStartupTasks(overlapped);
+		const uint32_t workerCount = overlapped ? std::min(std::max(std::thread::hardware_concurrency(), 2u) - 1, 4u) : 0;
+		startupTasks.Run(workerCount);
+
+		// Startup phases of the sample itself, reported with the benchmark results
+		benchmark.startupRuns.push_back(xessStartup);
+		benchmark.overlappedStartup = overlapped;
 		prepared = true;
 	}
 
+	// Time from the start of prepare until the first frame is presented, or submitted in headless mode
+	void recordFirstFrame()
+	{
+		if (benchmark.timeToFirstFrameMs > 0.0) {
+			return;
+		}
+		benchmark.timeToFirstFrameMs = elapsedMs(startupStart);
+		std::cout << "Time to first frame: " << benchmark.timeToFirstFrameMs << " ms";
+		if (benchmark.overlappedStartup) {
+			std::cout << " (overlapped startup, XeSS pipelines " << (xessStartup.pipelinesReadyAtInit ? "built" : "still building") << " at init)\n";
+		} else {
+			std::cout << " (serial startup)\n";
+		}
+	}
+
 	virtual void render()
 	{
 		if (!prepared)
@@ -1365,8 +2052,14 @@ public:
 
 		// Get the next swap chain image from the implementation
 		// Note that the implementation is free to return the images in any order, so we must use the acquire function and can't just cycle through the images
+		// In headless mode there is no swap chain and the offscreen targets are simply cycled through
 		uint32_t imageIndex;
-		VkResult result = vkAcquireNextImageKHR(device, swapChain.swapChain, UINT64_MAX, presentCompleteSemaphores[currentFrame], VK_NULL_HANDLE, &imageIndex);
+		VkResult result = VK_SUCCESS;
+		if (settings.headless) {
+			imageIndex = acquireHeadlessTarget();
+		} else {
+			result = vkAcquireNextImageKHR(device, swapChain.swapChain, UINT64_MAX, presentCompleteSemaphores[currentFrame], VK_NULL_HANDLE, &imageIndex);
+		}
 		if (result == VK_ERROR_OUT_OF_DATE_KHR) {
 			windowResize();
 			return;
@@ -1383,9 +2076,10 @@ public:
 		auto current_time = std::chrono::high_resolution_clock::now();
 		std::chrono::duration<double> elapsed_seconds = current_time - last_shader_data_time;
 		last_shader_data_time = current_time;
+		const double frameTime = fixedFrameTime > 0.0 ? fixedFrameTime : elapsed_seconds.count();
 
 		const double speed = 1. / 2; //4 second for screen
-		float translationSpeed = m_pause ? 0.f : (float)(speed * elapsed_seconds.count());
+		float translationSpeed = m_pause ? 0.f : (float)(speed * frameTime);
 		const float offsetBounds = 1.25f;
 
 		m_uniformBufferData.offset.x += translationSpeed;
@@ -1397,6 +2091,8 @@ public:
 		auto haltonValue = m_haltonPointSet[m_haltonIndex];
 		m_haltonIndex = (m_haltonIndex + 1) % m_haltonPointSet.size();
 
+		previousJitter[0] = jitter[0];
+		previousJitter[1] = jitter[1];
 		jitter[0] = haltonValue.first;
 		jitter[1] = haltonValue.second;
 
@@ -1407,6 +2103,12 @@ public:
 		m_uniformBufferData.resolution.y = (float)xessInputResolution.y;
 
 		m_uniformBufferData.velocity.x = -translationSpeed * ((float)width / 2.f);
+		m_uniformBufferData.velocity.y = 0.f;
+		// With XESS_INIT_FLAG_JITTERED_MV the motion vectors also carry the change of jitter, in pixels of the velocity texture
+		if (xessInitFlags & XESS_INIT_FLAG_JITTERED_MV) {
+			m_uniformBufferData.velocity.x += (previousJitter[0] - jitter[0]) * ((float)velocityWidth / (float)xessInputResolution.x);
+			m_uniformBufferData.velocity.y += (previousJitter[1] - jitter[1]) * ((float)velocityHeight / (float)xessInputResolution.y);
+		}
 
 
 		// Copy the current matrices to the current frame's uniform buffer
@@ -1444,8 +2146,20 @@ public:
 		renderPassBeginInfo.framebuffer = offscreenFrameBuffers.render.frameBuffer;
 		VK_CHECK_RESULT(vkBeginCommandBuffer(commandBuffers[currentBuffer], &cmdBufInfo));
 
+		// The timestamp slot of this frame was written GPU_TIMESTAMP_LATENCY frames ago, collect its results before reusing it
+		if (gpuPassTimers) {
+			const uint32_t slot = (uint32_t)(gpuTimestamps.frame % GPU_TIMESTAMP_LATENCY);
+			readGpuTimestamps(slot);
+			vkCmdResetQueryPool(commandBuffers[currentBuffer], gpuTimestamps.pool, slot * GPU_PASS_COUNT * 2, GPU_PASS_COUNT * 2);
+			if (gpuStatistics.pool != VK_NULL_HANDLE) {
+				vkCmdResetQueryPool(commandBuffers[currentBuffer], gpuStatistics.pool, slot * GPU_PASS_COUNT, GPU_PASS_COUNT);
+			}
+			gpuTimestamps.slotFrame[slot] = gpuTimestamps.frame;
+		}
+
 		// Start the first sub pass specified in our default render pass setup by the base class
 		// This will clear the color and depth attachment
+		beginGpuPass(commandBuffers[currentBuffer], GPU_PASS_COLOR);
 		vkCmdBeginRenderPass(commandBuffers[currentBuffer], &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
 		// Update dynamic viewport state
 		VkViewport viewport{};
@@ -1472,9 +2186,11 @@ public:
 		// Draw triangle
 		vkCmdDraw(commandBuffers[currentBuffer], vertices.count, 1, 0, 0);
 		vkCmdEndRenderPass(commandBuffers[currentBuffer]);
+		endGpuPass(commandBuffers[currentBuffer], GPU_PASS_COLOR);
 
 
 		// Velocity pass
+		beginGpuPass(commandBuffers[currentBuffer], GPU_PASS_VELOCITY);
 		// Update dynamic viewport state
 		viewport.height = (float)velocityHeight;
 		viewport.width = (float)velocityWidth;
@@ -1504,6 +2220,7 @@ public:
 		// Draw triangle
 		vkCmdDraw(commandBuffers[currentBuffer], vertices.count, 1, 0, 0);
 		vkCmdEndRenderPass(commandBuffers[currentBuffer]);
+		endGpuPass(commandBuffers[currentBuffer], GPU_PASS_VELOCITY);
 
 		{
 			VkImageMemoryBarrier imageMemoryBarrier{};
@@ -1525,23 +2242,30 @@ public:
 			exec_params.jitterOffsetX = jitter[0];
 			exec_params.jitterOffsetY = -jitter[1];
 			exec_params.exposureScale = 1.0f;
+			exec_params.resetHistory = xessResetHistory ? 1u : 0u;
+			xessResetHistory = false;
 
 			exec_params.colorTexture = { offscreenFrameBuffers.render.color.view, offscreenFrameBuffers.render.color.image, { VK_IMAGE_ASPECT_COLOR_BIT, 0u, 1u, 0u, 1u}, offscreenFrameBuffers.render.color.format, xessInputResolution.x, xessInputResolution.y };
-			exec_params.velocityTexture = { offscreenFrameBuffers.velocity.velocity.view, offscreenFrameBuffers.velocity.velocity.image, { VK_IMAGE_ASPECT_COLOR_BIT, 0u, 1u, 0u, 1u}, offscreenFrameBuffers.velocity.velocity.format, width, height };
+			exec_params.velocityTexture = { offscreenFrameBuffers.velocity.velocity.view, offscreenFrameBuffers.velocity.velocity.image, { VK_IMAGE_ASPECT_COLOR_BIT, 0u, 1u, 0u, 1u}, offscreenFrameBuffers.velocity.velocity.format, velocityWidth, velocityHeight };
 			exec_params.outputTexture = { xessOutput.view, xessOutput.image, { VK_IMAGE_ASPECT_COLOR_BIT, 0u, 1u, 0u, 1u}, xessOutput.format, width, height };
-#if defined(USE_LOWRES_MV)
-			exec_params.depthTexture = { offscreenFrameBuffers.render.depth.view, offscreenFrameBuffers.render.depth.image, { VK_IMAGE_ASPECT_DEPTH_BIT, 0u, 1u, 0u, 1u}, offscreenFrameBuffers.render.depth.format, xessInputResolution.x, xessInputResolution.y };
-#else
-			exec_params.depthTexture.image = nullptr;
-			exec_params.depthTexture.imageView = nullptr;
-#endif
+			if ((xessInitFlags & XESS_INIT_FLAG_HIGH_RES_MV) == 0) {
+				exec_params.depthTexture = { offscreenFrameBuffers.render.depth.view, offscreenFrameBuffers.render.depth.image, { VK_IMAGE_ASPECT_DEPTH_BIT, 0u, 1u, 0u, 1u}, offscreenFrameBuffers.render.depth.format, xessInputResolution.x, xessInputResolution.y };
+			} else {
+				exec_params.depthTexture.image = nullptr;
+				exec_params.depthTexture.imageView = nullptr;
+			}
+			if (xessInitFlags & XESS_INIT_FLAG_RESPONSIVE_PIXEL_MASK) {
+				exec_params.responsivePixelMaskTexture = { responsiveMask.view, responsiveMask.image, { VK_IMAGE_ASPECT_COLOR_BIT, 0u, 1u, 0u, 1u}, responsiveMask.format, xessInputResolution.x, xessInputResolution.y };
+			}
 			exec_params.exposureScaleTexture.image = nullptr;
 			exec_params.exposureScaleTexture.imageView = nullptr;
+			beginGpuPass(commandBuffers[currentBuffer], GPU_PASS_XESS);
 			auto status = xessVKExecute(xessContext, commandBuffers[currentBuffer], &exec_params);
 			if (status != XESS_RESULT_SUCCESS)
 			{
 				throw std::runtime_error("Unable to run XeSS");
 			}
+			endGpuPass(commandBuffers[currentBuffer], GPU_PASS_XESS);
 		}
 
 		{
@@ -1557,6 +2281,7 @@ public:
 		}
 
 		// Final pass
+		beginGpuPass(commandBuffers[currentBuffer], GPU_PASS_FINAL);
 		// Update dynamic viewport state
 		viewport.height = (float)height;
 		viewport.width = (float)width;
@@ -1587,6 +2312,8 @@ public:
 		// Draw triangle
 		vkCmdDraw(commandBuffers[currentBuffer], 3, 1, 0, 0);
 		vkCmdEndRenderPass(commandBuffers[currentBuffer]);
+		endGpuPass(commandBuffers[currentBuffer], GPU_PASS_FINAL);
+		gpuTimestamps.frame++;
 
 
 		// Ending the render pass will add an implicit barrier transitioning the frame buffer color attachment to
@@ -1611,9 +2338,24 @@ public:
 		// Semaphore to be signaled when command buffers have completed
 		submitInfo_.pSignalSemaphores = &renderCompleteSemaphores[currentFrame];
 
+		// Without a swap chain nothing signals or waits for the semaphores, frames are paced by the wait fence only
+		if (settings.headless) {
+			submitInfo_.waitSemaphoreCount = 0;
+			submitInfo_.signalSemaphoreCount = 0;
+		}
+
 		// Submit to the graphics queue passing a wait fence
 		VK_CHECK_RESULT(vkQueueSubmit(queue, 1, &submitInfo_, waitFences[currentFrame]));
 
+		if (xessProfiling) {
+			xessProfiler.Update();
+		}
+
+		if (settings.headless) {
+			recordFirstFrame();
+			return;
+		}
+
 		// Present the current frame buffer to the swap chain
 		// Pass the semaphore signaled by the command buffer submission from the submit info as the wait semaphore for swap chain presentation
 		// This ensures that the image is not presented to the windowing system until all commands have been submitted
@@ -1626,6 +2368,7 @@ public:
 		presentInfo.pSwapchains = &swapChain.swapChain;
 		presentInfo.pImageIndices = &imageIndex;
 		result = vkQueuePresentKHR(queue, &presentInfo);
+		recordFirstFrame();
 
 		if ((result == VK_ERROR_OUT_OF_DATE_KHR) || (result == VK_SUBOPTIMAL_KHR)) {
 			windowResize();
@@ -1635,6 +2378,565 @@ public:
 		}
 
 	}
+
+	// Results of one benchmark sweep combination, times in milliseconds
+	struct SweepResult {
+		uint64_t frames = 0;
+		double frameTimeMean = 0.0;
+		double frameTimeP50 = 0.0;
+		double frameTimeP99 = 0.0;
+		PerfTools::PassStatistics xessTime{};
+		std::array<GpuPassResult, GPU_PASS_COUNT> passes{};
+	};
+
+	// Warm up, then benchmark the current XeSS configuration
+	// Warm-up frames are neither timed nor profiled
+	SweepResult measureSweepCombination()
+	{
+		auto tWarmupStart = std::chrono::high_resolution_clock::now();
+		while (std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - tWarmupStart).count() < benchmark.warmup) {
+			render();
+		}
+		vkDeviceWaitIdle(device);
+		xessProfiler.Flush();
+		xessProfiler.Reset();
+		if (gpuPassTimers) {
+			flushGpuTimestamps();
+			resetGpuPassResults();
+		}
+
+		vks::Benchmark measurement;
+		measurement.warmup = 0;
+		measurement.duration = benchmark.duration;
+		measurement.outputFrames = benchmark.outputFrames;
+		measurement.run([=] { render(); }, vulkanDevice->properties);
+		vkDeviceWaitIdle(device);
+		xessProfiler.Flush();
+		if (gpuPassTimers) {
+			flushGpuTimestamps();
+		}
+
+		SweepResult result;
+		result.frames = measurement.statistics.getCount();
+		result.frameTimeMean = measurement.statistics.getMean();
+		result.frameTimeP50 = measurement.statistics.getPercentile(50.0);
+		result.frameTimeP99 = measurement.statistics.getPercentile(99.0);
+		for (uint32_t pass = 0; pass < xessProfiler.GetPassCount(); pass++) {
+			PerfTools::PassStatistics statistics = xessProfiler.GetPassStatistics(pass);
+			if (strcmp(statistics.name, PerfTools::ProfilingAggregator::ExecutionTotalName) == 0) {
+				result.xessTime = statistics;
+			}
+		}
+		if (gpuPassTimers) {
+			for (uint32_t pass = 0; pass < GPU_PASS_COUNT; pass++) {
+				result.passes[pass] = getGpuPassResult((GpuPass)pass);
+			}
+		}
+		return result;
+	}
+
+	// Benchmark every quality setting at every sweep resolution, optionally with and without legacy scale factors
+	// XeSS is re-initialized for every combination, one CSV row is written per combination
+	void runSweep()
+	{
+		const std::vector<std::pair<xess_quality_settings_t, const char*>> qualities = {
+			{ XESS_QUALITY_SETTING_ULTRA_PERFORMANCE, "ultra_performance" },
+			{ XESS_QUALITY_SETTING_PERFORMANCE, "performance" },
+			{ XESS_QUALITY_SETTING_BALANCED, "balanced" },
+			{ XESS_QUALITY_SETTING_QUALITY, "quality" },
+			{ XESS_QUALITY_SETTING_ULTRA_QUALITY, "ultra_quality" },
+			{ XESS_QUALITY_SETTING_ULTRA_QUALITY_PLUS, "ultra_quality_plus" },
+			{ XESS_QUALITY_SETTING_AA, "aa" },
+		};
+
+		std::vector<std::pair<uint32_t, uint32_t>> resolutions = Utils::ParseResolutions(commandLineParser.getValueAsString("sweepresolutions", ""));
+		if (resolutions.empty()) {
+			resolutions.emplace_back(width, height);
+		}
+		std::vector<bool> legacyScaleFactors = { false };
+		if (commandLineParser.isSet("sweeplegacy")) {
+			legacyScaleFactors.push_back(true);
+		}
+
+		std::string filename = commandLineParser.getValueAsString("sweepfile", "sweep.csv");
+		std::ofstream result(filename, std::ios::out);
+		if (!result.is_open()) {
+			throw std::runtime_error("Unable to open sweep results file " + filename);
+		}
+		result << std::fixed << std::setprecision(4);
+		result << "quality,legacy_scale_factors,output_width,output_height,input_width,input_height,frames,"
+			<< "frame_time_mean_ms,frame_time_p50_ms,frame_time_p99_ms,xess_mean_ms,xess_p50_ms,xess_p99_ms";
+		if (gpuPassTimers) {
+			for (const GpuPassInfo& pass : gpuPasses) {
+				result << "," << pass.name << "_mean_ms," << pass.name << "_fragment_invocations," << pass.name << "_compute_invocations,"
+					<< pass.name << "_bytes_read," << pass.name << "_bytes_written";
+			}
+		}
+		result << "\n";
+
+		// Profiling is enabled by the re-initialization of the first combination
+		xessProfiling = true;
+		xessProfiler.Init(xessContext, xessGetProfilingData);
+
+		for (bool legacy : legacyScaleFactors) {
+			for (const auto& resolution : resolutions) {
+				for (const auto& quality : qualities) {
+					xessQuality = quality.first;
+					xessLegacyScaleFactors = legacy;
+					resizeRenderTargets(resolution.first, resolution.second);
+
+					std::cout << "Sweep: " << quality.second << (legacy ? " (legacy scale factors)" : "") << " at "
+						<< width << "x" << height << " from " << xessInputResolution.x << "x" << xessInputResolution.y << "\n";
+					SweepResult r = measureSweepCombination();
+
+					result << quality.second << "," << (legacy ? 1 : 0) << "," << width << "," << height << ","
+						<< xessInputResolution.x << "," << xessInputResolution.y << "," << r.frames << ","
+						<< r.frameTimeMean << "," << r.frameTimeP50 << "," << r.frameTimeP99 << ","
+						<< r.xessTime.meanMs << "," << r.xessTime.p50Ms << "," << r.xessTime.p99Ms;
+					if (gpuPassTimers) {
+						for (const GpuPassResult& pass : r.passes) {
+							result << "," << pass.time.meanMs << "," << std::setprecision(0) << pass.fragmentInvocations << "," << pass.computeInvocations
+								<< "," << pass.bytesRead << "," << pass.bytesWritten << std::setprecision(4);
+						}
+					}
+					result << "\n";
+					result.flush();
+				}
+			}
+		}
+	}
+
+	// Benchmark every combination of the switchable init flags at every sweep resolution
+	// XeSS is re-initialized for every combination, one CSV row with GPU time and XeSS storage requirements is written per combination
+	void runFlagSweep()
+	{
+		std::vector<std::pair<uint32_t, uint32_t>> resolutions = Utils::ParseResolutions(commandLineParser.getValueAsString("sweepresolutions", ""));
+		if (resolutions.empty()) {
+			resolutions.emplace_back(width, height);
+		}
+
+		std::string filename = commandLineParser.getValueAsString("flagsweepfile", "flag_sweep.csv");
+		std::ofstream result(filename, std::ios::out);
+		if (!result.is_open()) {
+			throw std::runtime_error("Unable to open init flag sweep results file " + filename);
+		}
+		result << std::fixed << std::setprecision(4);
+		for (const InitFlagOption& option : initFlagOptions) {
+			result << option.name << ",";
+		}
+		result << "output_width,output_height,input_width,input_height,temp_buffer_heap_bytes,temp_texture_heap_bytes,frames,"
+			<< "frame_time_mean_ms,frame_time_p50_ms,frame_time_p99_ms,xess_mean_ms,xess_p50_ms,xess_p99_ms" << "\n";
+
+		// Profiling is enabled by the re-initialization of the first combination
+		xessProfiling = true;
+		xessProfiler.Init(xessContext, xessGetProfilingData);
+
+		const uint32_t combinations = 1u << initFlagOptions.size();
+		for (const auto& resolution : resolutions) {
+			for (uint32_t combination = 0; combination < combinations; combination++) {
+				xessInitFlags = XESS_INIT_FLAG_HIGH_RES_MV;
+				for (size_t i = 0; i < initFlagOptions.size(); i++) {
+					if (combination & (1u << i)) {
+						xessInitFlags ^= initFlagOptions[i].flag;
+					}
+				}
+				resizeRenderTargets(resolution.first, resolution.second);
+
+				std::cout << "Flag sweep: " << describeInitFlags(xessInitFlags) << " at " << width << "x" << height
+					<< " from " << xessInputResolution.x << "x" << xessInputResolution.y << "\n";
+				SweepResult r = measureSweepCombination();
+
+				for (size_t i = 0; i < initFlagOptions.size(); i++) {
+					result << ((combination & (1u << i)) ? 1 : 0) << ",";
+				}
+				result << width << "," << height << "," << xessInputResolution.x << "," << xessInputResolution.y << ","
+					<< xessProperties.tempBufferHeapSize << "," << xessProperties.tempTextureHeapSize << "," << r.frames << ","
+					<< r.frameTimeMean << "," << r.frameTimeP50 << "," << r.frameTimeP99 << ","
+					<< r.xessTime.meanMs << "," << r.xessTime.p50Ms << "," << r.xessTime.p99Ms << "\n";
+				result.flush();
+			}
+		}
+	}
+
+	// Create the reference targets and read back buffers for the current output resolution
+	// The reference is rendered with the offscreen render pass at twice the output resolution in each dimension
+	void prepareQualityCapture()
+	{
+		const uint32_t referenceWidth = width * 2;
+		const uint32_t referenceHeight = height * 2;
+		// The offscreen render pass leaves its attachments in shader read layouts, which need sampled usage
+		createAttachment(offscreenFrameBuffers.render.color.format, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT, &qualityCapture.color, referenceWidth, referenceHeight);
+		createAttachment(offscreenFrameBuffers.render.depth.format, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, &qualityCapture.depth, referenceWidth, referenceHeight);
+		createAttachment(offscreenFrameBuffers.render.color.format, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT, &qualityCapture.resolved, width, height);
+
+		std::array<VkImageView, 2> attachments = { qualityCapture.color.view, qualityCapture.depth.view };
+		VkFramebufferCreateInfo fbufCreateInfo = vks::initializers::framebufferCreateInfo();
+		fbufCreateInfo.renderPass = offscreenFrameBuffers.render.renderPass;
+		fbufCreateInfo.pAttachments = attachments.data();
+		fbufCreateInfo.attachmentCount = static_cast<uint32_t>(attachments.size());
+		fbufCreateInfo.width = referenceWidth;
+		fbufCreateInfo.height = referenceHeight;
+		fbufCreateInfo.layers = 1;
+		VK_CHECK_RESULT(vkCreateFramebuffer(device, &fbufCreateInfo, nullptr, &qualityCapture.frameBuffer));
+
+		// Both copies are tightly packed with 8 bytes per texel
+		const VkDeviceSize copySize = (VkDeviceSize)width * height * 8;
+		VK_CHECK_RESULT(vulkanDevice->createBuffer(VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &qualityCapture.outputCopy, copySize));
+		VK_CHECK_RESULT(vulkanDevice->createBuffer(VK_BUFFER_USAGE_TRANSFER_DST_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, &qualityCapture.referenceCopy, copySize));
+		VK_CHECK_RESULT(qualityCapture.outputCopy.map());
+		VK_CHECK_RESULT(qualityCapture.referenceCopy.map());
+	}
+
+	void destroyQualityCapture()
+	{
+		vkDestroyFramebuffer(device, qualityCapture.frameBuffer, nullptr);
+		qualityCapture.frameBuffer = VK_NULL_HANDLE;
+		qualityCapture.color.destroy(device);
+		qualityCapture.depth.destroy(device);
+		qualityCapture.resolved.destroy(device);
+		qualityCapture.outputCopy.destroy();
+		qualityCapture.referenceCopy.destroy();
+	}
+
+	// Render the reference of the last frame and compare the XeSS output of that frame against it
+	// The reference uses the same scene state without jitter, supersampled 2x2 and box filtered down to the output resolution
+	// The caller must ensure that the last frame has completed on the GPU
+	void captureQuality(double& psnr, double& ssim)
+	{
+		const uint32_t referenceWidth = width * 2;
+		const uint32_t referenceHeight = height * 2;
+
+		// render() rewrites the uniform buffer for every frame, so it can be modified for the reference
+		ShaderData referenceData = m_uniformBufferData;
+		referenceData.offset.z = 0.f;
+		referenceData.offset.w = 0.f;
+		referenceData.resolution.x = (float)referenceWidth;
+		referenceData.resolution.y = (float)referenceHeight;
+		memcpy(uniformBuffers[currentBuffer].mapped, &referenceData, sizeof(referenceData));
+
+		VkCommandBuffer cmdBuffer = vulkanDevice->createCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
+
+		VkClearValue clearValues[2];
+		clearValues[0].color = { { 0.0f, 0.0f, 0.0f, 0.0f } };
+		clearValues[1].depthStencil = { 0.0f, 0 };
+
+		VkRenderPassBeginInfo renderPassBeginInfo = vks::initializers::renderPassBeginInfo();
+		renderPassBeginInfo.renderPass = offscreenFrameBuffers.render.renderPass;
+		renderPassBeginInfo.framebuffer = qualityCapture.frameBuffer;
+		renderPassBeginInfo.renderArea.extent.width = referenceWidth;
+		renderPassBeginInfo.renderArea.extent.height = referenceHeight;
+		renderPassBeginInfo.clearValueCount = 2;
+		renderPassBeginInfo.pClearValues = clearValues;
+		vkCmdBeginRenderPass(cmdBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+		VkViewport viewport = vks::initializers::viewport((float)referenceWidth, (float)referenceHeight, 0.0f, 1.0f);
+		vkCmdSetViewport(cmdBuffer, 0, 1, &viewport);
+		VkRect2D scissor = vks::initializers::rect2D(referenceWidth, referenceHeight, 0, 0);
+		vkCmdSetScissor(cmdBuffer, 0, 1, &scissor);
+		vkCmdBindDescriptorSets(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &uniformBuffers[currentBuffer].descriptorSet, 0, nullptr);
+		vkCmdBindPipeline(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+		VkDeviceSize offsets[1]{ 0 };
+		vkCmdBindVertexBuffers(cmdBuffer, 0, 1, &vertices.buffer, offsets);
+		vkCmdDraw(cmdBuffer, vertices.count, 1, 0, 0);
+		vkCmdEndRenderPass(cmdBuffer);
+
+		VkImageSubresourceRange colorRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+		vks::tools::setImageLayout(cmdBuffer, qualityCapture.color.image, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, colorRange);
+		vks::tools::setImageLayout(cmdBuffer, qualityCapture.resolved.image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, colorRange);
+
+		// Linear filtering halfway between the reference texels averages each 2x2 block
+		VkImageBlit blit{};
+		blit.srcSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+		blit.srcOffsets[1] = { (int32_t)referenceWidth, (int32_t)referenceHeight, 1 };
+		blit.dstSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+		blit.dstOffsets[1] = { (int32_t)width, (int32_t)height, 1 };
+		vkCmdBlitImage(cmdBuffer, qualityCapture.color.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, qualityCapture.resolved.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit, VK_FILTER_LINEAR);
+
+		vks::tools::setImageLayout(cmdBuffer, qualityCapture.resolved.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, colorRange);
+		vks::tools::setImageLayout(cmdBuffer, xessOutput.image, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, colorRange);
+
+		VkBufferImageCopy region{};
+		region.imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+		region.imageExtent = { width, height, 1 };
+		vkCmdCopyImageToBuffer(cmdBuffer, qualityCapture.resolved.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, qualityCapture.referenceCopy.buffer, 1, &region);
+		vkCmdCopyImageToBuffer(cmdBuffer, xessOutput.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, qualityCapture.outputCopy.buffer, 1, &region);
+
+		vks::tools::setImageLayout(cmdBuffer, xessOutput.image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, colorRange);
+
+		// Waits for completion, the copies are host coherent
+		vulkanDevice->flushCommandBuffer(cmdBuffer, queue);
+
+		PerfTools::ImageView output;
+		output.format = PerfTools::PixelFormat::R16G16B16A16_UNORM;
+		output.width = width;
+		output.height = height;
+		output.rowPitch = width * 8;
+		output.data = static_cast<const uint8_t*>(qualityCapture.outputCopy.mapped);
+		PerfTools::ImageView reference = output;
+		reference.format = PerfTools::PixelFormat::R16G16B16A16_FLOAT;
+		reference.data = static_cast<const uint8_t*>(qualityCapture.referenceCopy.mapped);
+
+		psnr = PerfTools::ComputePsnr(output, reference);
+		ssim = PerfTools::ComputeSsim(output, reference);
+	}
+
+	// Results of one network model sweep combination, times in milliseconds
+	struct ModelSweepResult {
+		uint64_t frames = 0;
+		uint64_t qualityFrames = 0;
+		double psnr = 0.0;
+		double ssim = 0.0;
+		std::vector<std::string> passNames;
+		std::vector<PerfTools::PassStatistics> passes;
+	};
+
+	// Restart the input sequence: scene position, jitter sequence and XeSS history
+	void restartSequence()
+	{
+		m_uniformBufferData.offset.x = 0.f;
+		m_haltonIndex = 0;
+		jitter[0] = jitter[1] = 0.f;
+		xessResetHistory = true;
+	}
+
+	// Warm up, then replay the input sequence twice: once timed and profiled, once compared against the reference
+	// Reading back frames stalls the GPU, keeping the replays apart keeps that out of the timings
+	ModelSweepResult measureModelSweepCombination(uint32_t sequenceFrames)
+	{
+		// Frames before the history has converged are not rated, only every few frames are rated to bound the CPU cost of the metrics
+		const uint32_t settleFrames = std::min(16u, sequenceFrames / 2);
+		const uint32_t qualityInterval = 4;
+
+		auto tWarmupStart = std::chrono::high_resolution_clock::now();
+		while (std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - tWarmupStart).count() < benchmark.warmup) {
+			render();
+		}
+		vkDeviceWaitIdle(device);
+		xessProfiler.Flush();
+		xessProfiler.Reset();
+
+		ModelSweepResult result;
+		restartSequence();
+		for (uint32_t frame = 0; frame < sequenceFrames; frame++) {
+			render();
+		}
+		vkDeviceWaitIdle(device);
+		xessProfiler.Flush();
+		result.frames = sequenceFrames;
+		for (uint32_t pass = 0; pass < xessProfiler.GetPassCount(); pass++) {
+			PerfTools::PassStatistics statistics = xessProfiler.GetPassStatistics(pass);
+			result.passNames.push_back(statistics.name);
+			result.passes.push_back(statistics);
+		}
+
+		// Not profiled, the profiler is reset before the next combination
+		restartSequence();
+		double psnrSum = 0.0;
+		double ssimSum = 0.0;
+		for (uint32_t frame = 0; frame < sequenceFrames; frame++) {
+			render();
+			if (frame < settleFrames || (frame - settleFrames) % qualityInterval != 0) {
+				continue;
+			}
+			vkWaitForFences(device, 1, &waitFences[currentFrame], VK_TRUE, UINT64_MAX);
+			double psnr, ssim;
+			captureQuality(psnr, ssim);
+			// Identical images have an infinite PSNR, which would swamp the mean
+			psnrSum += std::min(psnr, 100.0);
+			ssimSum += ssim;
+			result.qualityFrames++;
+		}
+		if (result.qualityFrames > 0) {
+			result.psnr = psnrSum / (double)result.qualityFrames;
+			result.ssim = ssimSum / (double)result.qualityFrames;
+		}
+		return result;
+	}
+
+	// Measure GPU cost and image quality of every network model at every sweep resolution
+	// XeSS is re-initialized for every combination and fed the same input sequence, one CSV row is written per XeSS pass and combination
+	void runModelSweep()
+	{
+		const std::vector<std::pair<xess_network_model_t, const char*>> models = {
+			{ XESS_NETWORK_MODEL_KPSS, "kpss" },
+			{ XESS_NETWORK_MODEL_SPLAT, "splat" },
+			{ XESS_NETWORK_MODEL_3, "model_3" },
+			{ XESS_NETWORK_MODEL_4, "model_4" },
+			{ XESS_NETWORK_MODEL_5, "model_5" },
+			{ XESS_NETWORK_MODEL_6, "model_6" },
+		};
+
+		std::vector<std::pair<uint32_t, uint32_t>> resolutions = Utils::ParseResolutions(commandLineParser.getValueAsString("sweepresolutions", ""));
+		if (resolutions.empty()) {
+			resolutions.emplace_back(width, height);
+		}
+		uint32_t sequenceFrames = 120;
+		if (commandLineParser.isSet("modelsweepframes")) {
+			sequenceFrames = (uint32_t)std::max(1, commandLineParser.getValueAsInt("modelsweepframes", 120));
+		}
+
+		std::string filename = commandLineParser.getValueAsString("modelsweepfile", "model_sweep.csv");
+		std::ofstream result(filename, std::ios::out);
+		if (!result.is_open()) {
+			throw std::runtime_error("Unable to open network model sweep results file " + filename);
+		}
+		result << std::fixed << std::setprecision(4);
+		result << "model,output_width,output_height,input_width,input_height,frames,quality_frames,psnr_db,ssim,"
+			<< "pass,executions,mean_ms,p50_ms,p99_ms" << "\n";
+
+		// Every combination steps the scene by the same amount per frame
+		fixedFrameTime = 1.0 / 60.0;
+		// Profiling is enabled by the re-initialization of the first combination
+		xessProfiling = true;
+		xessProfiler.Init(xessContext, xessGetProfilingData);
+
+		for (const auto& resolution : resolutions) {
+			for (const auto& model : models) {
+				// Models not available in this build of XeSS are skipped, the selection only takes effect with the next initialization
+				if (xessSelectNetworkModel(xessContext, model.first) != XESS_RESULT_SUCCESS) {
+					std::cout << "Model sweep: " << model.second << " is not available, skipped\n";
+					continue;
+				}
+				xessNetworkModel = model.first;
+				resizeRenderTargets(resolution.first, resolution.second);
+				prepareQualityCapture();
+
+				std::cout << "Model sweep: " << model.second << " at " << width << "x" << height
+					<< " from " << xessInputResolution.x << "x" << xessInputResolution.y << "\n";
+				ModelSweepResult r = measureModelSweepCombination(sequenceFrames);
+				destroyQualityCapture();
+
+				for (size_t pass = 0; pass < r.passes.size(); pass++) {
+					result << model.second << "," << width << "," << height << ","
+						<< xessInputResolution.x << "," << xessInputResolution.y << "," << r.frames << "," << r.qualityFrames << ","
+						<< r.psnr << "," << r.ssim << "," << r.passNames[pass] << "," << r.passes[pass].count << ","
+						<< r.passes[pass].meanMs << "," << r.passes[pass].p50Ms << "," << r.passes[pass].p99Ms << "\n";
+				}
+				result.flush();
+			}
+		}
+	}
+
+	// Create, build and initialize a temporary XeSS context with the settings of the sample and time each phase
+	vks::StartupRun measureStartup(VkPipelineCache cache)
+	{
+		vks::StartupRun run;
+		xess_context_handle_t context = nullptr;
+		auto tStart = std::chrono::high_resolution_clock::now();
+		auto status = xessVKCreateContext(instance, physicalDevice, device, &context);
+		run.createContextMs = elapsedMs(tStart);
+		if (status != XESS_RESULT_SUCCESS)
+		{
+			throw std::runtime_error("Unable to create XeSS context");
+		}
+
+		if (xessNetworkModel != XESS_NETWORK_MODEL_UNKNOWN) {
+			status = xessSelectNetworkModel(context, xessNetworkModel);
+		}
+		if (status == XESS_RESULT_SUCCESS) {
+			buildXessPipelines(context, cache, run);
+			xess_vk_init_params_t params = getXessInitParams(cache);
+			tStart = std::chrono::high_resolution_clock::now();
+			status = xessVKInit(context, &params);
+			run.initMs = elapsedMs(tStart);
+		}
+
+		vkDeviceWaitIdle(device);
+		xessDestroyContext(context);
+		if (status != XESS_RESULT_SUCCESS)
+		{
+			throw std::runtime_error("Unable to initialize temporary XeSS context");
+		}
+		return run;
+	}
+
+	// Repeat cold and warm XeSS startups, cold runs build into a new empty pipeline cache and warm runs into a filled one
+	// Shader caches of the driver are not affected, so cold runs can be faster than a first start on a clean system
+	void measureStartupRuns(uint32_t count)
+	{
+		VkPipelineCache warmCache = createEmptyPipelineCache();
+		// Fill the warm cache, not reported
+		measureStartup(warmCache);
+		for (uint32_t i = 0; i < count; i++) {
+			VkPipelineCache coldCache = createEmptyPipelineCache();
+			benchmark.startupRuns.push_back(measureStartup(coldCache));
+			vkDestroyPipelineCache(device, coldCache, nullptr);
+			benchmark.startupRuns.push_back(measureStartup(warmCache));
+		}
+		vkDestroyPipelineCache(device, warmCache, nullptr);
+	}
+
+	// Phase times of every XeSS startup, the first one is the startup of the sample
+	std::string formatStartupReport() const
+	{
+		std::ostringstream report;
+		report << std::fixed << std::setprecision(3);
+		report << "XeSS startup [ms]\n";
+		report << std::left << std::setw(8) << "cache" << std::right << std::setw(15) << "create context" << std::setw(17) << "build pipelines"
+			<< std::setw(10) << "init" << std::setw(10) << "total" << std::setw(14) << "cache bytes" << std::setw(10) << "build" << "\n";
+		for (const vks::StartupRun& run : benchmark.startupRuns) {
+			report << std::left << std::setw(8) << (run.warmCache ? "warm" : "cold") << std::right << std::setw(15) << run.createContextMs
+				<< std::setw(17) << run.buildPipelinesMs << std::setw(10) << run.initMs << std::setw(10) << run.totalMs()
+				<< std::setw(14) << run.cacheBytesAfter << std::setw(10) << (run.nonBlockingBuild ? "async" : "blocking") << "\n";
+		}
+		return report.str();
+	}
+
+	// Build the pipelines of the init flags one key press away from the current ones in the background
+	// Interactive runs only, the sweeps switch to every combination and would compete with the prewarm
+	void startPrewarm()
+	{
+		if (!commandLineParser.isSet("prewarm")) {
+			return;
+		}
+		std::vector<PerfTools::PrewarmCandidate> candidates;
+		for (const InitFlagOption& option : initFlagOptions) {
+			candidates.push_back({ getXessInitFlags() ^ option.flag, 1.0 });
+		}
+		PerfTools::PrewarmBudget budget;
+		budget.maxBuilds = (uint32_t)std::max(commandLineParser.getValueAsInt("prewarm", 2), 0);
+		xessPrewarmer.Start(candidates, budget, { getXessInitFlags() });
+	}
+
+	// Entry point after prepare, runs the benchmark sweeps instead of the render loop if requested
+	void run()
+	{
+		// Before rendering, so that the runs are part of the benchmark results
+		if (commandLineParser.isSet("startupruns")) {
+			measureStartupRuns((uint32_t)std::max(commandLineParser.getValueAsInt("startupruns", 1), 1));
+		}
+
+		if (commandLineParser.isSet("modelsweep")) {
+			runModelSweep();
+		} else if (commandLineParser.isSet("sweep")) {
+			runSweep();
+		} else if (commandLineParser.isSet("flagsweep")) {
+			runFlagSweep();
+		} else {
+			startPrewarm();
+			renderLoop();
+		}
+
+		if (gpuPassTimers) {
+			vkDeviceWaitIdle(device);
+			flushGpuTimestamps();
+			std::cout << gpuPassProfiler.FormatReport("Sample GPU passes");
+			std::cout << formatGpuPassReport();
+			if (gpuTimestamps.unavailableFrames != 0) {
+				std::cout << gpuTimestamps.unavailableFrames << " frames without available timestamps\n";
+			}
+		}
+
+		if (commandLineParser.isSet("startupruns")) {
+			std::cout << formatStartupReport();
+			std::cout << startupTasks.FormatReport();
+		}
+
+		if (commandLineParser.isSet("prewarm")) {
+			xessPrewarmer.Cancel();
+			xessPrewarmer.Wait();
+			std::cout << xessPrewarmer.FormatReport();
+		}
+	}
 };
 
 // OS specific main entry points
@@ -1663,7 +2965,7 @@ int APIENTRY WinMain(HINSTANCE hInstance, HINSTANCE, LPSTR, int)
 		vulkanExample->initVulkan();
 		vulkanExample->setupWindow(hInstance, WndProc);
 		vulkanExample->prepare();
-		vulkanExample->renderLoop();
+		vulkanExample->run();
 		delete(vulkanExample);
 		return 0;
 	}
@@ -1688,7 +2990,7 @@ int main(const int argc, const char *argv[])
 	vulkanExample = new VulkanExample();
 	vulkanExample->initVulkan();
 	vulkanExample->prepare();
-	vulkanExample->renderLoop();
+	vulkanExample->run();
 	delete(vulkanExample);
 	return 0;
 }
@@ -1708,7 +3010,7 @@ int main(const int argc, const char *argv[])
 	vulkanExample->initVulkan();
 	vulkanExample->setupWindow();
 	vulkanExample->prepare();
-	vulkanExample->renderLoop();
+	vulkanExample->run();
 	delete(vulkanExample);
 	return 0;
 }
@@ -1721,7 +3023,7 @@ int main(const int argc, const char *argv[])
 	vulkanExample->initVulkan();
 	vulkanExample->setupWindow();
 	vulkanExample->prepare();
-	vulkanExample->renderLoop();
+	vulkanExample->run();
 	delete(vulkanExample);
 	return 0;
 }
@@ -1751,7 +3053,7 @@ int main(const int argc, const char *argv[])
 		vulkanExample->initVulkan();
 		vulkanExample->setupWindow();
 		vulkanExample->prepare();
-		vulkanExample->renderLoop();
+		vulkanExample->run();
 		delete(vulkanExample);
 	}
 	catch(const std::runtime_error &err)
@@ -14,6 +14,8 @@
 
 #include "utils.h"
 
+#include <cstdlib>
+
 namespace
 {
     float GetCorput(std::uint32_t index, std::uint32_t base)
@@ -45,3 +47,33 @@ std::vector<std::pair<float, float>> Utils::GenerateHalton(std::uint32_t base1,
     }
     return result;
 }
+
+std::vector<std::pair<std::uint32_t, std::uint32_t>> Utils::ParseResolutions(const std::string& list)
+{
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> result;
+
+    std::size_t begin = 0;
+    while (begin < list.size())
+    {
+        std::size_t end = list.find(',', begin);
+        if (end == std::string::npos)
+        {
+            end = list.size();
+        }
+
+        const std::string entry = list.substr(begin, end - begin);
+        char* widthEnd = nullptr;
+        const unsigned long width = std::strtoul(entry.c_str(), &widthEnd, 10);
+        if (*widthEnd == 'x')
+        {
+            char* heightEnd = nullptr;
+            const unsigned long height = std::strtoul(widthEnd + 1, &heightEnd, 10);
+            if (*heightEnd == '\0' && width > 0 && height > 0)
+            {
+                result.emplace_back((std::uint32_t)width, (std::uint32_t)height);
+            }
+        }
+        begin = end + 1;
+    }
+    return result;
+}
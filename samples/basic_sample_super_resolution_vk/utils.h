@@ -15,6 +15,7 @@
 #pragma once
 
 #include <cstdint>
+#include <string>
 #include <vector>
 #include <utility>
 
@@ -31,4 +32,11 @@ namespace Utils
  */
 std::vector<std::pair<float, float>> GenerateHalton(std::uint32_t base1, std::uint32_t base2,
     std::uint32_t start_index, std::uint32_t count, float offset1 = -0.5f, float offset2 = -0.5f);
+
+/**
+ * Parses a comma separated list of resolutions
+ * @param list - resolutions as WIDTHxHEIGHT, e.g. "1920x1080,3840x2160"
+ * @return width and height of every valid entry, malformed entries are skipped
+ */
+std::vector<std::pair<std::uint32_t, std::uint32_t>> ParseResolutions(const std::string& list);
 }
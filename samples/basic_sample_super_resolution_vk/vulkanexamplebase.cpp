@@ -28,7 +28,10 @@ VkResult VulkanExampleBase::createInstance(bool enableValidation)
 	this->settings.validation = true;
 #endif
 
-	std::vector<const char*> instanceExtensions = { VK_KHR_SURFACE_EXTENSION_NAME };
+	std::vector<const char*> instanceExtensions;
+	if (!settings.headless) {
+		instanceExtensions.push_back(VK_KHR_SURFACE_EXTENSION_NAME);
+	}
 
 	{
 		// Get extensions and api version required by XeSS
@@ -61,28 +64,30 @@ VkResult VulkanExampleBase::createInstance(bool enableValidation)
 
 	
 
-	// Enable surface extensions depending on os
+	// Enable surface extensions depending on os, no surface is created in headless mode
+	if (!settings.headless) {
 #if defined(_WIN32)
-	instanceExtensions.push_back(VK_KHR_WIN32_SURFACE_EXTENSION_NAME);
+		instanceExtensions.push_back(VK_KHR_WIN32_SURFACE_EXTENSION_NAME);
 #elif defined(VK_USE_PLATFORM_ANDROID_KHR)
-	instanceExtensions.push_back(VK_KHR_ANDROID_SURFACE_EXTENSION_NAME);
+		instanceExtensions.push_back(VK_KHR_ANDROID_SURFACE_EXTENSION_NAME);
 #elif defined(_DIRECT2DISPLAY)
-	instanceExtensions.push_back(VK_KHR_DISPLAY_EXTENSION_NAME);
+		instanceExtensions.push_back(VK_KHR_DISPLAY_EXTENSION_NAME);
 #elif defined(VK_USE_PLATFORM_DIRECTFB_EXT)
-	instanceExtensions.push_back(VK_EXT_DIRECTFB_SURFACE_EXTENSION_NAME);
+		instanceExtensions.push_back(VK_EXT_DIRECTFB_SURFACE_EXTENSION_NAME);
 #elif defined(VK_USE_PLATFORM_WAYLAND_KHR)
-	instanceExtensions.push_back(VK_KHR_WAYLAND_SURFACE_EXTENSION_NAME);
+		instanceExtensions.push_back(VK_KHR_WAYLAND_SURFACE_EXTENSION_NAME);
 #elif defined(VK_USE_PLATFORM_XCB_KHR)
-	instanceExtensions.push_back(VK_KHR_XCB_SURFACE_EXTENSION_NAME);
+		instanceExtensions.push_back(VK_KHR_XCB_SURFACE_EXTENSION_NAME);
 #elif defined(VK_USE_PLATFORM_IOS_MVK)
-	instanceExtensions.push_back(VK_MVK_IOS_SURFACE_EXTENSION_NAME);
+		instanceExtensions.push_back(VK_MVK_IOS_SURFACE_EXTENSION_NAME);
 #elif defined(VK_USE_PLATFORM_MACOS_MVK)
-	instanceExtensions.push_back(VK_MVK_MACOS_SURFACE_EXTENSION_NAME);
+		instanceExtensions.push_back(VK_MVK_MACOS_SURFACE_EXTENSION_NAME);
 #elif defined(VK_USE_PLATFORM_HEADLESS_EXT)
-	instanceExtensions.push_back(VK_EXT_HEADLESS_SURFACE_EXTENSION_NAME);
+		instanceExtensions.push_back(VK_EXT_HEADLESS_SURFACE_EXTENSION_NAME);
 #elif defined(VK_USE_PLATFORM_SCREEN_QNX)
-	instanceExtensions.push_back(VK_QNX_SCREEN_SURFACE_EXTENSION_NAME);
+		instanceExtensions.push_back(VK_QNX_SCREEN_SURFACE_EXTENSION_NAME);
 #endif
+	}
 	
 	// Get extensions supported by the instance and store for later use
 	uint32_t extCount = 0;
@@ -233,9 +238,14 @@ void VulkanExampleBase::createPipelineCache()
 
 void VulkanExampleBase::prepare()
 {
-	initSwapchain();
-	createCommandPool();
-	setupSwapChain();
+	if (settings.headless) {
+		setupHeadlessTargets();
+		createCommandPool();
+	} else {
+		initSwapchain();
+		createCommandPool();
+		setupSwapChain();
+	}
 	createCommandBuffers();
 	createSynchronizationPrimitives();
 	setupDepthStencil();
@@ -343,6 +353,9 @@ void VulkanExampleBase::renderLoop()
 
 		benchmark.run([=] { render(); }, vulkanDevice->properties);
 		vkDeviceWaitIdle(device);
+		if (benchmark.jsonFilename != "") {
+			benchmark.saveJson();
+		}
 		if (benchmark.filename != "") {
 			benchmark.saveResults();
 		}
@@ -782,6 +795,10 @@ void VulkanExampleBase::drawUI(const VkCommandBuffer /*commandBuffer*/)
 
 void VulkanExampleBase::prepareFrame()
 {
+	if (settings.headless) {
+		currentBuffer = acquireHeadlessTarget();
+		return;
+	}
 	// Acquire the next image from the swap chain
 	VkResult result = swapChain.acquireNextImage(semaphores.presentComplete, &currentBuffer);
 	// Recreate the swapchain if it's no longer compatible with the surface (OUT_OF_DATE)
@@ -799,6 +816,10 @@ void VulkanExampleBase::prepareFrame()
 
 void VulkanExampleBase::submitFrame()
 {
+	if (settings.headless) {
+		VK_CHECK_RESULT(vkQueueWaitIdle(queue));
+		return;
+	}
 	VkResult result = swapChain.queuePresent(queue, currentBuffer, semaphores.renderComplete);
 	// Recreate the swapchain if it's no longer compatible with the surface (OUT_OF_DATE) or no longer optimal for presentation (SUBOPTIMAL)
 	if ((result == VK_ERROR_OUT_OF_DATE_KHR) || (result == VK_SUBOPTIMAL_KHR)) {
@@ -848,6 +869,24 @@ VulkanExampleBase::VulkanExampleBase(bool enableValidation)
 	commandLineParser.add("benchmarkresultfile", { "-bf", "--benchfilename" }, 1, "Set file name for benchmark results");
 	commandLineParser.add("benchmarkresultframes", { "-bt", "--benchframetimes" }, 0, "Save frame times to benchmark results file");
 	commandLineParser.add("benchmarkframes", { "-bfs", "--benchmarkframes" }, 1, "Only render the given number of frames");
+	commandLineParser.add("benchmarkjson", { "-bj", "--benchjson" }, 1, "Save frame time statistics of benchmark mode as JSON");
+	commandLineParser.add("headless", { "-hl", "--headless" }, 0, "Run benchmark mode offscreen without window and swapchain");
+	commandLineParser.add("sweep", { "-sw", "--sweep" }, 0, "Benchmark every XeSS quality setting for every sweep resolution, implies headless mode");
+	commandLineParser.add("sweepresolutions", { "-swr", "--sweepresolutions" }, 1, "Comma separated output resolutions of the sweep, e.g. 1920x1080,3840x2160");
+	commandLineParser.add("sweeplegacy", { "-swl", "--sweeplegacy" }, 0, "Repeat the sweep with legacy scale factors forced");
+	commandLineParser.add("sweepfile", { "-swf", "--sweepfile" }, 1, "Set file name for sweep results");
+	commandLineParser.add("xessflags", { "-xf", "--xessflags" }, 1, "Comma separated XeSS init flags: lowresmv, autoexposure, responsivemask, ldrinput, jitteredmv");
+	commandLineParser.add("flagsweep", { "-fs", "--flagsweep" }, 0, "Benchmark every combination of the switchable XeSS init flags for every sweep resolution, implies headless mode");
+	commandLineParser.add("flagsweepfile", { "-fsf", "--flagsweepfile" }, 1, "Set file name for init flag sweep results");
+	commandLineParser.add("modelsweep", { "-ms", "--modelsweep" }, 0, "Measure cost and quality of every XeSS network model for every sweep resolution, implies headless mode");
+	commandLineParser.add("modelsweepframes", { "-msn", "--modelsweepframes" }, 1, "Set number of frames of the replayed input sequence per model (default 120)");
+	commandLineParser.add("modelsweepfile", { "-msf", "--modelsweepfile" }, 1, "Set file name for network model sweep results");
+	commandLineParser.add("passtimers", { "-pt", "--passtimers" }, 0, "Measure GPU time, shader invocations and memory traffic of every pass and print a summary on exit");
+	commandLineParser.add("startupruns", { "-sr", "--startupruns" }, 1, "Repeat cold and warm XeSS startups N times and report the time of each phase");
+	commandLineParser.add("pipelinecache", { "-pc", "--pipelinecache" }, 1, "Set file name of the persistent pipeline cache (default pipeline_cache.bin)");
+	commandLineParser.add("coldpipelinecache", { "-cpc", "--coldpipelinecache" }, 0, "Start with an empty pipeline cache, the cache file is still written on exit");
+	commandLineParser.add("serialstartup", { "-ss", "--serialstartup" }, 0, "Run the startup tasks in order on one thread with a blocking XeSS pipeline build");
+	commandLineParser.add("prewarm", { "-pw", "--prewarm" }, 1, "Build the XeSS pipelines of up to N init flag toggles into the pipeline cache in the background");
 
 	commandLineParser.parse(args);
 	if (commandLineParser.isSet("help")) {
@@ -882,7 +921,11 @@ VulkanExampleBase::VulkanExampleBase(bool enableValidation)
 			shaderDir = value;
 		}
 	}
-	if (commandLineParser.isSet("benchmark")) {
+	if (commandLineParser.isSet("headless") || commandLineParser.isSet("sweep") || commandLineParser.isSet("flagsweep") ||
+		commandLineParser.isSet("modelsweep")) {
+		settings.headless = true;
+	}
+	if (commandLineParser.isSet("benchmark") || settings.headless) {
 		benchmark.active = true;
 		vks::tools::errorModeSilent = true;
 	}
@@ -901,6 +944,9 @@ VulkanExampleBase::VulkanExampleBase(bool enableValidation)
 	if (commandLineParser.isSet("benchmarkframes")) {
 		benchmark.outputFrames = commandLineParser.getValueAsInt("benchmarkframes", benchmark.outputFrames);
 	}
+	if (commandLineParser.isSet("benchmarkjson")) {
+		benchmark.jsonFilename = commandLineParser.getValueAsString("benchmarkjson", benchmark.jsonFilename);
+	}
 
 #if defined(VK_USE_PLATFORM_ANDROID_KHR)
 	// Vulkan library is loaded dynamically on Android
@@ -928,6 +974,7 @@ VulkanExampleBase::~VulkanExampleBase()
 {
 	// Clean up Vulkan resources
 	swapChain.cleanup();
+	destroyHeadlessTargets();
 	if (descriptorPool != VK_NULL_HANDLE)
 	{
 		vkDestroyDescriptorPool(device, descriptorPool, nullptr);
@@ -1097,7 +1144,7 @@ bool VulkanExampleBase::initVulkan()
 	// Derived examples can enable extensions based on the list of supported extensions read from the physical device
 	getEnabledExtensions();
 
-	VkResult res = vulkanDevice->createLogicalDevice(enabledFeatures, enabledDeviceExtensions, deviceCreatepNextChain);
+	VkResult res = vulkanDevice->createLogicalDevice(enabledFeatures, enabledDeviceExtensions, deviceCreatepNextChain, !settings.headless);
 	if (res != VK_SUCCESS) {
 		vks::tools::exitFatal("Could not create Vulkan device: \n" + vks::tools::errorString(res), res);
 		return false;
@@ -1133,9 +1180,10 @@ bool VulkanExampleBase::initVulkan()
 	// Command buffer submission info is set by each example
 	submitInfo = vks::initializers::submitInfo();
 	submitInfo.pWaitDstStageMask = &submitPipelineStages;
-	submitInfo.waitSemaphoreCount = 1;
+	// Nothing signals or waits for the semaphores without a swap chain
+	submitInfo.waitSemaphoreCount = settings.headless ? 0 : 1;
 	submitInfo.pWaitSemaphores = &semaphores.presentComplete;
-	submitInfo.signalSemaphoreCount = 1;
+	submitInfo.signalSemaphoreCount = settings.headless ? 0 : 1;
 	submitInfo.pSignalSemaphores = &semaphores.renderComplete;
 
 	return true;
@@ -1183,6 +1231,14 @@ HWND VulkanExampleBase::setupWindow(HINSTANCE hinstance, WNDPROC wndproc)
 {
 	this->windowInstance = hinstance;
 
+	if (settings.headless) {
+		// Results are written to the console and the benchmark files only
+		if (!settings.validation) {
+			setupConsole(title);
+		}
+		return nullptr;
+	}
+
 	WNDCLASSEX wndClass;
 
 	wndClass.cbSize = sizeof(WNDCLASSEX);
@@ -1949,6 +2005,9 @@ void VulkanExampleBase::displayLinkOutputCb()
 #if defined(VK_EXAMPLE_XCODE_GENERATED)
 	if (benchmark.active) {
 		benchmark.run([=] { render(); }, vulkanDevice->properties);
+		if (benchmark.jsonFilename != "") {
+			benchmark.saveJson();
+		}
 		if (benchmark.filename != "") {
 			benchmark.saveResults();
 		}
@@ -3114,7 +3173,7 @@ void VulkanExampleBase::setupRenderPass()
 	attachments[0].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
 	attachments[0].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
 	attachments[0].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-	attachments[0].finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+	attachments[0].finalLayout = settings.headless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
 	// Depth attachment
 	attachments[1].format = depthFormat;
 	attachments[1].samples = VK_SAMPLE_COUNT_1_BIT;
@@ -3194,7 +3253,12 @@ void VulkanExampleBase::windowResize()
 	// Recreate swap chain
 	width = destWidth;
 	height = destHeight;
-	setupSwapChain();
+	if (settings.headless) {
+		destroyHeadlessTargets();
+		setupHeadlessTargets();
+	} else {
+		setupSwapChain();
+	}
 
 	// Recreate the frame buffers
 	vkDestroyImageView(device, depthStencil.view, nullptr);
@@ -3239,6 +3303,13 @@ void VulkanExampleBase::windowResize()
 	prepared = true;
 }
 
+void VulkanExampleBase::resizeRenderTargets(uint32_t newWidth, uint32_t newHeight)
+{
+	destWidth = newWidth;
+	destHeight = newHeight;
+	windowResize();
+}
+
 void VulkanExampleBase::handleMouseMove(int32_t x, int32_t y)
 {
 	int32_t dx = (int32_t)mousePos.x - x;
@@ -3301,6 +3372,69 @@ void VulkanExampleBase::setupSwapChain()
 	swapChain.create(&width, &height, settings.vsync, settings.fullscreen);
 }
 
+void VulkanExampleBase::setupHeadlessTargets()
+{
+	// Offscreen color targets stand in for the swap chain images, so samples can keep
+	// using swapChain.buffers, swapChain.colorFormat and swapChain.queueNodeIndex
+	const uint32_t targetCount = 3;
+	swapChain.colorFormat = VK_FORMAT_B8G8R8A8_UNORM;
+	swapChain.colorSpace = VK_COLOR_SPACE_SRGB_NONLINEAR_KHR;
+	swapChain.imageCount = targetCount;
+	swapChain.queueNodeIndex = vulkanDevice->queueFamilyIndices.graphics;
+	swapChain.images.resize(targetCount);
+	swapChain.buffers.resize(targetCount);
+	headlessTargetMemory.resize(targetCount);
+
+	for (uint32_t i = 0; i < targetCount; i++)
+	{
+		VkImageCreateInfo imageCI = vks::initializers::imageCreateInfo();
+		imageCI.imageType = VK_IMAGE_TYPE_2D;
+		imageCI.format = swapChain.colorFormat;
+		imageCI.extent = { width, height, 1 };
+		imageCI.mipLevels = 1;
+		imageCI.arrayLayers = 1;
+		imageCI.samples = VK_SAMPLE_COUNT_1_BIT;
+		imageCI.tiling = VK_IMAGE_TILING_OPTIMAL;
+		// Transfer source, so the result can be read back like a presented image
+		imageCI.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+		VK_CHECK_RESULT(vkCreateImage(device, &imageCI, nullptr, &swapChain.images[i]));
+
+		VkMemoryRequirements memReqs{};
+		vkGetImageMemoryRequirements(device, swapChain.images[i], &memReqs);
+		VkMemoryAllocateInfo memAlloc = vks::initializers::memoryAllocateInfo();
+		memAlloc.allocationSize = memReqs.size;
+		memAlloc.memoryTypeIndex = vulkanDevice->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+		VK_CHECK_RESULT(vkAllocateMemory(device, &memAlloc, nullptr, &headlessTargetMemory[i]));
+		VK_CHECK_RESULT(vkBindImageMemory(device, swapChain.images[i], headlessTargetMemory[i], 0));
+
+		VkImageViewCreateInfo imageViewCI = vks::initializers::imageViewCreateInfo();
+		imageViewCI.viewType = VK_IMAGE_VIEW_TYPE_2D;
+		imageViewCI.format = swapChain.colorFormat;
+		imageViewCI.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+		imageViewCI.image = swapChain.images[i];
+		swapChain.buffers[i].image = swapChain.images[i];
+		VK_CHECK_RESULT(vkCreateImageView(device, &imageViewCI, nullptr, &swapChain.buffers[i].view));
+	}
+}
+
+void VulkanExampleBase::destroyHeadlessTargets()
+{
+	for (uint32_t i = 0; i < headlessTargetMemory.size(); i++)
+	{
+		vkDestroyImageView(device, swapChain.buffers[i].view, nullptr);
+		vkDestroyImage(device, swapChain.images[i], nullptr);
+		vkFreeMemory(device, headlessTargetMemory[i], nullptr);
+	}
+	headlessTargetMemory.clear();
+}
+
+uint32_t VulkanExampleBase::acquireHeadlessTarget()
+{
+	const uint32_t target = headlessTargetIndex;
+	headlessTargetIndex = (headlessTargetIndex + 1) % swapChain.imageCount;
+	return target;
+}
+
 #ifndef XESS
 void VulkanExampleBase::OnUpdateUIOverlay(vks::UIOverlay *overlay) {}
 #endif
@@ -90,6 +90,8 @@ private:
 	void createSynchronizationPrimitives();
 	void initSwapchain();
 	void setupSwapChain();
+	void setupHeadlessTargets();
+	void destroyHeadlessTargets();
 	void createCommandBuffers();
 	void destroyCommandBuffers();
 	std::string shaderDir = "glsl";
@@ -156,6 +158,12 @@ protected:
 	} semaphores;
 	std::vector<VkFence> waitFences;
 	bool requiresStencil{ false };
+	// Memory of the offscreen color targets used instead of the swap chain images in headless mode
+	std::vector<VkDeviceMemory> headlessTargetMemory;
+	// Next offscreen color target to render to in headless mode
+	uint32_t headlessTargetIndex = 0;
+	/** @brief Returns the next offscreen color target in headless mode, targets are used round robin */
+	uint32_t acquireHeadlessTarget();
 public:
 	bool prepared = false;
 	bool resized = false;
@@ -184,6 +192,8 @@ public:
 		bool vsync = false;
 		/** @brief Enable UI overlay */
 		bool overlay = true;
+		/** @brief Render to offscreen targets without window, surface and swapchain, implies benchmark mode */
+		bool headless = false;
 	} settings;
 
 	VkClearColorValue defaultClearColor = { { 0.025f, 0.025f, 0.025f, 1.0f } };
@@ -389,6 +399,8 @@ public:
 	VkPipelineShaderStageCreateInfo loadShader(std::string fileName, VkShaderStageFlagBits stage);
 
 	void windowResize();
+	/** @brief Resizes all render targets without a window event, e.g. for benchmark sweeps in headless mode */
+	void resizeRenderTargets(uint32_t newWidth, uint32_t newHeight);
 
 	/** @brief Entry point for the main render loop */
 	void renderLoop();
@@ -0,0 +1,250 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#include "anomaly_detector.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+namespace
+{
+    /** Residuals beyond this many deviations are clipped before they update the baseline. */
+    const double HuberClip = 3.0;
+    /** Largest z-score a single sample adds to a CUSUM sum, a lone stutter cannot move the baseline. */
+    const double CusumClip = 4.0;
+    /** Weight of a new residual in the autocorrelation, about twenty samples. */
+    const double CorrelationWeight = 0.05;
+    /** E|x| of a normal distribution is sigma * sqrt(2 / pi). */
+    const double AbsoluteToSigma = 1.2533;
+    /** Lower bound of the deviation relative to the baseline, keeps scores of very steady signals finite. */
+    const double MinRelativeScale = 0.01;
+    /** Samples whose median becomes the new baseline after a CUSUM alarm. */
+    const std::uint32_t RebaselineSamples = 8;
+
+    std::uint64_t SteadyNowNs()
+    {
+        return (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+namespace PerfTools
+{
+std::uint32_t AnomalyDetector::AddSignal(const char* name, const AnomalySignalConfig& config)
+{
+    if (m_signalCount == MaxSignals)
+    {
+        return MaxSignals;
+    }
+
+    Signal& signal = m_signals[m_signalCount];
+    signal = Signal();
+    signal.name = name;
+    signal.config = config;
+    return m_signalCount++;
+}
+
+void AnomalyDetector::Reset()
+{
+    for (std::uint32_t i = 0; i < m_signalCount; ++i)
+    {
+        const char* name = m_signals[i].name;
+        const AnomalySignalConfig config = m_signals[i].config;
+        m_signals[i] = Signal();
+        m_signals[i].name = name;
+        m_signals[i].config = config;
+    }
+    m_eventWrite = 0;
+    m_eventRead = 0;
+    m_eventCount = 0;
+    m_droppedEvents = 0;
+}
+
+bool AnomalyDetector::Add(std::uint32_t signalId, std::uint64_t frameIndex, double value)
+{
+    if (signalId >= m_signalCount || !std::isfinite(value))
+    {
+        return false;
+    }
+
+    Signal& signal = m_signals[signalId];
+    const AnomalySignalConfig& config = signal.config;
+    signal.history[signal.sampleCount % AnomalyEvent::ContextLength] = (float)value;
+    signal.sampleCount++;
+
+    // Running mean and mean absolute residual during warm up.
+    if (signal.sampleCount == 1)
+    {
+        signal.baseline = value;
+        return false;
+    }
+    if (signal.sampleCount <= config.warmupSamples)
+    {
+        const double weight = std::max(1.0 / (double)signal.sampleCount, config.baselineWeight);
+        const double residual = value - signal.baseline;
+        signal.baseline += weight * residual;
+        signal.deviation += weight * (std::fabs(residual) - signal.deviation);
+        return false;
+    }
+
+    double scale = std::max(AbsoluteToSigma * signal.deviation, MinRelativeScale * std::fabs(signal.baseline));
+    if (scale <= 0.0)
+    {
+        scale = 1e-9;
+    }
+    const double residual = value - signal.baseline;
+    const double score = residual / scale;
+    bool raised = false;
+
+    if (score > config.stutterScore && residual > config.minStutterExcess)
+    {
+        raised |= RaiseEvent(signal, signalId, AnomalyKind::Stutter, frameIndex, value, scale, score);
+    }
+
+    const double clippedScore = std::min(std::max(score, -CusumClip), CusumClip);
+    signal.cusumUp = std::max(0.0, signal.cusumUp + clippedScore - config.cusumSlack);
+    signal.cusumDown = std::max(0.0, signal.cusumDown - clippedScore - config.cusumSlack);
+    if (signal.cusumUp > config.cusumThreshold || signal.cusumDown > config.cusumThreshold)
+    {
+        if (signal.cusumUp > config.cusumThreshold)
+        {
+            raised |= RaiseEvent(signal, signalId, AnomalyKind::Regression, frameIndex, value, scale, signal.cusumUp);
+        }
+
+        // Restart from the new level instead of slowly adapting to it. The median
+        // ignores stutters among the last samples.
+        const std::uint32_t count = signal.sampleCount < RebaselineSamples ?
+            (std::uint32_t)signal.sampleCount : RebaselineSamples;
+        float recent[RebaselineSamples];
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            recent[i] = signal.history[(signal.sampleCount - 1 - i) % AnomalyEvent::ContextLength];
+        }
+        std::nth_element(recent, recent + count / 2, recent + count);
+        signal.baseline = recent[count / 2];
+        signal.cusumUp = 0.0;
+        signal.cusumDown = 0.0;
+        signal.previousResidual = 0.0;
+    }
+    else
+    {
+        const double limit = HuberClip * scale;
+        const double clippedResidual = std::min(std::max(residual, -limit), limit);
+        signal.baseline += config.baselineWeight * clippedResidual;
+        signal.deviation += config.baselineWeight * (std::fabs(clippedResidual) - signal.deviation);
+    }
+
+    // Alternating residuals correlate negatively with their predecessor, a lone
+    // stutter only raises the energy.
+    signal.residualCovariance += CorrelationWeight * (residual * signal.previousResidual - signal.residualCovariance);
+    signal.residualEnergy += CorrelationWeight * (residual * residual - signal.residualEnergy);
+    signal.previousResidual = residual;
+    if (signal.residualEnergy > 0.0)
+    {
+        const double correlation = signal.residualCovariance / signal.residualEnergy;
+        if (correlation < config.oscillationCorrelation &&
+            signal.residualEnergy > config.minOscillationAmplitude * config.minOscillationAmplitude * signal.baseline * signal.baseline)
+        {
+            raised |= RaiseEvent(signal, signalId, AnomalyKind::Oscillation, frameIndex, value, scale, correlation);
+        }
+    }
+    return raised;
+}
+
+bool AnomalyDetector::RaiseEvent(Signal& signal, std::uint32_t signalId, AnomalyKind kind, std::uint64_t frameIndex,
+    double value, double scale, double score)
+{
+    std::uint64_t& quietUntil = signal.quietUntil[(std::uint32_t)kind];
+    if (signal.sampleCount < quietUntil)
+    {
+        return false;
+    }
+    quietUntil = signal.sampleCount + signal.config.cooldownSamples;
+
+    if (m_eventWrite - m_eventRead == EventCapacity)
+    {
+        m_eventRead++;
+        m_droppedEvents++;
+    }
+
+    AnomalyEvent& event = m_events[m_eventWrite % EventCapacity];
+    event.frameIndex = frameIndex;
+    event.timestampNs = SteadyNowNs();
+    event.signal = signalId;
+    event.kind = kind;
+    event.value = (float)value;
+    event.baseline = (float)signal.baseline;
+    event.scale = (float)scale;
+    event.score = (float)score;
+    event.contextCount = signal.sampleCount < AnomalyEvent::ContextLength ?
+        (std::uint32_t)signal.sampleCount : AnomalyEvent::ContextLength;
+    const std::uint64_t first = signal.sampleCount - event.contextCount;
+    for (std::uint32_t i = 0; i < event.contextCount; ++i)
+    {
+        event.context[i] = signal.history[(first + i) % AnomalyEvent::ContextLength];
+    }
+
+    m_eventWrite++;
+    m_eventCount++;
+    return true;
+}
+
+std::uint32_t AnomalyDetector::Drain(AnomalyEvent* events, std::uint32_t maxCount)
+{
+    std::uint32_t count = 0;
+    while (count < maxCount && m_eventRead != m_eventWrite)
+    {
+        events[count++] = m_events[m_eventRead++ % EventCapacity];
+    }
+    return count;
+}
+
+const char* AnomalyDetector::GetSignalName(std::uint32_t signal) const
+{
+    return signal < m_signalCount ? m_signals[signal].name : "unknown";
+}
+
+const char* AnomalyDetector::GetKindName(AnomalyKind kind)
+{
+    switch (kind)
+    {
+    case AnomalyKind::Stutter:
+        return "stutter";
+    case AnomalyKind::Regression:
+        return "regression";
+    case AnomalyKind::Oscillation:
+        return "oscillation";
+    default:
+        return "unknown";
+    }
+}
+
+std::string AnomalyDetector::FormatEvent(const AnomalyEvent& event) const
+{
+    char line[256];
+    std::snprintf(line, sizeof(line), "Anomaly at frame %llu: %s %s, value %.3f, baseline %.3f, scale %.3f, score %.2f, context",
+        (unsigned long long)event.frameIndex, GetSignalName(event.signal), GetKindName(event.kind),
+        event.value, event.baseline, event.scale, event.score);
+    std::string text = line;
+    for (std::uint32_t i = 0; i < event.contextCount; ++i)
+    {
+        std::snprintf(line, sizeof(line), " %.3f", event.context[i]);
+        text += line;
+    }
+    text += "\n";
+    return text;
+}
+}
@@ -0,0 +1,163 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace PerfTools
+{
+enum class AnomalyKind : std::uint32_t
+{
+    /** A single sample far above the baseline. */
+    Stutter,
+    /** The baseline moved up and stayed there. */
+    Regression,
+    /** Samples alternate between high and low, like uneven frame pacing. */
+    Oscillation,
+    Count
+};
+
+/** Detection thresholds of one signal. Scores are in units of the robust baseline deviation. */
+struct AnomalySignalConfig
+{
+    /** Robust z-score above which a single sample is a stutter. */
+    double stutterScore = 6.0;
+    /** Minimum excess over the baseline of a stutter, in signal units. */
+    double minStutterExcess = 0.0;
+    /** CUSUM slack, shifts below it are not accumulated. */
+    double cusumSlack = 0.5;
+    /** CUSUM decision threshold, the baseline moves once a sum exceeds it. */
+    double cusumThreshold = 12.0;
+    /** Lag-1 autocorrelation of the residuals below which the signal oscillates. */
+    double oscillationCorrelation = -0.7;
+    /** Minimum oscillation amplitude, relative to the baseline. */
+    double minOscillationAmplitude = 0.1;
+    /** Weight of a new sample in the baseline and its deviation. */
+    double baselineWeight = 0.02;
+    /** Samples used to establish the baseline before anything is reported. */
+    std::uint32_t warmupSamples = 60;
+    /** Samples after an event during which the same kind is not reported again. */
+    std::uint32_t cooldownSamples = 120;
+};
+
+/** Compact record of one detected anomaly and the samples leading to it. */
+struct AnomalyEvent
+{
+    static const std::uint32_t ContextLength = 16;
+
+    std::uint64_t frameIndex;
+    /** Detection time on the steady_clock epoch, like TraceExporter::Now. [ns] */
+    std::uint64_t timestampNs;
+    std::uint32_t signal;
+    AnomalyKind kind;
+    float value;
+    float baseline;
+    /** Robust deviation of the baseline. */
+    float scale;
+    /** Robust z-score, CUSUM sum or autocorrelation, depending on the kind. */
+    float score;
+    /** Last samples of the signal, oldest first, ending with value. */
+    float context[ContextLength];
+    std::uint32_t contextCount;
+};
+
+/**
+ * Streaming stutter, regression and pacing detector with constant memory.
+ *
+ * Every signal keeps an EWMA baseline and an EWMA of the absolute residual as a
+ * robust deviation. Residuals are clipped before they update the baseline, so
+ * stutters barely move it. A sample is a stutter when its robust z-score is
+ * above the threshold. Clipped z-scores feed a two-sided CUSUM: a positive
+ * alarm is a regression, either alarm moves the baseline to the median of the
+ * last samples.
+ * A strongly negative lag-1 autocorrelation of the residuals with a large
+ * amplitude is reported as an oscillation.
+ *
+ * Add costs a few dozen arithmetic operations and never allocates. Events go
+ * to a fixed ring, the oldest undrained event is dropped when it is full.
+ * Not thread safe, feed it from one thread.
+ */
+class AnomalyDetector
+{
+public:
+    static const std::uint32_t MaxSignals = 8;
+    static const std::uint32_t EventCapacity = 64;
+
+    AnomalyDetector() { Reset(); }
+
+    /**
+     * Registers a signal, typically once at startup.
+     * @param name - signal name, must outlive the detector
+     * @return signal ID for Add, MaxSignals if all signals are taken
+     */
+    std::uint32_t AddSignal(const char* name, const AnomalySignalConfig& config = AnomalySignalConfig());
+
+    /**
+     * Feeds one sample of a signal. Signals may be sampled at different rates.
+     * @param signal - ID returned by AddSignal
+     * @param frameIndex - frame the sample belongs to, stored in events
+     * @param value - sample, for example a duration in milliseconds
+     * @return true if the sample raised an event
+     */
+    bool Add(std::uint32_t signal, std::uint64_t frameIndex, double value);
+
+    /**
+     * Moves detected events out of the ring, oldest first.
+     * @return number of events written to events
+     */
+    std::uint32_t Drain(AnomalyEvent* events, std::uint32_t maxCount);
+
+    /** Forgets baselines and events, keeps the registered signals. */
+    void Reset();
+
+    const char* GetSignalName(std::uint32_t signal) const;
+    static const char* GetKindName(AnomalyKind kind);
+    /** @return one line describing the event and its context, ending with a newline */
+    std::string FormatEvent(const AnomalyEvent& event) const;
+
+    std::uint64_t GetEventCount() const { return m_eventCount; }
+    std::uint64_t GetDroppedEventCount() const { return m_droppedEvents; }
+
+private:
+    struct Signal
+    {
+        const char* name;
+        AnomalySignalConfig config;
+        std::uint64_t sampleCount;
+        double baseline;
+        double deviation;
+        double cusumUp;
+        double cusumDown;
+        double previousResidual;
+        double residualEnergy;
+        double residualCovariance;
+        std::uint64_t quietUntil[(std::uint32_t)AnomalyKind::Count];
+        float history[AnomalyEvent::ContextLength];
+    };
+
+    bool RaiseEvent(Signal& signal, std::uint32_t signalId, AnomalyKind kind, std::uint64_t frameIndex,
+        double value, double scale, double score);
+
+    Signal m_signals[MaxSignals];
+    std::uint32_t m_signalCount = 0;
+
+    AnomalyEvent m_events[EventCapacity];
+    std::uint64_t m_eventWrite = 0;
+    std::uint64_t m_eventRead = 0;
+    std::uint64_t m_eventCount = 0;
+    std::uint64_t m_droppedEvents = 0;
+};
+}
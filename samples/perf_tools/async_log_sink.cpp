@@ -0,0 +1,488 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#include "async_log_sink.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#endif
+
+namespace
+{
+    std::uint64_t NowNs()
+    {
+        return (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /** Small sequential number of the calling thread, cheaper and shorter than the OS thread id. */
+    std::uint32_t GetThreadNumber()
+    {
+        static std::atomic<std::uint32_t> s_nextThread{1};
+        thread_local std::uint32_t t_thread = s_nextThread.fetch_add(1, std::memory_order_relaxed);
+        return t_thread;
+    }
+
+    const char* GetSourceName(PerfTools::LogSource source)
+    {
+        switch (source)
+        {
+        case PerfTools::LogSource::XeSS:
+            return "XeSS-SR Runtime";
+        case PerfTools::LogSource::XeSSFG:
+            return "XeSS-FG Runtime";
+        default:
+            return "XeLL Runtime";
+        }
+    }
+
+    /** The logging levels of all three libraries share the values. */
+    const char* GetLevelName(std::uint32_t level)
+    {
+        static const char* const names[] = {"debug", "info", "warning", "error"};
+        return level < 4 ? names[level] : "unknown";
+    }
+
+    /** FNV-1a of the source, the level and the text, identifies repeated messages. */
+    std::uint64_t HashMessage(PerfTools::LogSource source, std::uint32_t level, const char* text, std::size_t length)
+    {
+        std::uint64_t hash = 14695981039346656037ull;
+        hash = (hash ^ (std::uint64_t)source) * 1099511628211ull;
+        hash = (hash ^ level) * 1099511628211ull;
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            hash = (hash ^ (std::uint8_t)text[i]) * 1099511628211ull;
+        }
+        return hash;
+    }
+
+    /** Bits of RepeatEntry::window that count the messages of the window. */
+    const std::uint32_t WindowCountBits = 20;
+
+    std::uint64_t PackWindow(std::uint64_t startMs, std::uint64_t count)
+    {
+        return startMs << WindowCountBits | count;
+    }
+
+    void WriteDefault(const char* line)
+    {
+#if defined(_WIN32)
+        OutputDebugStringA(line);
+#else
+        std::fputs(line, stderr);
+#endif
+    }
+}
+
+namespace PerfTools
+{
+std::atomic<AsyncLogSink*> AsyncLogSink::s_instance{nullptr};
+
+AsyncLogSink::AsyncLogSink(std::uint32_t capacity)
+{
+    std::uint64_t size = 1;
+    while (size < capacity)
+    {
+        size <<= 1;
+    }
+    m_cells.reset(new Cell[size]);
+    m_mask = size - 1;
+    for (std::uint64_t i = 0; i < size; ++i)
+    {
+        m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    m_repeats.reset(new RepeatEntry[RepeatTableSize]);
+    m_repeatTexts.reset(new RepeatText[RepeatTableSize]());
+    m_startNs = NowNs();
+}
+
+AsyncLogSink::~AsyncLogSink()
+{
+    Stop();
+    AsyncLogSink* self = this;
+    s_instance.compare_exchange_strong(self, nullptr);
+}
+
+void AsyncLogSink::Start(WriteFunction write, std::uint32_t pollMs)
+{
+    Stop();
+    m_write = write ? write : WriteFunction(WriteDefault);
+    m_pollMs = pollMs > 0 ? pollMs : 1;
+    m_stopRequested = false;
+    m_accepting.store(true);
+    m_thread = std::thread(&AsyncLogSink::WorkerThread, this);
+}
+
+void AsyncLogSink::Stop()
+{
+    if (!m_thread.joinable())
+    {
+        return;
+    }
+    // Sequentially consistent with the producer count in Post: a producer either sees the sink stopped or is
+    // seen by the worker as in flight.
+    m_accepting.store(false);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopRequested = true;
+    }
+    m_condition.notify_all();
+    m_thread.join();
+}
+
+void AsyncLogSink::SetRateLimit(std::uint32_t maxRepeats, std::uint32_t windowMs)
+{
+    // The window counts up to maxRepeats + 1 in WindowCountBits.
+    m_maxRepeats.store(std::min(maxRepeats, (1u << WindowCountBits) - 2), std::memory_order_relaxed);
+    m_windowMs.store(windowMs > 0 ? windowMs : 1, std::memory_order_relaxed);
+}
+
+void AsyncLogSink::Post(LogSource source, std::uint32_t level, const char* message)
+{
+    m_posted.fetch_add(1, std::memory_order_relaxed);
+    m_producers.fetch_add(1);
+    if (!m_accepting.load() || message == nullptr)
+    {
+        m_producers.fetch_sub(1, std::memory_order_release);
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    std::size_t length = std::strlen(message);
+    // The libraries end some messages with a line break, the formatted line adds its own.
+    while (length > 0 && (message[length - 1] == '\n' || message[length - 1] == '\r'))
+    {
+        --length;
+    }
+    if (length > MaxMessageLength)
+    {
+        length = MaxMessageLength;
+        m_truncated.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    const std::uint64_t timestampNs = NowNs();
+    const std::uint64_t hash = HashMessage(source, level, message, length);
+    if (!CheckRepeat(hash, source, level, timestampNs))
+    {
+        m_suppressed.fetch_add(1, std::memory_order_relaxed);
+    }
+    else if (!Enqueue(timestampNs, hash, 0, source, level, message, length))
+    {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+    m_producers.fetch_sub(1, std::memory_order_release);
+}
+
+LogSinkStatistics AsyncLogSink::GetStatistics() const
+{
+    LogSinkStatistics statistics;
+    statistics.posted = m_posted.load(std::memory_order_relaxed);
+    statistics.written = m_written.load(std::memory_order_relaxed);
+    statistics.dropped = m_dropped.load(std::memory_order_relaxed);
+    statistics.suppressed = m_suppressed.load(std::memory_order_relaxed);
+    statistics.truncated = m_truncated.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+std::string AsyncLogSink::FormatReport() const
+{
+    const LogSinkStatistics statistics = GetStatistics();
+    char line[192];
+    std::snprintf(line, sizeof(line), "Log sink: posted %llu, written %llu, dropped %llu, suppressed %llu, truncated %llu\n",
+        (unsigned long long)statistics.posted, (unsigned long long)statistics.written,
+        (unsigned long long)statistics.dropped, (unsigned long long)statistics.suppressed,
+        (unsigned long long)statistics.truncated);
+    return line;
+}
+
+void AsyncLogSink::SetInstance(AsyncLogSink* sink)
+{
+    s_instance.store(sink, std::memory_order_release);
+}
+
+void AsyncLogSink::XessLogCallback(const char* message, xess_logging_level_t level)
+{
+    AsyncLogSink* sink = s_instance.load(std::memory_order_acquire);
+    if (sink != nullptr)
+    {
+        sink->Post(LogSource::XeSS, (std::uint32_t)level, message);
+    }
+}
+
+void AsyncLogSink::XefgLogCallback(const char* message, xefg_swapchain_logging_level_t level, void* userData)
+{
+    AsyncLogSink* sink = userData != nullptr ? (AsyncLogSink*)userData : s_instance.load(std::memory_order_acquire);
+    if (sink != nullptr)
+    {
+        sink->Post(LogSource::XeSSFG, (std::uint32_t)level, message);
+    }
+}
+
+void AsyncLogSink::XellLogCallback(const char* message, xell_logging_level_t level)
+{
+    AsyncLogSink* sink = s_instance.load(std::memory_order_acquire);
+    if (sink != nullptr)
+    {
+        sink->Post(LogSource::XeLL, (std::uint32_t)level, message);
+    }
+}
+
+bool AsyncLogSink::CheckRepeat(std::uint64_t hash, LogSource source, std::uint32_t level, std::uint64_t timestampNs)
+{
+    const std::uint32_t maxRepeats = m_maxRepeats.load(std::memory_order_relaxed);
+    if (maxRepeats == 0)
+    {
+        return true;
+    }
+    const std::uint64_t windowMs = m_windowMs.load(std::memory_order_relaxed);
+    const std::uint64_t nowMs = (timestampNs - m_startNs) / 1000000;
+    RepeatEntry& entry = m_repeats[hash & (RepeatTableSize - 1)];
+
+    std::uint64_t current = entry.hash.load(std::memory_order_acquire);
+    if (current != hash)
+    {
+        // Take the entry over from another message unless that one repeats in its current window, its pending
+        // count is reported first. Distinct messages thus never evict a repeating one, a message colliding with
+        // a repeating one is not limited.
+        const std::uint64_t window = entry.window.load(std::memory_order_relaxed);
+        const bool repeating = (window & ((1ull << WindowCountBits) - 1)) > 1;
+        if ((current != 0 && repeating && nowMs - (window >> WindowCountBits) < windowMs) ||
+            !entry.hash.compare_exchange_strong(current, hash, std::memory_order_acq_rel))
+        {
+            return true;
+        }
+        entry.window.store(PackWindow(nowMs, 0), std::memory_order_relaxed);
+        const std::uint64_t suppressed = entry.suppressed.exchange(0, std::memory_order_relaxed);
+        if (suppressed > 0)
+        {
+            PostSummary(current, suppressed, source, level, timestampNs);
+        }
+    }
+
+    std::uint64_t window = entry.window.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        const std::uint64_t startMs = window >> WindowCountBits;
+        const std::uint64_t count = window & ((1ull << WindowCountBits) - 1);
+        const bool expired = nowMs - startMs >= windowMs;
+        const std::uint64_t next = expired ? PackWindow(nowMs, 1) : PackWindow(startMs, std::min<std::uint64_t>(count + 1, maxRepeats + 1));
+        if (entry.window.compare_exchange_weak(window, next, std::memory_order_relaxed))
+        {
+            if (expired)
+            {
+                const std::uint64_t suppressed = entry.suppressed.exchange(0, std::memory_order_relaxed);
+                if (suppressed > 0)
+                {
+                    PostSummary(hash, suppressed, source, level, timestampNs);
+                }
+                return true;
+            }
+            if (count + 1 <= maxRepeats)
+            {
+                return true;
+            }
+            entry.suppressed.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    }
+}
+
+bool AsyncLogSink::Enqueue(std::uint64_t timestampNs, std::uint64_t hash, std::uint32_t repeats, LogSource source,
+    std::uint32_t level, const char* text, std::size_t length)
+{
+    std::uint64_t position = m_enqueuePosition.load(std::memory_order_relaxed);
+    Cell* cell = nullptr;
+    for (;;)
+    {
+        cell = &m_cells[position & m_mask];
+        const std::uint64_t sequence = cell->sequence.load(std::memory_order_acquire);
+        const std::int64_t difference = (std::int64_t)(sequence - position);
+        if (difference == 0)
+        {
+            if (m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (difference < 0)
+        {
+            // The background thread has not written the message a full ring ago yet.
+            return false;
+        }
+        else
+        {
+            position = m_enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    std::memcpy(cell->text, text, length);
+    cell->length = (std::uint16_t)length;
+    cell->timestampNs = timestampNs;
+    cell->hash = hash;
+    cell->repeats = repeats;
+    cell->threadId = GetThreadNumber();
+    cell->source = source;
+    cell->level = (std::uint8_t)level;
+    cell->sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+void AsyncLogSink::PostSummary(std::uint64_t hash, std::uint64_t repeats, LogSource source, std::uint32_t level,
+    std::uint64_t timestampNs)
+{
+    const std::uint32_t count = (std::uint32_t)std::min<std::uint64_t>(repeats, UINT32_MAX);
+    if (!Enqueue(timestampNs, hash, count, source, level, "", 0))
+    {
+        // Reported by a later summary instead.
+        m_repeats[hash & (RepeatTableSize - 1)].suppressed.fetch_add(repeats, std::memory_order_relaxed);
+    }
+}
+
+void AsyncLogSink::WorkerThread()
+{
+    for (;;)
+    {
+        while (WriteNext())
+        {
+        }
+        FlushRepeats(false);
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_stopRequested)
+        {
+            break;
+        }
+        // Producers never notify, the ring is polled.
+        m_condition.wait_for(lock, std::chrono::milliseconds(m_pollMs), [this] { return m_stopRequested; });
+    }
+
+    // Producers that passed the accepting check before Stop may still be writing their cell.
+    while (m_producers.load() != 0)
+    {
+        std::this_thread::yield();
+    }
+    while (m_dequeuePosition != m_enqueuePosition.load(std::memory_order_acquire))
+    {
+        if (!WriteNext())
+        {
+            std::this_thread::yield();
+        }
+    }
+    FlushRepeats(true);
+}
+
+bool AsyncLogSink::WriteNext()
+{
+    Cell& cell = m_cells[m_dequeuePosition & m_mask];
+    if (cell.sequence.load(std::memory_order_acquire) != m_dequeuePosition + 1)
+    {
+        return false;
+    }
+
+    if (cell.repeats > 0)
+    {
+        WriteSummary(cell.timestampNs, cell.threadId, cell.hash, cell.repeats, cell.source, cell.level);
+    }
+    else
+    {
+        // Only the message owning the entry of the repeat table can be summarized later. A takeover posts the
+        // summary of the previous owner before the message of the new one, so its text is still in place.
+        const std::uint32_t index = (std::uint32_t)(cell.hash & (RepeatTableSize - 1));
+        if (m_maxRepeats.load(std::memory_order_relaxed) > 0 &&
+            m_repeats[index].hash.load(std::memory_order_relaxed) == cell.hash)
+        {
+            RepeatText& repeatText = m_repeatTexts[index];
+            repeatText.hash = cell.hash;
+            repeatText.length = cell.length < SummaryTextLength ? cell.length : SummaryTextLength;
+            repeatText.source = cell.source;
+            repeatText.level = cell.level;
+            std::memcpy(repeatText.text, cell.text, repeatText.length);
+        }
+        WriteLine(cell.timestampNs, cell.threadId, cell.source, cell.level, cell.text, cell.length);
+        m_written.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    cell.sequence.store(m_dequeuePosition + m_mask + 1, std::memory_order_release);
+    ++m_dequeuePosition;
+    return true;
+}
+
+void AsyncLogSink::FlushRepeats(bool force)
+{
+    const std::uint64_t nowNs = NowNs();
+    const std::uint64_t nowMs = (nowNs - m_startNs) / 1000000;
+    const std::uint64_t windowMs = m_windowMs.load(std::memory_order_relaxed);
+    for (std::uint32_t i = 0; i < RepeatTableSize; ++i)
+    {
+        RepeatEntry& entry = m_repeats[i];
+        if (entry.suppressed.load(std::memory_order_relaxed) == 0)
+        {
+            continue;
+        }
+        const std::uint64_t startMs = entry.window.load(std::memory_order_relaxed) >> WindowCountBits;
+        if (!force && nowMs - startMs < windowMs)
+        {
+            continue;
+        }
+        const std::uint64_t hash = entry.hash.load(std::memory_order_acquire);
+        const std::uint64_t suppressed = entry.suppressed.exchange(0, std::memory_order_relaxed);
+        if (suppressed > 0)
+        {
+            WriteSummary(nowNs, 0, hash, suppressed, LogSource::XeSS, 0);
+        }
+    }
+}
+
+void AsyncLogSink::WriteSummary(std::uint64_t timestampNs, std::uint32_t threadId, std::uint64_t hash,
+    std::uint64_t repeats, LogSource source, std::uint32_t level)
+{
+    char summary[SummaryTextLength + 64];
+    int length = 0;
+    const RepeatText& repeatText = m_repeatTexts[hash & (RepeatTableSize - 1)];
+    if (repeatText.hash == hash && hash != 0)
+    {
+        length = std::snprintf(summary, sizeof(summary), "message repeated %llu more times: \"%.*s%s\"",
+            (unsigned long long)repeats, (int)repeatText.length, repeatText.text,
+            repeatText.length == SummaryTextLength ? "..." : "");
+        source = repeatText.source;
+        level = repeatText.level;
+    }
+    else
+    {
+        length = std::snprintf(summary, sizeof(summary), "message repeated %llu more times: hash %016llx",
+            (unsigned long long)repeats, (unsigned long long)hash);
+    }
+    WriteLine(timestampNs, threadId, source, level, summary, (std::size_t)std::max(length, 0));
+}
+
+void AsyncLogSink::WriteLine(std::uint64_t timestampNs, std::uint32_t threadId, LogSource source, std::uint32_t level,
+    const char* text, std::size_t length)
+{
+    // The prefix is short, so the text and the line break always fit.
+    std::snprintf(m_line, sizeof(m_line), "[%.3f][%s][%s][thread %u]: %.*s\n", (double)(timestampNs - m_startNs) * 1e-9,
+        GetSourceName(source), GetLevelName(level), threadId, (int)length, text);
+    m_write(m_line);
+}
+}
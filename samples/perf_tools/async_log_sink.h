@@ -0,0 +1,210 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "xell/xell.h"
+#include "xess/xess.h"
+#include "xess_fg/xefg_swapchain.h"
+
+namespace PerfTools
+{
+/** Library that logged a message. */
+enum class LogSource : std::uint8_t
+{
+    XeSS,
+    XeSSFG,
+    XeLL,
+};
+
+struct LogSinkStatistics
+{
+    std::uint64_t posted = 0;
+    std::uint64_t written = 0;
+    /** Messages lost because the ring was full or the sink was stopped. */
+    std::uint64_t dropped = 0;
+    /** Repeated messages not written because of the rate limit. */
+    std::uint64_t suppressed = 0;
+    /** Messages cut to MaxMessageLength. */
+    std::uint64_t truncated = 0;
+};
+
+/**
+ * Logging sink for the XeSS, XeSS-FG and XeLL logging callbacks that never
+ * blocks the calling thread on I/O.
+ *
+ * Post copies the message with a timestamp, the level and the calling thread
+ * into a preallocated ring shared by all producers, without locks or memory
+ * allocation. A full ring drops the message. A background thread formats the
+ * messages and writes them, by default to OutputDebugStringA on Windows and to
+ * stderr elsewhere.
+ *
+ * Repeated messages are rate limited before they take a cell of the ring:
+ * after maxRepeats identical messages within the window, further copies are
+ * only counted in a small fixed table indexed by the message hash. The count
+ * is reported in one summary line with the start of the message when the
+ * next window of that message starts, or by the background thread once the
+ * window ended. A message that repeats within its window keeps its entry,
+ * other messages that map to the same entry are not limited meanwhile.
+ *
+ * The logging callbacks of XeSS and XeLL carry no user data, they post to the
+ * sink set by SetInstance. The XeSS-FG callback uses its user data, or the
+ * instance if it is null.
+ */
+class AsyncLogSink
+{
+public:
+    using WriteFunction = std::function<void(const char* line)>;
+
+    /** Longest stored message, longer ones are truncated. [bytes] */
+    static const std::uint32_t MaxMessageLength = 464;
+    /** Entries of the repeat table, a power of two. */
+    static const std::uint32_t RepeatTableSize = 256;
+    /** Longest start of a message quoted in a repeat summary. [bytes] */
+    static const std::uint32_t SummaryTextLength = 64;
+
+    /** @param capacity - messages the ring holds, rounded up to a power of two */
+    explicit AsyncLogSink(std::uint32_t capacity = 1024);
+    ~AsyncLogSink();
+
+    AsyncLogSink(const AsyncLogSink&) = delete;
+    AsyncLogSink& operator=(const AsyncLogSink&) = delete;
+
+    /**
+     * Starts the background thread.
+     * @param write - receives every formatted line, null for the default output
+     * @param pollMs - interval at which the background thread checks for messages when idle
+     */
+    void Start(WriteFunction write = nullptr, std::uint32_t pollMs = 5);
+
+    /** Writes all messages posted before the call and stops the background thread. */
+    void Stop();
+
+    /**
+     * @param maxRepeats - identical messages written per window, 0 disables the limit
+     * @param windowMs - length of the window
+     */
+    void SetRateLimit(std::uint32_t maxRepeats, std::uint32_t windowMs);
+
+    /** Copies the message into the ring, any thread, never blocks. */
+    void Post(LogSource source, std::uint32_t level, const char* message);
+
+    LogSinkStatistics GetStatistics() const;
+    std::string FormatReport() const;
+
+    /** Sets the sink used by the callbacks without user data, null to discard their messages. */
+    static void SetInstance(AsyncLogSink* sink);
+
+    /** xess_app_log_callback_t for xessSetLoggingCallback. */
+    static void XessLogCallback(const char* message, xess_logging_level_t level);
+    /** xefg_swapchain_app_log_callback_t for xefgSwapChainSetLoggingCallback, pass the sink as user data. */
+    static void XefgLogCallback(const char* message, xefg_swapchain_logging_level_t level, void* userData);
+    /** xell_app_log_callback_t for xellSetLoggingCallback. */
+    static void XellLogCallback(const char* message, xell_logging_level_t level);
+
+private:
+    struct alignas(64) Cell
+    {
+        // Vyukov bounded queue: equal to the position when free, position + 1 once written.
+        std::atomic<std::uint64_t> sequence;
+        std::uint64_t timestampNs;
+        std::uint64_t hash;
+        /** Non-zero for a summary of suppressed copies of the message with the hash, text is empty. */
+        std::uint32_t repeats;
+        std::uint32_t threadId;
+        std::uint16_t length;
+        LogSource source;
+        std::uint8_t level;
+        char text[MaxMessageLength];
+    };
+
+    struct alignas(64) RepeatEntry
+    {
+        std::atomic<std::uint64_t> hash{0};
+        // Window start in milliseconds since the sink was created << 20 | messages in the window.
+        std::atomic<std::uint64_t> window{0};
+        std::atomic<std::uint64_t> suppressed{0};
+    };
+
+    /** Start of the last written message owning a repeat table entry, to name it in summaries. */
+    struct RepeatText
+    {
+        std::uint64_t hash;
+        std::uint32_t length;
+        LogSource source;
+        std::uint8_t level;
+        char text[SummaryTextLength];
+    };
+
+    /** Longest formatted line including the prefix and the line break. [bytes] */
+    static const std::uint32_t MaxLineLength = MaxMessageLength + 128;
+
+    /** @return false if the message is suppressed */
+    bool CheckRepeat(std::uint64_t hash, LogSource source, std::uint32_t level, std::uint64_t timestampNs);
+    /** @return false if the ring is full */
+    bool Enqueue(std::uint64_t timestampNs, std::uint64_t hash, std::uint32_t repeats, LogSource source,
+        std::uint32_t level, const char* text, std::size_t length);
+    void PostSummary(std::uint64_t hash, std::uint64_t repeats, LogSource source, std::uint32_t level,
+        std::uint64_t timestampNs);
+    void WorkerThread();
+    /** @return false if the ring is empty */
+    bool WriteNext();
+    /** Writes the summaries of windows that ended, of all windows if force is set. */
+    void FlushRepeats(bool force);
+    void WriteSummary(std::uint64_t timestampNs, std::uint32_t threadId, std::uint64_t hash, std::uint64_t repeats,
+        LogSource source, std::uint32_t level);
+    void WriteLine(std::uint64_t timestampNs, std::uint32_t threadId, LogSource source, std::uint32_t level,
+        const char* text, std::size_t length);
+
+    std::unique_ptr<Cell[]> m_cells;
+    std::uint64_t m_mask;
+    std::uint64_t m_startNs;
+
+    alignas(64) std::atomic<std::uint64_t> m_enqueuePosition{0};
+    alignas(64) std::atomic<bool> m_accepting{false};
+    // Producers between the accepting check and their sequence store, Stop waits for them.
+    std::atomic<std::uint32_t> m_producers{0};
+    std::atomic<std::uint64_t> m_posted{0};
+    std::atomic<std::uint64_t> m_dropped{0};
+    std::atomic<std::uint64_t> m_truncated{0};
+    std::atomic<std::uint64_t> m_suppressed{0};
+    std::atomic<std::uint32_t> m_maxRepeats{5};
+    std::atomic<std::uint32_t> m_windowMs{1000};
+    std::unique_ptr<RepeatEntry[]> m_repeats;
+
+    // Background thread only, while it runs.
+    alignas(64) std::uint64_t m_dequeuePosition = 0;
+    WriteFunction m_write;
+    std::unique_ptr<RepeatText[]> m_repeatTexts;
+    char m_line[MaxLineLength];
+    std::atomic<std::uint64_t> m_written{0};
+
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::thread m_thread;
+    std::uint32_t m_pollMs = 5;
+    bool m_stopRequested = false;
+
+    static std::atomic<AsyncLogSink*> s_instance;
+};
+}
@@ -0,0 +1,229 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+// Statistical A/B comparison of per-frame times for regression gating.
+// Accepts vks::Benchmark result files written with --benchframetimes, binary
+// profiling logs and their CSV conversion. Lower values are better for every
+// metric. Exits with 2 if any metric regressed significantly beyond the
+// threshold, 1 on input errors.
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "command_line.h"
+#include "profiling_aggregator.h"
+#include "profiling_log.h"
+#include "sample_statistics.h"
+
+using namespace PerfTools;
+
+namespace
+{
+    typedef std::map<std::string, std::vector<double>> MetricSamples;
+
+    void PrintUsage()
+    {
+        std::printf("Usage: benchmark_compare -baseline <file> -candidate <file> [-threshold <percent>] [-alpha <value>]\n"
+                    "                         [-resamples <count>] [-metric <name>]\n");
+    }
+
+    bool LoadProfilingLog(const std::string& path, MetricSamples& samples)
+    {
+        ProfilingLogReader reader;
+        if (!reader.Open(path))
+        {
+            return false;
+        }
+
+        ProfilingLogFrame frame;
+        while (reader.ReadFrame(frame))
+        {
+            std::uint64_t total = 0;
+            for (const ProfilingLogRecord& record : frame.records)
+            {
+                samples[reader.GetNames().GetName(record.passId)].push_back((double)record.durationNs * 1e-6);
+                total += record.durationNs;
+            }
+            samples[ProfilingAggregator::ExecutionTotalName].push_back((double)total * 1e-6);
+        }
+        return true;
+    }
+
+    bool LoadText(const std::string& path, MetricSamples& samples)
+    {
+        std::ifstream file(path);
+        if (!file.is_open())
+        {
+            return false;
+        }
+
+        enum class Section { None, BenchmarkFrames, ProfilingRows } section = Section::None;
+        std::string line;
+        std::string currentFrame;
+        double currentTotal = 0.0;
+        while (std::getline(file, line))
+        {
+            if (!line.empty() && line.back() == '\r')
+            {
+                line.pop_back();
+            }
+
+            if (line == "frame,ms")
+            {
+                section = Section::BenchmarkFrames;
+                continue;
+            }
+            if (line == "frame_index,timestamp_ms,pass,duration_ms")
+            {
+                section = Section::ProfilingRows;
+                continue;
+            }
+
+            if (section == Section::BenchmarkFrames)
+            {
+                const std::size_t comma = line.find(',');
+                if (comma != std::string::npos)
+                {
+                    samples["frame_time"].push_back(std::strtod(line.c_str() + comma + 1, nullptr));
+                }
+            }
+            else if (section == Section::ProfilingRows)
+            {
+                std::stringstream row(line);
+                std::string frame, timestamp, pass, duration;
+                if (std::getline(row, frame, ',') && std::getline(row, timestamp, ',') &&
+                    std::getline(row, pass, ',') && std::getline(row, duration, ','))
+                {
+                    if (frame != currentFrame && !currentFrame.empty())
+                    {
+                        samples[ProfilingAggregator::ExecutionTotalName].push_back(currentTotal);
+                        currentTotal = 0.0;
+                    }
+                    currentFrame = frame;
+                    const double value = std::strtod(duration.c_str(), nullptr);
+                    samples[pass].push_back(value);
+                    currentTotal += value;
+                }
+            }
+        }
+        if (!currentFrame.empty())
+        {
+            samples[ProfilingAggregator::ExecutionTotalName].push_back(currentTotal);
+        }
+        return section != Section::None;
+    }
+
+    bool Load(const std::string& path, MetricSamples& samples)
+    {
+        if (LoadProfilingLog(path, samples) || LoadText(path, samples))
+        {
+            return true;
+        }
+        std::fprintf(stderr, "'%s' is missing or holds no per-frame times, benchmark results need --benchframetimes.\n", path.c_str());
+        return false;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    CommandLine args(argc, argv);
+    const std::string baselinePath = args.GetString("-baseline", "");
+    const std::string candidatePath = args.GetString("-candidate", "");
+    if (args.IsSet("-help") || baselinePath.empty() || candidatePath.empty())
+    {
+        PrintUsage();
+        return args.IsSet("-help") ? 0 : 1;
+    }
+
+    const double threshold = args.GetDouble("-threshold", 2.0) / 100.0;
+    const double alpha = args.GetDouble("-alpha", 0.05);
+    if (alpha <= 0.0 || alpha >= 1.0)
+    {
+        PrintUsage();
+        return 1;
+    }
+    const std::uint32_t resamples = (std::uint32_t)args.GetInt("-resamples", 2000);
+    const std::string onlyMetric = args.GetString("-metric", "");
+
+    MetricSamples baseline;
+    MetricSamples candidate;
+    if (!Load(baselinePath, baseline) || !Load(candidatePath, candidate))
+    {
+        return 1;
+    }
+
+    std::printf("Regression: median slower by more than %.2f%% with p < %.3f, %u bootstrap resamples\n",
+        threshold * 100.0, alpha, resamples);
+    // The interval is reported at the confidence level matching the significance level of the test.
+    const double confidence = 1.0 - alpha;
+    char intervalHeader[32];
+    std::snprintf(intervalHeader, sizeof(intervalHeader), "%g%% interval", confidence * 100.0);
+    std::printf("%-32s %8s %8s %10s %10s %9s %21s %9s  %s\n",
+        "metric", "n base", "n cand", "base ms", "cand ms", "delta", intervalHeader, "p", "verdict");
+
+    std::uint32_t compared = 0;
+    std::uint32_t regressions = 0;
+    for (const auto& entry : baseline)
+    {
+        const auto other = candidate.find(entry.first);
+        if (other == candidate.end() || (!onlyMetric.empty() && entry.first != onlyMetric))
+        {
+            continue;
+        }
+
+        const std::vector<double>& a = entry.second;
+        const std::vector<double>& b = other->second;
+        const MannWhitneyResult test = MannWhitneyU(a, b);
+        const MedianDelta delta = BootstrapMedianDelta(a, b, resamples, confidence);
+
+        std::vector<double> scratch(a);
+        const double medianBaseline = Median(scratch);
+        scratch = b;
+        const double medianCandidate = Median(scratch);
+
+        const bool significant = test.pValue < alpha;
+        const char* verdict = "no change";
+        if (significant && delta.delta > threshold && delta.low > 0.0)
+        {
+            verdict = "REGRESSION";
+            regressions++;
+        }
+        else if (significant && delta.delta < -threshold && delta.high < 0.0)
+        {
+            verdict = "improvement";
+        }
+        else if (significant)
+        {
+            verdict = "within threshold";
+        }
+
+        char interval[32];
+        std::snprintf(interval, sizeof(interval), "[%+.2f%%, %+.2f%%]", delta.low * 100.0, delta.high * 100.0);
+        std::printf("%-32s %8zu %8zu %10.4f %10.4f %+8.2f%% %21s %9.2g  %s\n", entry.first.c_str(), a.size(), b.size(),
+            medianBaseline, medianCandidate, delta.delta * 100.0, interval, test.pValue, verdict);
+        compared++;
+    }
+
+    if (compared == 0)
+    {
+        std::fprintf(stderr, "No common metrics\n");
+        return 1;
+    }
+    return regressions != 0 ? 2 : 0;
+}
@@ -0,0 +1,69 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace PerfTools
+{
+/** Minimal "-option value" parser shared by the command line tools. */
+class CommandLine
+{
+public:
+    CommandLine(int argc, char* argv[]) : m_argc(argc), m_argv(argv) {}
+
+    bool IsSet(const char* option) const
+    {
+        return Find(option) != 0;
+    }
+
+    std::string GetString(const char* option, const std::string& defaultValue) const
+    {
+        int index = Find(option);
+        return (index != 0 && index + 1 < m_argc) ? std::string(m_argv[index + 1]) : defaultValue;
+    }
+
+    long long GetInt(const char* option, long long defaultValue) const
+    {
+        int index = Find(option);
+        // Base 0 accepts hexadecimal masks such as 0x23
+        return (index != 0 && index + 1 < m_argc) ? std::strtoll(m_argv[index + 1], nullptr, 0) : defaultValue;
+    }
+
+    double GetDouble(const char* option, double defaultValue) const
+    {
+        int index = Find(option);
+        return (index != 0 && index + 1 < m_argc) ? std::strtod(m_argv[index + 1], nullptr) : defaultValue;
+    }
+
+private:
+    int Find(const char* option) const
+    {
+        for (int i = 1; i < m_argc; ++i)
+        {
+            if (std::strcmp(m_argv[i], option) == 0)
+            {
+                return i;
+            }
+        }
+        return 0;
+    }
+
+    int m_argc;
+    char** m_argv;
+};
+}
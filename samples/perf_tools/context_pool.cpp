@@ -0,0 +1,132 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#include "context_pool.h"
+
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+namespace PerfTools
+{
+ContextPool::ContextPool(ContextPoolBackend& backend, std::uint64_t budgetBytes)
+    : m_backend(backend), m_budgetBytes(budgetBytes)
+{
+}
+
+ContextPool::~ContextPool()
+{
+    Clear();
+}
+
+xess_context_handle_t ContextPool::Acquire(const ContextPoolKey& key, bool* hit)
+{
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+    {
+        if (it->key == key)
+        {
+            m_entries.splice(m_entries.begin(), m_entries, it);
+            m_statistics.hits++;
+            if (hit != nullptr)
+            {
+                *hit = true;
+            }
+            return m_entries.front().context;
+        }
+    }
+
+    if (hit != nullptr)
+    {
+        *hit = false;
+    }
+    m_statistics.misses++;
+
+    xess_properties_t properties = {};
+    const auto start = std::chrono::steady_clock::now();
+    xess_context_handle_t context = m_backend.Create(key, properties);
+    m_statistics.createMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    if (context == nullptr)
+    {
+        m_statistics.failures++;
+        return nullptr;
+    }
+
+    const std::uint64_t bytes = GetMemoryBytes(properties);
+    m_entries.push_front({key, context, bytes});
+    m_statistics.residentBytes += bytes;
+    if (m_statistics.residentBytes > m_statistics.peakResidentBytes)
+    {
+        m_statistics.peakResidentBytes = m_statistics.residentBytes;
+    }
+    Evict();
+    return context;
+}
+
+void ContextPool::Clear()
+{
+    for (const Entry& entry : m_entries)
+    {
+        m_backend.Destroy(entry.context);
+    }
+    m_entries.clear();
+    m_statistics.residentBytes = 0;
+}
+
+void ContextPool::SetBudget(std::uint64_t budgetBytes)
+{
+    m_budgetBytes = budgetBytes;
+    Evict();
+}
+
+xess_context_handle_t ContextPool::GetCurrent() const
+{
+    return m_entries.empty() ? nullptr : m_entries.front().context;
+}
+
+std::uint64_t ContextPool::GetMemoryBytes(const xess_properties_t& properties)
+{
+    return properties.tempBufferHeapSize + properties.tempTextureHeapSize;
+}
+
+std::string ContextPool::FormatReport() const
+{
+    std::ostringstream report;
+    report << std::fixed << std::setprecision(1);
+    report << "XeSS context pool: " << m_entries.size() << " contexts, " << m_statistics.residentBytes / double(1 << 20)
+           << " of " << m_budgetBytes / double(1 << 20) << " MiB, peak " << m_statistics.peakResidentBytes / double(1 << 20)
+           << " MiB\n";
+    for (const Entry& entry : m_entries)
+    {
+        report << "  " << entry.key.outputResolution.x << "x" << entry.key.outputResolution.y << " quality "
+               << entry.key.quality << " flags 0x" << std::hex << entry.key.initFlags << std::dec << ": "
+               << entry.bytes / double(1 << 20) << " MiB\n";
+    }
+    report << "  hits " << m_statistics.hits << ", misses " << m_statistics.misses << ", evictions "
+           << m_statistics.evictions << ", failures " << m_statistics.failures << ", create " << m_statistics.createMs
+           << " ms\n";
+    return report.str();
+}
+
+void ContextPool::Evict()
+{
+    while (m_entries.size() > 1 && m_statistics.residentBytes > m_budgetBytes)
+    {
+        const Entry& entry = m_entries.back();
+        m_backend.Destroy(entry.context);
+        m_statistics.residentBytes -= entry.bytes;
+        m_statistics.evictions++;
+        m_entries.pop_back();
+    }
+}
+}
@@ -0,0 +1,138 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <string>
+
+#include "xess/xess.h"
+
+namespace PerfTools
+{
+/** Parameters that need a new xess*Init when they change. */
+struct ContextPoolKey
+{
+    xess_2d_t outputResolution = {0, 0};
+    xess_quality_settings_t quality = XESS_QUALITY_SETTING_BALANCED;
+    std::uint32_t initFlags = 0;
+
+    bool operator==(const ContextPoolKey& other) const
+    {
+        return outputResolution.x == other.outputResolution.x && outputResolution.y == other.outputResolution.y &&
+               quality == other.quality && initFlags == other.initFlags;
+    }
+};
+
+/** Creates the contexts of a pool, for example with xessD3D12CreateContext and xessD3D12Init. */
+class ContextPoolBackend
+{
+public:
+    virtual ~ContextPoolBackend() = default;
+
+    /**
+     * Creates a context and initializes it for the key, blocking.
+     * @param properties - receives the properties of the initialized context
+     * @return the context, or nullptr on failure
+     */
+    virtual xess_context_handle_t Create(const ContextPoolKey& key, xess_properties_t& properties) = 0;
+
+    /** Destroys a context without pending GPU work. */
+    virtual void Destroy(xess_context_handle_t context) = 0;
+};
+
+struct ContextPoolStatistics
+{
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::uint64_t evictions = 0;
+    std::uint64_t failures = 0;
+    /** Memory charged for the pooled contexts. [bytes] */
+    std::uint64_t residentBytes = 0;
+    std::uint64_t peakResidentBytes = 0;
+    /** Time spent in ContextPoolBackend::Create, i.e. the hitches of the misses. [ms] */
+    double createMs = 0.0;
+};
+
+/**
+ * LRU pool of initialized XeSS contexts keyed by their init parameters.
+ *
+ * Switching back to a configuration that is still pooled returns its context
+ * without a blocking xess*Init. Every context is charged with the temporary
+ * buffer and texture heap sizes from xess_properties_t, the least recently
+ * used contexts are destroyed while the pool exceeds its budget. The current
+ * context is never evicted, even if it alone exceeds the budget. As eviction
+ * happens after the new context is created, the memory in use during a miss
+ * can exceed the budget by that context.
+ *
+ * Contexts are destroyed right away, the caller must ensure that only the
+ * current context may have GPU work pending when calling Acquire, for example
+ * by waiting for the GPU before a switch as the samples do. Not thread safe.
+ */
+class ContextPool
+{
+public:
+    /** @param budgetBytes - memory the pooled contexts may use, 0 keeps only the current context */
+    ContextPool(ContextPoolBackend& backend, std::uint64_t budgetBytes);
+    ~ContextPool();
+
+    ContextPool(const ContextPool&) = delete;
+    ContextPool& operator=(const ContextPool&) = delete;
+
+    /**
+     * Makes the context of the key the current one, created and initialized on a miss.
+     * @param hit - optional, receives whether the context was pooled
+     * @return the context, or nullptr if the backend failed, the current context is kept in that case
+     */
+    xess_context_handle_t Acquire(const ContextPoolKey& key, bool* hit = nullptr);
+
+    /** Destroys all contexts, including the current one. */
+    void Clear();
+
+    /** Changes the budget and evicts contexts beyond it. */
+    void SetBudget(std::uint64_t budgetBytes);
+
+    std::uint64_t GetBudget() const { return m_budgetBytes; }
+    std::size_t GetSize() const { return m_entries.size(); }
+
+    /** @return context returned by the last successful Acquire, nullptr if none */
+    xess_context_handle_t GetCurrent() const;
+
+    const ContextPoolStatistics& GetStatistics() const { return m_statistics; }
+
+    /** @return memory charged for a context with the given properties */
+    static std::uint64_t GetMemoryBytes(const xess_properties_t& properties);
+
+    /** @return pooled configurations, most recently used first, and the statistics */
+    std::string FormatReport() const;
+
+private:
+    struct Entry
+    {
+        ContextPoolKey key;
+        xess_context_handle_t context;
+        std::uint64_t bytes;
+    };
+
+    void Evict();
+
+    ContextPoolBackend& m_backend;
+    std::uint64_t m_budgetBytes;
+    // Most recently used first, the front entry is the current context.
+    std::list<Entry> m_entries;
+    ContextPoolStatistics m_statistics;
+};
+}
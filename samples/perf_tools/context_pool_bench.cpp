@@ -0,0 +1,231 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+// Stand-in backend for the XeSS context pool. Replays configuration switches,
+// such as the 1920x1080 / 2560x1440 toggle on F3 of the frame generation sample,
+// once without pooling and once with the pool, against contexts whose init
+// blocks like xess*Init. Exits with 1 if the pool leaks or double destroys
+// contexts or exceeds its budget by more than the current context.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <set>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "command_line.h"
+#include "context_pool.h"
+
+using namespace PerfTools;
+
+namespace
+{
+    void PrintUsage()
+    {
+        std::printf("Usage: context_pool_bench [-configs <WxH,...>] [-qualities <xess_quality_settings_t,...>]\n"
+            "    [-switches <count>] [-pattern toggle|random] [-seed <value>] [-budget <MB>]\n"
+            "    [-init_ms <ms>] [-init_ms_per_mp <ms>] [-bytes_per_pixel <bytes>]\n");
+    }
+
+    /** Simulates xess*CreateContext and xess*Init, the init latency and heap sizes scale with the output size. */
+    class SimulatedBackend : public ContextPoolBackend
+    {
+    public:
+        SimulatedBackend(double initMs, double initMsPerMegapixel, double bytesPerPixel)
+            : m_initMs(initMs), m_initMsPerMegapixel(initMsPerMegapixel), m_bytesPerPixel(bytesPerPixel)
+        {
+        }
+
+        xess_context_handle_t Create(const ContextPoolKey& key, xess_properties_t& properties) override
+        {
+            const double pixels = double(key.outputResolution.x) * key.outputResolution.y;
+            std::this_thread::sleep_for(
+                std::chrono::duration<double, std::milli>(m_initMs + m_initMsPerMegapixel * pixels * 1e-6));
+
+            properties = {};
+            // Roughly the split of the real heaps, buffers hold the network activations.
+            properties.tempBufferHeapSize = std::uint64_t(pixels * m_bytesPerPixel * 0.75);
+            properties.tempTextureHeapSize = std::uint64_t(pixels * m_bytesPerPixel * 0.25);
+
+            // Never dereferenced, only the identity of the handle matters.
+            xess_context_handle_t context = reinterpret_cast<xess_context_handle_t>(std::uintptr_t(++m_lastId));
+            m_live.insert(context);
+            return context;
+        }
+
+        void Destroy(xess_context_handle_t context) override
+        {
+            if (m_live.erase(context) == 0)
+            {
+                m_invalidDestroys++;
+            }
+        }
+
+        std::size_t GetLiveCount() const { return m_live.size(); }
+        std::uint64_t GetInvalidDestroys() const { return m_invalidDestroys; }
+
+    private:
+        double m_initMs;
+        double m_initMsPerMegapixel;
+        double m_bytesPerPixel;
+        std::uint64_t m_lastId = 0;
+        std::set<xess_context_handle_t> m_live;
+        std::uint64_t m_invalidDestroys = 0;
+    };
+
+    std::vector<std::string> Split(const std::string& list)
+    {
+        std::vector<std::string> items;
+        std::stringstream stream(list);
+        std::string item;
+        while (std::getline(stream, item, ','))
+        {
+            if (!item.empty())
+            {
+                items.push_back(item);
+            }
+        }
+        return items;
+    }
+
+    bool ParseConfigs(const std::string& resolutions, const std::string& qualities, std::vector<ContextPoolKey>& keys)
+    {
+        for (const std::string& resolution : Split(resolutions))
+        {
+            unsigned int width = 0;
+            unsigned int height = 0;
+            if (std::sscanf(resolution.c_str(), "%ux%u", &width, &height) != 2 || width == 0 || height == 0)
+            {
+                return false;
+            }
+            for (const std::string& quality : Split(qualities))
+            {
+                ContextPoolKey key;
+                key.outputResolution = {width, height};
+                key.quality = xess_quality_settings_t(std::strtol(quality.c_str(), nullptr, 0));
+                keys.push_back(key);
+            }
+        }
+        return !keys.empty();
+    }
+
+    struct RunResult
+    {
+        std::vector<double> switchMs;
+        ContextPoolStatistics statistics;
+        std::uint64_t largestContextBytes = 0;
+        bool valid = true;
+    };
+
+    RunResult Run(const std::vector<std::size_t>& sequence, const std::vector<ContextPoolKey>& keys,
+        std::uint64_t budgetBytes, double initMs, double initMsPerMegapixel, double bytesPerPixel)
+    {
+        RunResult result;
+        SimulatedBackend backend(initMs, initMsPerMegapixel, bytesPerPixel);
+        {
+            ContextPool pool(backend, budgetBytes);
+            for (std::size_t index : sequence)
+            {
+                const auto start = std::chrono::steady_clock::now();
+                xess_context_handle_t context = pool.Acquire(keys[index]);
+                result.switchMs.push_back(
+                    std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+                if (context == nullptr || pool.GetCurrent() != context || backend.GetLiveCount() != pool.GetSize())
+                {
+                    result.valid = false;
+                }
+            }
+            for (const ContextPoolKey& key : keys)
+            {
+                const double pixels = double(key.outputResolution.x) * key.outputResolution.y;
+                result.largestContextBytes = std::max(result.largestContextBytes, std::uint64_t(pixels * bytesPerPixel));
+            }
+            result.statistics = pool.GetStatistics();
+            std::printf("%s", pool.FormatReport().c_str());
+        }
+        if (backend.GetLiveCount() != 0 || backend.GetInvalidDestroys() != 0)
+        {
+            std::fprintf(stderr, "%zu contexts leaked, %llu invalid destroys\n", backend.GetLiveCount(),
+                (unsigned long long)backend.GetInvalidDestroys());
+            result.valid = false;
+        }
+        // The current context may exceed the budget alone, and the new context is charged before the eviction.
+        if (result.statistics.peakResidentBytes > std::max(budgetBytes, result.largestContextBytes) + result.largestContextBytes)
+        {
+            std::fprintf(stderr, "Peak of %llu bytes exceeds the budget\n",
+                (unsigned long long)result.statistics.peakResidentBytes);
+            result.valid = false;
+        }
+        return result;
+    }
+
+    void PrintRun(const char* name, RunResult result)
+    {
+        std::vector<double>& ms = result.switchMs;
+        std::sort(ms.begin(), ms.end());
+        double sum = 0.0;
+        for (double value : ms)
+        {
+            sum += value;
+        }
+        const std::size_t p99 = std::min(ms.size() - 1, std::size_t(ms.size() * 0.99));
+        std::printf("%-10s %8zu %6llu %6llu %9llu %10.3f %10.3f %10.3f %10.1f\n", name, ms.size(),
+            (unsigned long long)result.statistics.hits, (unsigned long long)result.statistics.misses,
+            (unsigned long long)result.statistics.evictions, sum / ms.size(), ms[p99], ms.back(),
+            result.statistics.peakResidentBytes / double(1 << 20));
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    CommandLine args(argc, argv);
+    if (args.IsSet("-help"))
+    {
+        PrintUsage();
+        return 0;
+    }
+
+    std::vector<ContextPoolKey> keys;
+    if (!ParseConfigs(args.GetString("-configs", "1920x1080,2560x1440"), args.GetString("-qualities", "102"), keys))
+    {
+        PrintUsage();
+        return 1;
+    }
+    const long long switches = std::max(args.GetInt("-switches", 20), 1ll);
+    const bool random = args.GetString("-pattern", "toggle") == "random";
+    const std::uint64_t budgetBytes = std::uint64_t(args.GetDouble("-budget", 512.0) * (1 << 20));
+    const double initMs = args.GetDouble("-init_ms", 40.0);
+    const double initMsPerMegapixel = args.GetDouble("-init_ms_per_mp", 20.0);
+    const double bytesPerPixel = args.GetDouble("-bytes_per_pixel", 64.0);
+
+    std::vector<std::size_t> sequence;
+    std::mt19937_64 generator(std::uint64_t(args.GetInt("-seed", 1)));
+    for (long long i = 0; i < switches; i++)
+    {
+        sequence.push_back(random ? std::size_t(generator() % keys.size()) : std::size_t(i) % keys.size());
+    }
+
+    const RunResult unpooled = Run(sequence, keys, 0, initMs, initMsPerMegapixel, bytesPerPixel);
+    const RunResult pooled = Run(sequence, keys, budgetBytes, initMs, initMsPerMegapixel, bytesPerPixel);
+
+    std::printf("%-10s %8s %6s %6s %9s %10s %10s %10s %10s\n", "run", "switches", "hits", "misses", "evictions",
+        "mean [ms]", "p99 [ms]", "max [ms]", "peak [MiB]");
+    PrintRun("unpooled", unpooled);
+    PrintRun("pooled", pooled);
+    return unpooled.valid && pooled.valid ? 0 : 1;
+}
@@ -0,0 +1,246 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#include "context_swap.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+namespace PerfTools
+{
+ContextSwapManager::ContextSwapManager(ContextPoolBackend& backend) : m_backend(backend)
+{
+}
+
+ContextSwapManager::~ContextSwapManager()
+{
+    Stop();
+}
+
+bool ContextSwapManager::Start(const ContextPoolKey& key)
+{
+    Stop();
+
+    xess_properties_t properties = {};
+    xess_context_handle_t context = m_backend.Create(key, properties);
+    if (context == nullptr)
+    {
+        return false;
+    }
+
+    m_current = SwapFrame();
+    m_current.context = context;
+    m_current.key = key;
+    m_retired.clear();
+
+    m_statistics = ContextSwapStatistics();
+    m_target = key;
+    m_currentKey = key;
+    m_buildRequested = false;
+    m_stopRequested = false;
+    m_thread = std::thread(&ContextSwapManager::WorkerThread, this);
+    return true;
+}
+
+void ContextSwapManager::Stop()
+{
+    if (m_thread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stopRequested = true;
+        }
+        m_condition.notify_all();
+        m_thread.join();
+    }
+
+    // The worker is gone, everything left is destroyed here.
+    std::vector<xess_context_handle_t> contexts;
+    contexts.swap(m_destroyQueue);
+    if (m_ready != nullptr)
+    {
+        contexts.push_back(m_ready);
+        m_ready = nullptr;
+    }
+    for (const RetiredContext& retired : m_retired)
+    {
+        contexts.push_back(retired.context);
+    }
+    m_retired.clear();
+    if (m_current.context != nullptr)
+    {
+        contexts.push_back(m_current.context);
+        m_current.context = nullptr;
+    }
+    for (xess_context_handle_t context : contexts)
+    {
+        m_backend.Destroy(context);
+    }
+    m_statistics.destroyed += contexts.size();
+}
+
+void ContextSwapManager::Request(const ContextPoolKey& key)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_statistics.requests++;
+        if (key == m_target)
+        {
+            return;
+        }
+        m_target = key;
+
+        // A built context that is not swapped in yet is outdated now.
+        if (m_ready != nullptr && !(m_readyKey == key))
+        {
+            m_destroyQueue.push_back(m_ready);
+            m_ready = nullptr;
+            m_statistics.superseded++;
+        }
+
+        // Back to the current configuration, or to one that is ready or being built: nothing new to build.
+        const bool covered = (key == m_currentKey) || (m_ready != nullptr) || (m_building && m_buildingKey == key);
+        m_buildRequested = !covered;
+    }
+    m_condition.notify_all();
+}
+
+SwapFrame ContextSwapManager::BeginFrame(std::uint64_t frameIndex, std::uint64_t completedFenceValue)
+{
+    std::vector<xess_context_handle_t> finished;
+    for (auto it = m_retired.begin(); it != m_retired.end();)
+    {
+        if (it->lastFrame < completedFenceValue)
+        {
+            finished.push_back(it->context);
+            it = m_retired.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    m_current.resetHistory = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_destroyQueue.insert(m_destroyQueue.end(), finished.begin(), finished.end());
+        if (m_ready != nullptr)
+        {
+            // The previous frame is the last one that executed the old context.
+            m_retired.push_back({m_current.context, frameIndex > 0 ? frameIndex - 1 : 0});
+            m_current.context = m_ready;
+            m_current.key = m_readyKey;
+            m_current.resetHistory = true;
+            m_currentKey = m_readyKey;
+            m_ready = nullptr;
+            m_statistics.swaps++;
+        }
+    }
+    if (!finished.empty())
+    {
+        m_condition.notify_all();
+    }
+    return m_current;
+}
+
+bool ContextSwapManager::IsSwapPending() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return !(m_target == m_currentKey);
+}
+
+ContextSwapStatistics ContextSwapManager::GetStatistics() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_statistics;
+}
+
+std::string ContextSwapManager::FormatReport() const
+{
+    const ContextSwapStatistics statistics = GetStatistics();
+    const std::uint64_t builds = statistics.swaps + statistics.superseded + statistics.failures;
+    std::ostringstream report;
+    report << std::fixed << std::setprecision(1);
+    report << "XeSS context swaps: requests " << statistics.requests << ", swaps " << statistics.swaps << ", superseded "
+           << statistics.superseded << ", failures " << statistics.failures << ", destroyed " << statistics.destroyed
+           << ", build mean " << (builds > 0 ? statistics.totalBuildMs / builds : 0.0) << " ms, max "
+           << statistics.maxBuildMs << " ms\n";
+    return report.str();
+}
+
+void ContextSwapManager::WorkerThread()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    for (;;)
+    {
+        m_condition.wait(lock, [this] { return m_stopRequested || m_buildRequested || !m_destroyQueue.empty(); });
+
+        if (!m_destroyQueue.empty())
+        {
+            std::vector<xess_context_handle_t> contexts;
+            contexts.swap(m_destroyQueue);
+            lock.unlock();
+            for (xess_context_handle_t context : contexts)
+            {
+                m_backend.Destroy(context);
+            }
+            lock.lock();
+            m_statistics.destroyed += contexts.size();
+            continue;
+        }
+        if (m_stopRequested)
+        {
+            return;
+        }
+
+        const ContextPoolKey key = m_target;
+        m_buildRequested = false;
+        m_building = true;
+        m_buildingKey = key;
+        lock.unlock();
+
+        xess_properties_t properties = {};
+        const auto start = std::chrono::steady_clock::now();
+        xess_context_handle_t context = m_backend.Create(key, properties);
+        const double buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        lock.lock();
+        m_building = false;
+        m_statistics.totalBuildMs += buildMs;
+        m_statistics.maxBuildMs = std::max(m_statistics.maxBuildMs, buildMs);
+        if (context == nullptr)
+        {
+            m_statistics.failures++;
+            // Give up on the configuration, a later request for it is built again.
+            if (key == m_target)
+            {
+                m_target = m_currentKey;
+            }
+        }
+        else if (key == m_target && !(key == m_currentKey))
+        {
+            m_ready = context;
+            m_readyKey = key;
+        }
+        else
+        {
+            m_destroyQueue.push_back(context);
+            m_statistics.superseded++;
+        }
+    }
+}
+}
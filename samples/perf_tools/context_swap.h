@@ -0,0 +1,129 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "context_pool.h"
+
+namespace PerfTools
+{
+/** Context to execute in a frame. */
+struct SwapFrame
+{
+    xess_context_handle_t context = nullptr;
+    ContextPoolKey key;
+    /** Set on the first frame of a new context, pass it as resetHistory to the execute call. */
+    bool resetHistory = false;
+};
+
+struct ContextSwapStatistics
+{
+    std::uint64_t requests = 0;
+    std::uint64_t swaps = 0;
+    /** Contexts built for a configuration that was replaced by a newer request before they were used. */
+    std::uint64_t superseded = 0;
+    std::uint64_t failures = 0;
+    std::uint64_t destroyed = 0;
+    /** Time spent in ContextPoolBackend::Create on the worker thread. [ms] */
+    double totalBuildMs = 0.0;
+    double maxBuildMs = 0.0;
+};
+
+/**
+ * Switches XeSS configurations without stalling the frame loop.
+ *
+ * A requested configuration is created, built and initialized on a worker
+ * thread while the render thread keeps executing the current context. The new
+ * context becomes current at the next frame boundary, with resetHistory set for
+ * its first frame. The old context is retired and destroyed on the worker thread
+ * once the fence value passed to BeginFrame shows that the GPU has finished the
+ * last frame that used it. A request made while another one is being built
+ * replaces it, contexts built for outdated requests are destroyed unused.
+ *
+ * Request can be called from any thread, BeginFrame only from the render thread.
+ * BeginFrame never waits for a build.
+ */
+class ContextSwapManager
+{
+public:
+    explicit ContextSwapManager(ContextPoolBackend& backend);
+    ~ContextSwapManager();
+
+    ContextSwapManager(const ContextSwapManager&) = delete;
+    ContextSwapManager& operator=(const ContextSwapManager&) = delete;
+
+    /**
+     * Creates the first context, blocking, and starts the worker thread.
+     * @return false if the context cannot be created
+     */
+    bool Start(const ContextPoolKey& key);
+
+    /** Stops the worker thread and destroys all contexts, no GPU work may be pending. */
+    void Stop();
+
+    /** Requests a switch to the configuration, ignored if it is already current or being built. */
+    void Request(const ContextPoolKey& key);
+
+    /**
+     * Call at the start of every frame, before the execute call is recorded.
+     * @param frameIndex - index of the frame, increasing by one per frame
+     * @param completedFenceValue - all frames with an index below it are finished on the GPU
+     * @return context to execute in this frame
+     */
+    SwapFrame BeginFrame(std::uint64_t frameIndex, std::uint64_t completedFenceValue);
+
+    /** @return true if a requested configuration is not current yet */
+    bool IsSwapPending() const;
+
+    ContextSwapStatistics GetStatistics() const;
+    std::string FormatReport() const;
+
+private:
+    struct RetiredContext
+    {
+        xess_context_handle_t context;
+        std::uint64_t lastFrame;
+    };
+
+    void WorkerThread();
+
+    ContextPoolBackend& m_backend;
+
+    // Render thread only.
+    SwapFrame m_current;
+    std::vector<RetiredContext> m_retired;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::thread m_thread;
+    bool m_stopRequested = false;
+    // Latest requested configuration, the target of all pending work.
+    ContextPoolKey m_target;
+    ContextPoolKey m_currentKey;
+    bool m_buildRequested = false;
+    bool m_building = false;
+    ContextPoolKey m_buildingKey;
+    xess_context_handle_t m_ready = nullptr;
+    ContextPoolKey m_readyKey;
+    std::vector<xess_context_handle_t> m_destroyQueue;
+    ContextSwapStatistics m_statistics;
+};
+}
@@ -0,0 +1,278 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+// Stress test of the background context swap. A render loop executes the
+// current context every frame while requester threads switch configurations at
+// random, against a stand-in backend whose create and init block for a random
+// time and sometimes fail. Checks that no context is destroyed while a frame
+// that used it is in flight, that resetHistory is set exactly on swaps, that
+// the last request wins and that nothing leaks. Exits with 1 on a violation.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "command_line.h"
+#include "context_swap.h"
+
+using namespace PerfTools;
+
+namespace
+{
+    void PrintUsage()
+    {
+        std::printf("Usage: context_swap_stress [-frames <count>] [-frame_ms <ms>] [-gpu_latency <frames>]\n"
+            "    [-requesters <threads>] [-request_ms <mean interval>] [-build_ms <min,max>] [-fail_rate <0..1>]\n"
+            "    [-seed <value>]\n");
+    }
+
+    /** Thread safe stand-in for context creation and destruction that tracks the frames using each context. */
+    class StressBackend : public ContextPoolBackend
+    {
+    public:
+        StressBackend(double minBuildMs, double maxBuildMs, double failRate, std::uint64_t seed)
+            : m_minBuildMs(minBuildMs), m_maxBuildMs(maxBuildMs), m_failRate(failRate), m_generator(seed)
+        {
+        }
+
+        xess_context_handle_t Create(const ContextPoolKey&, xess_properties_t& properties) override
+        {
+            double buildMs;
+            bool fail;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                buildMs = std::uniform_real_distribution<double>(m_minBuildMs, m_maxBuildMs)(m_generator);
+                fail = std::uniform_real_distribution<double>(0.0, 1.0)(m_generator) < m_failRate;
+            }
+            std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(buildMs));
+            if (fail)
+            {
+                return nullptr;
+            }
+
+            properties = {};
+            std::lock_guard<std::mutex> lock(m_mutex);
+            xess_context_handle_t context = reinterpret_cast<xess_context_handle_t>(std::uintptr_t(++m_lastId));
+            m_lastUsedFrame[context] = -1;
+            return context;
+        }
+
+        void Destroy(xess_context_handle_t context) override
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_lastUsedFrame.find(context);
+            if (it == m_lastUsedFrame.end())
+            {
+                std::fprintf(stderr, "Destroy of unknown context %p\n", (void*)context);
+                m_violations++;
+                return;
+            }
+            if (it->second >= 0 && std::uint64_t(it->second) >= m_completedFenceValue)
+            {
+                std::fprintf(stderr, "Context %p destroyed while frame %lld is in flight\n", (void*)context, it->second);
+                m_violations++;
+            }
+            m_lastUsedFrame.erase(it);
+        }
+
+        /** @return false if the context is not alive */
+        bool Use(xess_context_handle_t context, std::uint64_t frameIndex)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_lastUsedFrame.find(context);
+            if (it == m_lastUsedFrame.end())
+            {
+                m_violations++;
+                return false;
+            }
+            it->second = (long long)frameIndex;
+            return true;
+        }
+
+        void SetCompletedFenceValue(std::uint64_t value)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_completedFenceValue = value;
+        }
+
+        std::size_t GetLiveCount()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_lastUsedFrame.size();
+        }
+
+        std::uint64_t GetViolations()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_violations;
+        }
+
+    private:
+        double m_minBuildMs;
+        double m_maxBuildMs;
+        double m_failRate;
+        std::mt19937_64 m_generator;
+        std::mutex m_mutex;
+        std::uint64_t m_lastId = 0;
+        std::map<xess_context_handle_t, long long> m_lastUsedFrame;
+        std::uint64_t m_completedFenceValue = 0;
+        std::uint64_t m_violations = 0;
+    };
+
+    ContextPoolKey MakeKey(std::uint32_t width, std::uint32_t height, xess_quality_settings_t quality)
+    {
+        ContextPoolKey key;
+        key.outputResolution = {width, height};
+        key.quality = quality;
+        return key;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    CommandLine args(argc, argv);
+    if (args.IsSet("-help"))
+    {
+        PrintUsage();
+        return 0;
+    }
+
+    const long long frames = std::max(args.GetInt("-frames", 5000), 1ll);
+    const double frameMs = args.GetDouble("-frame_ms", 1.0);
+    const std::uint64_t gpuLatency = std::uint64_t(std::max(args.GetInt("-gpu_latency", 2), 0ll));
+    const long long requesters = std::max(args.GetInt("-requesters", 4), 1ll);
+    const double requestMs = args.GetDouble("-request_ms", 20.0);
+    double minBuildMs = 5.0;
+    double maxBuildMs = 50.0;
+    std::sscanf(args.GetString("-build_ms", "5,50").c_str(), "%lf,%lf", &minBuildMs, &maxBuildMs);
+    const double failRate = args.GetDouble("-fail_rate", 0.05);
+    const std::uint64_t seed = std::uint64_t(args.GetInt("-seed", 1));
+
+    const std::vector<ContextPoolKey> keys = {
+        MakeKey(1920, 1080, XESS_QUALITY_SETTING_BALANCED),
+        MakeKey(2560, 1440, XESS_QUALITY_SETTING_BALANCED),
+        MakeKey(2560, 1440, XESS_QUALITY_SETTING_QUALITY),
+        MakeKey(3840, 2160, XESS_QUALITY_SETTING_PERFORMANCE),
+    };
+
+    StressBackend backend(minBuildMs, std::max(minBuildMs, maxBuildMs), failRate, seed);
+    ContextSwapManager manager(backend);
+    // The first create is subject to the simulated failures as well.
+    int attempts = 0;
+    while (!manager.Start(keys[0]))
+    {
+        if (++attempts == 100)
+        {
+            std::fprintf(stderr, "Initial context creation failed\n");
+            return 1;
+        }
+    }
+
+    std::atomic<bool> requesting(true);
+    std::vector<std::thread> threads;
+    for (long long i = 0; i < requesters; i++)
+    {
+        threads.emplace_back([&, i] {
+            std::mt19937_64 generator(seed * 7919 + std::uint64_t(i));
+            std::exponential_distribution<double> interval(1.0 / std::max(requestMs * requesters, 0.001));
+            while (requesting)
+            {
+                std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(interval(generator)));
+                manager.Request(keys[generator() % keys.size()]);
+            }
+        });
+    }
+
+    std::uint64_t violations = 0;
+    std::vector<double> beginFrameUs;
+    xess_context_handle_t previous = nullptr;
+    std::uint64_t frameIndex = 0;
+    auto runFrame = [&] {
+        // Frames up to gpuLatency ago are finished on the simulated GPU.
+        backend.SetCompletedFenceValue(frameIndex >= gpuLatency ? frameIndex - gpuLatency : 0);
+        const auto start = std::chrono::steady_clock::now();
+        const SwapFrame frame = manager.BeginFrame(frameIndex, frameIndex >= gpuLatency ? frameIndex - gpuLatency : 0);
+        beginFrameUs.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+
+        if (!backend.Use(frame.context, frameIndex))
+        {
+            std::fprintf(stderr, "Frame %llu executes a destroyed context\n", (unsigned long long)frameIndex);
+        }
+        if (frame.resetHistory != (previous != nullptr && frame.context != previous))
+        {
+            std::fprintf(stderr, "Frame %llu has resetHistory %d on %s\n", (unsigned long long)frameIndex,
+                frame.resetHistory ? 1 : 0, frame.context != previous ? "a swap" : "no swap");
+            violations++;
+        }
+        previous = frame.context;
+        frameIndex++;
+        std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(frameMs));
+        return frame;
+    };
+
+    for (long long i = 0; i < frames; i++)
+    {
+        runFrame();
+    }
+    requesting = false;
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    // The last request must win once the builds settle, retried while the simulated failures hit it.
+    const ContextPoolKey last = keys[1];
+    const auto settleStart = std::chrono::steady_clock::now();
+    const double settleLimitMs = 100.0 * maxBuildMs + 1000.0;
+    SwapFrame final;
+    for (;;)
+    {
+        manager.Request(last);
+        final = runFrame();
+        if ((final.key == last && !manager.IsSwapPending()) ||
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - settleStart).count() > settleLimitMs)
+        {
+            break;
+        }
+    }
+    if (!(final.key == last))
+    {
+        std::fprintf(stderr, "The last request did not become current\n");
+        violations++;
+    }
+
+    std::printf("%s", manager.FormatReport().c_str());
+    // Wait for the simulated GPU before the remaining contexts are destroyed.
+    backend.SetCompletedFenceValue(frameIndex);
+    manager.Stop();
+    if (backend.GetLiveCount() != 0)
+    {
+        std::fprintf(stderr, "%zu contexts leaked\n", backend.GetLiveCount());
+        violations++;
+    }
+    violations += backend.GetViolations();
+
+    std::sort(beginFrameUs.begin(), beginFrameUs.end());
+    const std::size_t p99 = std::min(beginFrameUs.size() - 1, std::size_t(beginFrameUs.size() * 0.99));
+    std::printf("frames %llu, BeginFrame p50 %.2f us, p99 %.2f us, max %.2f us, violations %llu\n",
+        (unsigned long long)frameIndex, beginFrameUs[beginFrameUs.size() / 2], beginFrameUs[p99], beginFrameUs.back(),
+        (unsigned long long)violations);
+    return violations == 0 ? 0 : 1;
+}
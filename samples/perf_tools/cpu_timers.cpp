@@ -0,0 +1,268 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#include "cpu_timers.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+namespace
+{
+    struct TickRecord
+    {
+        std::uint32_t zone;
+        std::uint64_t startTicks;
+        std::uint64_t endTicks;
+    };
+
+    // Written by one producer thread and read by the draining thread. The
+    // indices live on separate cache lines so that the producer only touches
+    // the consumer's line when the ring looks full.
+    struct ThreadRing
+    {
+        alignas(64) std::atomic<std::uint32_t> write{0};
+        std::uint32_t cachedRead = 0;
+        std::atomic<std::uint64_t> dropped{0};
+        alignas(64) std::atomic<std::uint32_t> read{0};
+        alignas(64) TickRecord records[PerfTools::CpuTimers::RingCapacity];
+    };
+
+    static_assert((PerfTools::CpuTimers::RingCapacity & (PerfTools::CpuTimers::RingCapacity - 1)) == 0,
+        "RingCapacity must be a power of two");
+
+    ThreadRing g_rings[PerfTools::CpuTimers::MaxThreads];
+    std::atomic<std::uint32_t> g_threadCount{0};
+    std::atomic<std::uint64_t> g_overflowDrops{0};
+
+    std::atomic<const char*> g_zoneNames[PerfTools::CpuTimers::MaxZones] = {};
+    std::atomic<std::uint32_t> g_zoneCount{0};
+
+    // Time base set by Calibrate, the identity until then.
+    double g_nanosecondsPerTick = 1.0;
+    std::uint64_t g_baseTicks = 0;
+    std::uint64_t g_baseNs = 0;
+
+    // Constant initialized, so access needs no guard.
+    thread_local ThreadRing* t_ring = nullptr;
+    thread_local bool t_overflow = false;
+
+    std::uint64_t SteadyNow()
+    {
+        return (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    std::uint64_t TicksToNanoseconds(std::uint64_t ticks)
+    {
+        const double offset = (double)(std::int64_t)(ticks - g_baseTicks) * g_nanosecondsPerTick;
+        return (std::uint64_t)((std::int64_t)g_baseNs + std::llround(offset));
+    }
+
+    ThreadRing* ClaimRing()
+    {
+        if (t_overflow)
+        {
+            return nullptr;
+        }
+        const std::uint32_t index = g_threadCount.fetch_add(1, std::memory_order_acq_rel);
+        if (index >= PerfTools::CpuTimers::MaxThreads)
+        {
+            t_overflow = true;
+            return nullptr;
+        }
+        t_ring = &g_rings[index];
+        return t_ring;
+    }
+}
+
+namespace PerfTools
+{
+std::atomic<bool> CpuTimers::s_enabled{false};
+
+void CpuTimers::Calibrate(std::uint32_t milliseconds)
+{
+    const std::uint64_t intervalNs = (std::uint64_t)milliseconds * 1000000u;
+    const std::uint64_t startNs = SteadyNow();
+    const std::uint64_t startTicks = ReadTicks();
+
+    // Busy wait, a sleep could end long after the interval.
+    std::uint64_t endNs = startNs;
+    while (endNs - startNs < intervalNs)
+    {
+        endNs = SteadyNow();
+    }
+    const std::uint64_t endTicks = ReadTicks();
+
+    if (endTicks > startTicks && endNs > startNs)
+    {
+        g_nanosecondsPerTick = (double)(endNs - startNs) / (double)(endTicks - startTicks);
+    }
+    g_baseTicks = endTicks;
+    g_baseNs = endNs;
+}
+
+double CpuTimers::GetTicksPerNanosecond()
+{
+    return 1.0 / g_nanosecondsPerTick;
+}
+
+std::uint32_t CpuTimers::RegisterZone(const char* name)
+{
+    const std::uint32_t zone = g_zoneCount.fetch_add(1, std::memory_order_relaxed);
+    if (zone >= MaxZones)
+    {
+        return MaxZones;
+    }
+    g_zoneNames[zone].store(name, std::memory_order_release);
+    return zone;
+}
+
+std::uint32_t CpuTimers::GetZoneCount()
+{
+    const std::uint32_t count = g_zoneCount.load(std::memory_order_relaxed);
+    return count < MaxZones ? count : MaxZones;
+}
+
+const char* CpuTimers::GetZoneName(std::uint32_t zone)
+{
+    const char* name = zone < MaxZones ? g_zoneNames[zone].load(std::memory_order_acquire) : nullptr;
+    return name != nullptr ? name : "unknown";
+}
+
+void CpuTimers::Record(std::uint32_t zone, std::uint64_t startTicks, std::uint64_t endTicks)
+{
+    ThreadRing* ring = t_ring;
+    if (ring == nullptr)
+    {
+        ring = ClaimRing();
+        if (ring == nullptr)
+        {
+            g_overflowDrops.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+    }
+
+    const std::uint32_t write = ring->write.load(std::memory_order_relaxed);
+    if (write - ring->cachedRead == RingCapacity)
+    {
+        ring->cachedRead = ring->read.load(std::memory_order_acquire);
+        if (write - ring->cachedRead == RingCapacity)
+        {
+            ring->dropped.store(ring->dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            return;
+        }
+    }
+
+    TickRecord& record = ring->records[write & (RingCapacity - 1)];
+    record.zone = zone;
+    record.startTicks = startTicks;
+    record.endTicks = endTicks;
+    ring->write.store(write + 1, std::memory_order_release);
+}
+
+std::uint32_t CpuTimers::Drain(CpuTimerSample* samples, std::uint32_t capacity)
+{
+    std::uint32_t written = 0;
+    std::uint32_t threads = g_threadCount.load(std::memory_order_acquire);
+    threads = threads < MaxThreads ? threads : MaxThreads;
+    for (std::uint32_t thread = 0; thread < threads && written < capacity; ++thread)
+    {
+        ThreadRing& ring = g_rings[thread];
+        const std::uint32_t read = ring.read.load(std::memory_order_relaxed);
+        const std::uint32_t write = ring.write.load(std::memory_order_acquire);
+        const std::uint32_t count = std::min(write - read, capacity - written);
+        for (std::uint32_t i = 0; i < count; ++i)
+        {
+            const TickRecord& record = ring.records[(read + i) & (RingCapacity - 1)];
+            const std::uint64_t startNs = TicksToNanoseconds(record.startTicks);
+            const std::uint64_t endNs = TicksToNanoseconds(record.endTicks);
+            samples[written++] = {record.zone, thread, startNs, endNs > startNs ? endNs - startNs : 0};
+        }
+        ring.read.store(read + count, std::memory_order_release);
+    }
+    return written;
+}
+
+std::uint64_t CpuTimers::GetDroppedCount()
+{
+    std::uint64_t dropped = g_overflowDrops.load(std::memory_order_relaxed);
+    for (std::uint32_t thread = 0; thread < MaxThreads; ++thread)
+    {
+        dropped += g_rings[thread].dropped.load(std::memory_order_relaxed);
+    }
+    return dropped;
+}
+
+CpuTimerStatistics::CpuTimerStatistics()
+    : m_histograms(new HdrHistogram[CpuTimers::MaxZones])
+{
+}
+
+void CpuTimerStatistics::Add(const CpuTimerSample* samples, std::uint32_t count)
+{
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+        if (samples[i].zone < CpuTimers::MaxZones)
+        {
+            m_histograms[samples[i].zone].Record(samples[i].durationNs);
+        }
+    }
+}
+
+void CpuTimerStatistics::Reset()
+{
+    for (std::uint32_t zone = 0; zone < CpuTimers::MaxZones; ++zone)
+    {
+        m_histograms[zone].Reset();
+    }
+}
+
+std::string CpuTimerStatistics::FormatReport(std::uint64_t frames) const
+{
+    std::string report;
+    char line[256];
+    std::snprintf(line, sizeof(line), "CPU timers, %.1f ticks/ns [us]\n", CpuTimers::GetTicksPerNanosecond());
+    report += line;
+    std::snprintf(line, sizeof(line), "%-32s %10s %9s %9s %9s %9s %9s %9s\n",
+        "zone", "count", "mean", "p50", "p90", "p99", "max", "per frame");
+    report += line;
+
+    for (std::uint32_t zone = 0; zone < CpuTimers::GetZoneCount(); ++zone)
+    {
+        const HdrHistogram& h = m_histograms[zone];
+        if (h.GetCount() == 0)
+        {
+            continue;
+        }
+        // Sum of all durations over frames, includes zones entered several times per frame.
+        const double perFrameUs = frames != 0 ? h.GetMean() * (double)h.GetCount() / (double)frames * 1e-3 : 0.0;
+        std::snprintf(line, sizeof(line), "%-32s %10llu %9.2f %9.2f %9.2f %9.2f %9.2f %9.2f\n",
+            CpuTimers::GetZoneName(zone), (unsigned long long)h.GetCount(), h.GetMean() * 1e-3,
+            (double)h.GetPercentile(50.0) * 1e-3, (double)h.GetPercentile(90.0) * 1e-3,
+            (double)h.GetPercentile(99.0) * 1e-3, (double)h.GetMax() * 1e-3, perFrameUs);
+        report += line;
+    }
+
+    const std::uint64_t dropped = CpuTimers::GetDroppedCount();
+    if (dropped != 0)
+    {
+        std::snprintf(line, sizeof(line), "%llu samples dropped, rings full or more than %u threads\n",
+            (unsigned long long)dropped, CpuTimers::MaxThreads);
+        report += line;
+    }
+    return report;
+}
+}
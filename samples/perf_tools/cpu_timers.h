@@ -0,0 +1,163 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define PERF_TOOLS_HAS_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define PERF_TOOLS_HAS_TSC 1
+#else
+#include <chrono>
+#define PERF_TOOLS_HAS_TSC 0
+#endif
+
+#include "hdr_histogram.h"
+
+namespace PerfTools
+{
+/** One completed scope. Times are on the steady_clock epoch in nanoseconds, like TraceExporter::Now. */
+struct CpuTimerSample
+{
+    std::uint32_t zone;
+    /** Index of the recording thread in order of first use. */
+    std::uint32_t thread;
+    std::uint64_t startNs;
+    std::uint64_t durationNs;
+};
+
+/**
+ * Process wide CPU scope timers for hot paths.
+ *
+ * Timestamps are raw time stamp counter reads, converted to nanoseconds only
+ * when drained, so a probe costs two counter reads and one ring write. Every
+ * thread writes to its own single-producer ring, claimed on first use from a
+ * fixed pool: recording takes no lock and never allocates. When a ring is full
+ * new samples are dropped and counted. Without a TSC steady_clock is read.
+ *
+ * Call Calibrate once before the first drain. Drain is meant for one consumer
+ * thread, for example the render thread once per frame.
+ */
+class CpuTimers
+{
+public:
+    static const std::uint32_t MaxThreads = 16;
+    static const std::uint32_t MaxZones = 64;
+    /** Samples per thread, a power of two. */
+    static const std::uint32_t RingCapacity = 4096;
+
+    /**
+     * Measures the counter frequency against steady_clock and sets the time base.
+     * @param milliseconds - measurement interval, longer is more precise
+     */
+    static void Calibrate(std::uint32_t milliseconds = 20);
+    /** @return counter ticks per nanosecond found by Calibrate, 1 without calibration */
+    static double GetTicksPerNanosecond();
+
+    /**
+     * Registers a named zone, typically once at startup.
+     * @param name - zone name, must outlive the timers
+     * @return zone ID for Record and ScopedCpuTimer, MaxZones if all zones are taken
+     */
+    static std::uint32_t RegisterZone(const char* name);
+    static std::uint32_t GetZoneCount();
+    /** @return zone name, "unknown" for unregistered IDs */
+    static const char* GetZoneName(std::uint32_t zone);
+
+    /** Recording is off until enabled, disabled probes only read the flag. */
+    static void SetEnabled(bool enabled) { s_enabled.store(enabled, std::memory_order_relaxed); }
+    static bool IsEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+    static std::uint64_t ReadTicks()
+    {
+#if PERF_TOOLS_HAS_TSC
+        return __rdtsc();
+#else
+        return (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+    }
+
+    /** Appends one scope to the ring of the calling thread. */
+    static void Record(std::uint32_t zone, std::uint64_t startTicks, std::uint64_t endTicks);
+
+    /**
+     * Moves recorded samples of all threads out of the rings, oldest first per thread.
+     * @param samples - destination
+     * @param capacity - size of the destination, samples that do not fit stay in the rings
+     * @return number of samples written
+     */
+    static std::uint32_t Drain(CpuTimerSample* samples, std::uint32_t capacity);
+
+    /** @return samples dropped because a ring was full or more than MaxThreads threads recorded */
+    static std::uint64_t GetDroppedCount();
+
+private:
+    static std::atomic<bool> s_enabled;
+};
+
+/** Records the lifetime of the object as one sample of a zone. */
+class ScopedCpuTimer
+{
+public:
+    explicit ScopedCpuTimer(std::uint32_t zone)
+        : m_zone(zone), m_active(CpuTimers::IsEnabled()), m_start(m_active ? CpuTimers::ReadTicks() : 0)
+    {
+    }
+
+    ~ScopedCpuTimer()
+    {
+        if (m_active)
+        {
+            CpuTimers::Record(m_zone, m_start, CpuTimers::ReadTicks());
+        }
+    }
+
+    ScopedCpuTimer(const ScopedCpuTimer&) = delete;
+    ScopedCpuTimer& operator=(const ScopedCpuTimer&) = delete;
+
+private:
+    std::uint32_t m_zone;
+    bool m_active;
+    std::uint64_t m_start;
+};
+
+/** Per-zone duration histograms of drained samples, in nanoseconds. */
+class CpuTimerStatistics
+{
+public:
+    CpuTimerStatistics();
+
+    void Add(const CpuTimerSample* samples, std::uint32_t count);
+    void Reset();
+
+    const HdrHistogram& GetZoneHistogram(std::uint32_t zone) const { return m_histograms[zone]; }
+
+    /**
+     * @param frames - frames covered by the samples, adds a per-frame mean column if not 0
+     * @return human readable table of all zones with samples, one line per zone
+     */
+    std::string FormatReport(std::uint64_t frames = 0) const;
+
+private:
+    std::unique_ptr<HdrHistogram[]> m_histograms;
+};
+}
@@ -0,0 +1,278 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#include "dump_stream.h"
+
+#include <chrono>
+#include <new>
+
+namespace
+{
+    const std::uint32_t SlotAlignment = 256;
+
+    std::uint32_t AlignUp(std::uint32_t value, std::uint32_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+}
+
+namespace PerfTools
+{
+const char* GetDumpElementName(std::uint32_t element)
+{
+    switch (element)
+    {
+    case XESS_DUMP_INPUT_COLOR: return "color";
+    case XESS_DUMP_INPUT_VELOCITY: return "velocity";
+    case XESS_DUMP_INPUT_DEPTH: return "depth";
+    case XESS_DUMP_INPUT_EXPOSURE_SCALE: return "exposure_scale";
+    case XESS_DUMP_INPUT_RESPONSIVE_PIXEL_MASK: return "responsive_mask";
+    case XESS_DUMP_OUTPUT: return "output";
+    case XESS_DUMP_HISTORY: return "history";
+    case XESS_DUMP_EXECUTION_PARAMETERS: return "execution_parameters";
+    default: return "unknown";
+    }
+}
+
+bool DumpStreamWriter::Create(const std::string& name, xess_dump_elements_mask_t elementsMask,
+    std::uint32_t slotCount, std::uint32_t slotDataSize)
+{
+    Close();
+
+    if (slotCount == 0)
+    {
+        return false;
+    }
+
+    const std::uint32_t slotsOffset = AlignUp((std::uint32_t)sizeof(DumpStreamHeader), SlotAlignment);
+    const std::uint32_t slotSize = AlignUp((std::uint32_t)sizeof(DumpStreamFrame), SlotAlignment) +
+        AlignUp(slotDataSize, SlotAlignment);
+    if (!m_memory.Create(name, (std::size_t)slotsOffset + (std::size_t)slotSize * slotCount))
+    {
+        return false;
+    }
+
+    std::uint8_t* base = static_cast<std::uint8_t*>(m_memory.GetData());
+    m_header = new (base) DumpStreamHeader();
+    m_header->version = DumpStreamVersion;
+    m_header->slotCount = slotCount;
+    m_header->slotSize = slotSize;
+    m_header->elementsMask = elementsMask != 0 ? elementsMask : (xess_dump_elements_mask_t)XESS_DUMP_ALL_INPUTS;
+    m_header->slotsOffset = slotsOffset;
+    m_header->writeIndex.store(0, std::memory_order_relaxed);
+    m_header->readIndex.store(0, std::memory_order_relaxed);
+    m_header->droppedFrames.store(0, std::memory_order_relaxed);
+    m_header->magic.store(DumpStreamMagic, std::memory_order_release);
+
+    m_slots = base + slotsOffset;
+    m_writeIndex = 0;
+    m_frame = nullptr;
+    return true;
+}
+
+void DumpStreamWriter::Close()
+{
+    if (m_header != nullptr)
+    {
+        m_header->magic.store(0, std::memory_order_release);
+    }
+    m_memory.Close();
+    m_header = nullptr;
+    m_slots = nullptr;
+    m_frame = nullptr;
+}
+
+bool DumpStreamWriter::IsElementSelected(xess_dump_element_bits_t element) const
+{
+    return m_header != nullptr && (m_header->elementsMask & (xess_dump_elements_mask_t)element) != 0;
+}
+
+bool DumpStreamWriter::BeginFrame(std::uint64_t frameIndex, float jitterOffsetX, float jitterOffsetY)
+{
+    m_frame = nullptr;
+    if (m_header == nullptr)
+    {
+        return false;
+    }
+
+    const std::uint64_t readIndex = m_header->readIndex.load(std::memory_order_acquire);
+    if (m_writeIndex - readIndex >= m_header->slotCount)
+    {
+        m_header->droppedFrames.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    std::uint8_t* slot = m_slots + (std::size_t)(m_writeIndex % m_header->slotCount) * m_header->slotSize;
+    m_frame = reinterpret_cast<DumpStreamFrame*>(slot);
+    m_frame->frameIndex = frameIndex;
+    m_frame->timestampNs = 0;
+    m_frame->jitterOffsetX = jitterOffsetX;
+    m_frame->jitterOffsetY = jitterOffsetY;
+    m_frame->elementsMask = 0;
+    m_frame->elementCount = 0;
+    m_frameUsedSize = AlignUp((std::uint32_t)sizeof(DumpStreamFrame), SlotAlignment);
+    return true;
+}
+
+std::uint8_t* DumpStreamWriter::AddElement(xess_dump_element_bits_t element, PixelFormat format,
+    std::uint32_t width, std::uint32_t height, std::uint32_t rowPitch)
+{
+    if (m_frame == nullptr || !IsElementSelected(element) ||
+        (m_frame->elementsMask & (xess_dump_elements_mask_t)element) != 0 ||
+        m_frame->elementCount == DumpStreamMaxElements)
+    {
+        return nullptr;
+    }
+
+    const std::uint64_t dataSize = (std::uint64_t)rowPitch * height;
+    if (m_frameUsedSize + dataSize > m_header->slotSize)
+    {
+        return nullptr;
+    }
+
+    DumpStreamElement& desc = m_frame->elements[m_frame->elementCount++];
+    desc.element = (std::uint32_t)element;
+    desc.format = format;
+    desc.width = width;
+    desc.height = height;
+    desc.rowPitch = rowPitch;
+    desc.dataOffset = m_frameUsedSize;
+    m_frame->elementsMask |= (xess_dump_elements_mask_t)element;
+
+    m_frameUsedSize = AlignUp(m_frameUsedSize + (std::uint32_t)dataSize, SlotAlignment);
+    return reinterpret_cast<std::uint8_t*>(m_frame) + desc.dataOffset;
+}
+
+void DumpStreamWriter::EndFrame()
+{
+    if (m_frame == nullptr)
+    {
+        return;
+    }
+
+    m_frame->timestampNs = (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    m_frame = nullptr;
+    m_writeIndex++;
+    m_header->writeIndex.store(m_writeIndex, std::memory_order_release);
+}
+
+std::uint64_t DumpStreamWriter::GetDroppedFrameCount() const
+{
+    return m_header != nullptr ? m_header->droppedFrames.load(std::memory_order_relaxed) : 0;
+}
+
+bool DumpStreamReader::Open(const std::string& name)
+{
+    Close();
+
+    if (!m_memory.Open(name) || m_memory.GetSize() < sizeof(DumpStreamHeader))
+    {
+        m_memory.Close();
+        return false;
+    }
+
+    DumpStreamHeader* header = static_cast<DumpStreamHeader*>(m_memory.GetData());
+    if (header->magic.load(std::memory_order_acquire) != DumpStreamMagic ||
+        header->version != DumpStreamVersion ||
+        (std::size_t)header->slotsOffset + (std::size_t)header->slotSize * header->slotCount > m_memory.GetSize())
+    {
+        m_memory.Close();
+        return false;
+    }
+
+    m_header = header;
+    m_slots = static_cast<std::uint8_t*>(m_memory.GetData()) + header->slotsOffset;
+    // Join the stream at its current position, older frames belong to previous consumers.
+    m_readIndex = header->writeIndex.load(std::memory_order_acquire);
+    m_header->readIndex.store(m_readIndex, std::memory_order_release);
+    m_frameAcquired = false;
+    return true;
+}
+
+void DumpStreamReader::Close()
+{
+    m_memory.Close();
+    m_header = nullptr;
+    m_slots = nullptr;
+    m_frameAcquired = false;
+}
+
+bool DumpStreamReader::IsProducerAlive() const
+{
+    return m_header != nullptr && m_header->magic.load(std::memory_order_acquire) == DumpStreamMagic;
+}
+
+xess_dump_elements_mask_t DumpStreamReader::GetElementsMask() const
+{
+    return m_header != nullptr ? m_header->elementsMask : 0;
+}
+
+const DumpStreamFrame* DumpStreamReader::AcquireFrame()
+{
+    if (m_header == nullptr || m_frameAcquired)
+    {
+        return nullptr;
+    }
+
+    if (m_header->writeIndex.load(std::memory_order_acquire) == m_readIndex)
+    {
+        return nullptr;
+    }
+
+    m_frameAcquired = true;
+    const std::uint8_t* slot = m_slots + (std::size_t)(m_readIndex % m_header->slotCount) * m_header->slotSize;
+    return reinterpret_cast<const DumpStreamFrame*>(slot);
+}
+
+void DumpStreamReader::ReleaseFrame()
+{
+    if (!m_frameAcquired)
+    {
+        return;
+    }
+
+    m_frameAcquired = false;
+    m_readIndex++;
+    m_header->readIndex.store(m_readIndex, std::memory_order_release);
+}
+
+const DumpStreamElement* DumpStreamReader::FindElement(const DumpStreamFrame& frame, std::uint32_t element)
+{
+    for (std::uint32_t i = 0; i < frame.elementCount && i < DumpStreamMaxElements; ++i)
+    {
+        if (frame.elements[i].element == element)
+        {
+            return &frame.elements[i];
+        }
+    }
+    return nullptr;
+}
+
+ImageView DumpStreamReader::GetElementImage(const DumpStreamFrame& frame, const DumpStreamElement& element)
+{
+    ImageView view;
+    view.format = element.format;
+    view.width = element.width;
+    view.height = element.height;
+    view.rowPitch = element.rowPitch;
+    view.data = reinterpret_cast<const std::uint8_t*>(&frame) + element.dataOffset;
+    return view;
+}
+
+std::uint64_t DumpStreamReader::GetDroppedFrameCount() const
+{
+    return m_header != nullptr ? m_header->droppedFrames.load(std::memory_order_relaxed) : 0;
+}
+}
@@ -0,0 +1,172 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "xess/xess_debug.h"
+
+#include "image_metrics.h"
+#include "shared_memory.h"
+
+namespace PerfTools
+{
+/**
+ * Live alternative to xessStartDump: the application streams the selected
+ * xess_dump_element_bits_t elements of every frame into a single-producer,
+ * single-consumer ring in shared memory, and an analysis process on the same
+ * machine consumes frames as they arrive instead of waiting for dump files.
+ *
+ * The producer never blocks. When the consumer falls behind and all slots are
+ * taken, the frame is dropped and counted in DumpStreamHeader::droppedFrames.
+ */
+static const std::uint32_t DumpStreamMagic = 0x53445358; // "XSDS"
+static const std::uint32_t DumpStreamVersion = 1;
+static const std::uint32_t DumpStreamMaxElements = 8;
+static const char* const DumpStreamDefaultName = "xess_dump_stream";
+
+/** Location and layout of one element inside a frame slot. */
+struct DumpStreamElement
+{
+    /** Single xess_dump_element_bits_t bit. */
+    std::uint32_t element;
+    PixelFormat format;
+    std::uint32_t width;
+    std::uint32_t height;
+    std::uint32_t rowPitch;
+    /** Offset of the first texel from the start of the slot. */
+    std::uint32_t dataOffset;
+};
+
+/** Frame record at the start of each slot, followed by element data. */
+struct DumpStreamFrame
+{
+    std::uint64_t frameIndex;
+    /** Steady clock time when the frame was published. [nanoseconds] */
+    std::uint64_t timestampNs;
+    float jitterOffsetX;
+    float jitterOffsetY;
+    xess_dump_elements_mask_t elementsMask;
+    std::uint32_t elementCount;
+    DumpStreamElement elements[DumpStreamMaxElements];
+};
+
+/** Ring control block at the start of the shared memory region. */
+struct DumpStreamHeader
+{
+    /** Written last by the producer, consumers must not touch the ring before it is valid. */
+    std::atomic<std::uint32_t> magic;
+    std::uint32_t version;
+    std::uint32_t slotCount;
+    std::uint32_t slotSize;
+    xess_dump_elements_mask_t elementsMask;
+    std::uint32_t slotsOffset;
+    alignas(64) std::atomic<std::uint64_t> writeIndex;
+    alignas(64) std::atomic<std::uint64_t> readIndex;
+    alignas(64) std::atomic<std::uint64_t> droppedFrames;
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "Shared memory ring requires lock-free 64-bit atomics");
+
+/** @return printable name of a single xess_dump_element_bits_t bit */
+const char* GetDumpElementName(std::uint32_t element);
+
+/** Producer side of the dump stream, used by the rendering application. */
+class DumpStreamWriter
+{
+public:
+    /**
+     * Creates the shared memory ring.
+     * @param name - shared memory name, consumers open the stream with the same name
+     * @param elementsMask - elements to stream, 0 means XESS_DUMP_ALL_INPUTS as in xessStartDump
+     * @param slotCount - number of frames the consumer may lag behind
+     * @param slotDataSize - bytes of element data per frame
+     * @return true on success
+     */
+    bool Create(const std::string& name, xess_dump_elements_mask_t elementsMask,
+        std::uint32_t slotCount, std::uint32_t slotDataSize);
+    void Close();
+
+    bool IsOpen() const { return m_header != nullptr; }
+    bool IsElementSelected(xess_dump_element_bits_t element) const;
+
+    /**
+     * Starts a new frame.
+     * @return false if there is no free slot, the frame is counted as dropped
+     */
+    bool BeginFrame(std::uint64_t frameIndex, float jitterOffsetX, float jitterOffsetY);
+
+    /**
+     * Reserves storage for one element of the current frame.
+     * @return destination for rowPitch * height bytes, or nullptr if the element is
+     * not selected, already added, or does not fit into the slot
+     */
+    std::uint8_t* AddElement(xess_dump_element_bits_t element, PixelFormat format,
+        std::uint32_t width, std::uint32_t height, std::uint32_t rowPitch);
+
+    /** Publishes the current frame to the consumer. */
+    void EndFrame();
+
+    std::uint64_t GetDroppedFrameCount() const;
+
+private:
+    SharedMemory m_memory;
+    DumpStreamHeader* m_header = nullptr;
+    std::uint8_t* m_slots = nullptr;
+    DumpStreamFrame* m_frame = nullptr;
+    std::uint32_t m_frameUsedSize = 0;
+    std::uint64_t m_writeIndex = 0;
+};
+
+/** Consumer side of the dump stream, used by analysis tools. */
+class DumpStreamReader
+{
+public:
+    /** @return false if the producer has not created a compatible stream yet */
+    bool Open(const std::string& name);
+    void Close();
+
+    bool IsOpen() const { return m_header != nullptr; }
+    /** @return false once the producer closed the stream, the reader should reopen it */
+    bool IsProducerAlive() const;
+    xess_dump_elements_mask_t GetElementsMask() const;
+
+    /**
+     * @return oldest unread frame or nullptr if none is available. The frame stays
+     * valid until ReleaseFrame is called.
+     */
+    const DumpStreamFrame* AcquireFrame();
+
+    /** Returns the acquired frame slot to the producer. */
+    void ReleaseFrame();
+
+    /** @return element descriptor or nullptr if the frame does not contain it */
+    static const DumpStreamElement* FindElement(const DumpStreamFrame& frame, std::uint32_t element);
+
+    /** @return view of the element data inside the frame slot */
+    static ImageView GetElementImage(const DumpStreamFrame& frame, const DumpStreamElement& element);
+
+    std::uint64_t GetDroppedFrameCount() const;
+
+private:
+    SharedMemory m_memory;
+    DumpStreamHeader* m_header = nullptr;
+    std::uint8_t* m_slots = nullptr;
+    std::uint64_t m_readIndex = 0;
+    bool m_frameAcquired = false;
+};
+}
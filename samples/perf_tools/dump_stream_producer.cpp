@@ -0,0 +1,177 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+// Stand-in producer for the live dump stream and the periodic soak dumps. Publishes
+// synthetic color, velocity and output images so consumers can be developed and
+// checked without a GPU.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <thread>
+
+#include "command_line.h"
+#include "dump_stream.h"
+#include "periodic_dump.h"
+
+using namespace PerfTools;
+
+namespace
+{
+    void PrintUsage()
+    {
+        std::printf("Usage: dump_stream_producer [-name <stream>] [-frames <count>] [-width <output width>]\n"
+            "    [-height <output height>] [-elements <xess_dump_element_bits_t mask>] [-fps <rate>]\n"
+            "    [-soak_frames <interval>] [-soak_seconds <interval>] [-soak_budget <MB>] [-soak_folder <path>]\n");
+    }
+
+    void WriteRgba16f(std::uint8_t* texel, float r, float g, float b)
+    {
+        const std::uint16_t values[4] = { FloatToHalf(r), FloatToHalf(g), FloatToHalf(b), FloatToHalf(1.f) };
+        std::memcpy(texel, values, sizeof(values));
+    }
+
+    /** Horizontal gradient moving by speed pixels per frame. */
+    void FillScene(std::uint8_t* data, std::uint32_t width, std::uint32_t height, std::uint64_t frame, float scale)
+    {
+        for (std::uint32_t y = 0; y < height; ++y)
+        {
+            std::uint8_t* row = data + (std::size_t)y * width * 8;
+            for (std::uint32_t x = 0; x < width; ++x)
+            {
+                const float u = std::fmod(((float)x + (float)frame * 2.f * scale) / (64.f * scale), 1.f);
+                const float v = (float)y / (float)height;
+                WriteRgba16f(row + (std::size_t)x * 8, u, v, 0.5f);
+            }
+        }
+    }
+
+    /** Constant motion with a corrupted block to exercise the validity metric. */
+    void FillVelocity(std::uint8_t* data, std::uint32_t width, std::uint32_t height)
+    {
+        const std::uint16_t nan = FloatToHalf(std::numeric_limits<float>::quiet_NaN());
+        const std::uint16_t motion[2] = { FloatToHalf(-2.f), FloatToHalf(0.f) };
+        for (std::uint32_t y = 0; y < height; ++y)
+        {
+            std::uint8_t* row = data + (std::size_t)y * width * 4;
+            for (std::uint32_t x = 0; x < width; ++x)
+            {
+                const bool corrupted = x < width / 16 && y < height / 16;
+                const std::uint16_t values[2] = { corrupted ? nan : motion[0], corrupted ? nan : motion[1] };
+                std::memcpy(row + (std::size_t)x * 4, values, sizeof(values));
+            }
+        }
+    }
+
+    template <typename Writer>
+    void AddElements(Writer& writer, std::uint64_t frame, std::uint32_t inputWidth, std::uint32_t inputHeight,
+        std::uint32_t outputWidth, std::uint32_t outputHeight)
+    {
+        if (std::uint8_t* color = writer.AddElement(XESS_DUMP_INPUT_COLOR, PixelFormat::R16G16B16A16_FLOAT,
+            inputWidth, inputHeight, inputWidth * 8))
+        {
+            FillScene(color, inputWidth, inputHeight, frame, 0.5f);
+        }
+        if (std::uint8_t* velocity = writer.AddElement(XESS_DUMP_INPUT_VELOCITY, PixelFormat::R16G16_FLOAT,
+            outputWidth, outputHeight, outputWidth * 4))
+        {
+            FillVelocity(velocity, outputWidth, outputHeight);
+        }
+        if (std::uint8_t* output = writer.AddElement(XESS_DUMP_OUTPUT, PixelFormat::R16G16B16A16_FLOAT,
+            outputWidth, outputHeight, outputWidth * 8))
+        {
+            FillScene(output, outputWidth, outputHeight, frame, 1.f);
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    CommandLine args(argc, argv);
+    if (args.IsSet("-help"))
+    {
+        PrintUsage();
+        return 0;
+    }
+
+    const std::string name = args.GetString("-name", DumpStreamDefaultName);
+    const long long frameCount = args.GetInt("-frames", 600);
+    const std::uint32_t outputWidth = (std::uint32_t)args.GetInt("-width", 1920);
+    const std::uint32_t outputHeight = (std::uint32_t)args.GetInt("-height", 1080);
+    const xess_dump_elements_mask_t mask = (xess_dump_elements_mask_t)args.GetInt("-elements",
+        XESS_DUMP_INPUT_COLOR | XESS_DUMP_INPUT_VELOCITY | XESS_DUMP_OUTPUT);
+    const double fps = args.GetDouble("-fps", 60.0);
+
+    // Performance preset renders at half of the output resolution
+    const std::uint32_t inputWidth = outputWidth / 2;
+    const std::uint32_t inputHeight = outputHeight / 2;
+    const std::uint32_t slotDataSize = inputWidth * inputHeight * 8 + outputWidth * outputHeight * (4 + 8) + 3 * 256;
+
+    DumpStreamWriter writer;
+    if (!writer.Create(name, mask, 4, slotDataSize))
+    {
+        std::printf("Failed to create dump stream '%s'\n", name.c_str());
+        return 1;
+    }
+    std::printf("Streaming %lld frames to '%s'\n", frameCount, name.c_str());
+
+    PeriodicDumpSchedule schedule;
+    schedule.folder = args.GetString("-soak_folder", schedule.folder);
+    schedule.elementsMask = mask;
+    schedule.frameInterval = (std::uint32_t)args.GetInt("-soak_frames", 0);
+    schedule.secondsInterval = args.GetDouble("-soak_seconds", 0.0);
+    schedule.maxDiskBytes = (std::uint64_t)args.GetInt("-soak_budget", 2048) << 20;
+    schedule.maxSampleBytes = slotDataSize;
+    PeriodicDumper dumper;
+    if ((schedule.frameInterval != 0 || schedule.secondsInterval > 0.0) && !dumper.Start(schedule))
+    {
+        std::printf("Failed to start periodic dump to '%s'\n", schedule.folder.c_str());
+        return 1;
+    }
+
+    const auto framePeriod = std::chrono::duration<double>(fps > 0.0 ? 1.0 / fps : 0.0);
+    auto nextFrame = std::chrono::steady_clock::now();
+    for (long long frame = 0; frame < frameCount; ++frame)
+    {
+        const float jitterX = (float)(frame % 8) / 8.f - 0.5f;
+        const float jitterY = (float)(frame % 3) / 3.f - 0.5f;
+        if (writer.BeginFrame((std::uint64_t)frame, jitterX, jitterY))
+        {
+            AddElements(writer, (std::uint64_t)frame, inputWidth, inputHeight, outputWidth, outputHeight);
+            writer.EndFrame();
+        }
+        if (dumper.IsSampleDue((std::uint64_t)frame) && dumper.BeginSample((std::uint64_t)frame))
+        {
+            AddElements(dumper, (std::uint64_t)frame, inputWidth, inputHeight, outputWidth, outputHeight);
+            dumper.EndSample();
+        }
+
+        nextFrame += std::chrono::duration_cast<std::chrono::steady_clock::duration>(framePeriod);
+        std::this_thread::sleep_until(nextFrame);
+    }
+
+    std::printf("Done, %llu frames dropped by a slow consumer\n", (unsigned long long)writer.GetDroppedFrameCount());
+    writer.Close();
+
+    if (dumper.IsRunning())
+    {
+        dumper.Stop();
+        std::printf("Soak samples: %llu written, %llu skipped, %llu deleted, %.1f MB on disk\n",
+            (unsigned long long)dumper.GetWrittenSampleCount(), (unsigned long long)dumper.GetSkippedSampleCount(),
+            (unsigned long long)dumper.GetDeletedSampleCount(), (double)dumper.GetDiskUsage() / (1 << 20));
+    }
+    return 0;
+}
@@ -0,0 +1,130 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+// Reference consumer of the live dump stream. Prints per-frame velocity validity
+// and temporal stability of the upscaled output as frames arrive.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include "command_line.h"
+#include "dump_stream.h"
+
+using namespace PerfTools;
+
+namespace
+{
+    void PrintUsage()
+    {
+        std::printf("Usage: dump_stream_reader [-name <stream>] [-frames <count>] [-timeout <seconds>]\n");
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    CommandLine args(argc, argv);
+    if (args.IsSet("-help"))
+    {
+        PrintUsage();
+        return 0;
+    }
+
+    const std::string name = args.GetString("-name", DumpStreamDefaultName);
+    const long long maxFrames = args.GetInt("-frames", 0);
+    const double timeout = args.GetDouble("-timeout", 10.0);
+
+    DumpStreamReader reader;
+    std::vector<std::uint8_t> previousOutput;
+    ImageView previousView;
+    long long framesRead = 0;
+    auto lastActivity = std::chrono::steady_clock::now();
+
+    while (maxFrames == 0 || framesRead < maxFrames)
+    {
+        if (!reader.IsOpen() || !reader.IsProducerAlive())
+        {
+            if (reader.IsOpen())
+            {
+                std::printf("Producer closed the stream\n");
+                reader.Close();
+                previousView = ImageView();
+            }
+            if (reader.Open(name))
+            {
+                std::printf("Connected to '%s', elements mask 0x%x\n", name.c_str(), reader.GetElementsMask());
+                lastActivity = std::chrono::steady_clock::now();
+            }
+        }
+
+        const DumpStreamFrame* frame = reader.IsOpen() ? reader.AcquireFrame() : nullptr;
+        if (frame == nullptr)
+        {
+            const std::chrono::duration<double> idle = std::chrono::steady_clock::now() - lastActivity;
+            if (timeout > 0.0 && idle.count() > timeout)
+            {
+                std::printf("No frames for %.1f s, exiting\n", timeout);
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            continue;
+        }
+        lastActivity = std::chrono::steady_clock::now();
+
+        std::printf("frame %llu jitter (%+.3f, %+.3f):", (unsigned long long)frame->frameIndex,
+            frame->jitterOffsetX, frame->jitterOffsetY);
+
+        if (const DumpStreamElement* element = DumpStreamReader::FindElement(*frame, XESS_DUMP_INPUT_VELOCITY))
+        {
+            const ImageView velocity = DumpStreamReader::GetElementImage(*frame, *element);
+            const float maxLength = (float)std::max(velocity.width, velocity.height);
+            std::printf(" velocity valid %.2f%%", 100.0 * ComputeVelocityValidity(velocity, maxLength));
+        }
+
+        if (const DumpStreamElement* element = DumpStreamReader::FindElement(*frame, XESS_DUMP_OUTPUT))
+        {
+            const ImageView output = DumpStreamReader::GetElementImage(*frame, *element);
+            const double difference = ComputeMeanAbsoluteLumaDifference(previousView, output);
+            if (difference >= 0.0)
+            {
+                std::printf(" output temporal MAD %.5f", difference);
+            }
+
+            // Keep a private copy, the slot is handed back to the producer below
+            const std::size_t size = (std::size_t)output.rowPitch * output.height;
+            if (previousOutput.size() != size)
+            {
+                previousOutput.resize(size);
+            }
+            std::memcpy(previousOutput.data(), output.data, size);
+            previousView = output;
+            previousView.data = previousOutput.data();
+        }
+
+        for (std::uint32_t i = 0; i < frame->elementCount; ++i)
+        {
+            const DumpStreamElement& element = frame->elements[i];
+            std::printf(" [%s %ux%u]", GetDumpElementName(element.element), element.width, element.height);
+        }
+        std::printf(" dropped %llu\n", (unsigned long long)reader.GetDroppedFrameCount());
+
+        reader.ReleaseFrame();
+        framesRead++;
+    }
+
+    return 0;
+}
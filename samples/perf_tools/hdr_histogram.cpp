@@ -0,0 +1,123 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#include "hdr_histogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace
+{
+    std::uint32_t GetMostSignificantBit(std::uint64_t value)
+    {
+        std::uint32_t bit = 0;
+        while (value >>= 1)
+        {
+            bit++;
+        }
+        return bit;
+    }
+}
+
+namespace PerfTools
+{
+void HdrHistogram::Reset()
+{
+    std::memset(m_counts, 0, sizeof(m_counts));
+    m_count = 0;
+    m_sum = 0;
+    m_min = std::numeric_limits<std::uint64_t>::max();
+    m_max = 0;
+}
+
+void HdrHistogram::Record(std::uint64_t value)
+{
+    m_counts[GetBucketIndex(value)]++;
+    m_count++;
+    m_sum += value;
+    m_min = std::min(m_min, value);
+    m_max = std::max(m_max, value);
+}
+
+void HdrHistogram::Merge(const HdrHistogram& other)
+{
+    for (std::uint32_t i = 0; i < BucketCount; ++i)
+    {
+        m_counts[i] += other.m_counts[i];
+    }
+    m_count += other.m_count;
+    m_sum += other.m_sum;
+    m_min = std::min(m_min, other.m_min);
+    m_max = std::max(m_max, other.m_max);
+}
+
+std::uint64_t HdrHistogram::GetPercentile(double percentile) const
+{
+    if (m_count == 0)
+    {
+        return 0;
+    }
+
+    const double clamped = std::min(std::max(percentile, 0.0), 100.0);
+    const std::uint64_t target = std::max<std::uint64_t>(1, (std::uint64_t)std::ceil(clamped / 100.0 * (double)m_count));
+
+    std::uint64_t cumulative = 0;
+    for (std::uint32_t i = 0; i < BucketCount; ++i)
+    {
+        cumulative += m_counts[i];
+        if (cumulative >= target)
+        {
+            // Highest value equivalent to the bucket, never beyond the exact extremes.
+            return std::max(m_min, std::min(GetBucketHighest(i), m_max));
+        }
+    }
+    return m_max;
+}
+
+std::uint32_t HdrHistogram::GetBucketIndex(std::uint64_t value)
+{
+    if (value < (2ull * SubBucketHalfCount))
+    {
+        return (std::uint32_t)value;
+    }
+
+    const std::uint32_t msb = std::min(GetMostSignificantBit(value), MaxValueBits - 1);
+    const std::uint32_t shift = msb - (SubBucketBits - 1);
+    const std::uint64_t subBucket = std::min<std::uint64_t>(value >> shift, 2ull * SubBucketHalfCount - 1);
+    return shift * SubBucketHalfCount + (std::uint32_t)subBucket;
+}
+
+std::uint64_t HdrHistogram::GetBucketLowest(std::uint32_t index)
+{
+    if (index < 2 * SubBucketHalfCount)
+    {
+        return index;
+    }
+
+    const std::uint32_t shift = index / SubBucketHalfCount - 1;
+    const std::uint64_t subBucket = index - shift * SubBucketHalfCount;
+    return subBucket << shift;
+}
+
+std::uint64_t HdrHistogram::GetBucketHighest(std::uint32_t index)
+{
+    if (index == BucketCount - 1)
+    {
+        return std::numeric_limits<std::uint64_t>::max();
+    }
+    return GetBucketLowest(index + 1) - 1;
+}
+}
@@ -0,0 +1,70 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+namespace PerfTools
+{
+/**
+ * Fixed-size log-linear (HDR) histogram of non-negative integer values.
+ *
+ * Values below 2^SubBucketBits are counted exactly. Larger values fall into
+ * buckets whose width doubles with every power of two, each power of two split
+ * into 2^(SubBucketBits - 1) linear sub-buckets, which bounds the relative error
+ * of reported percentiles to 1 / 2^(SubBucketBits - 1). Values of 2^MaxValueBits
+ * and more are counted in the last bucket, the maximum is tracked exactly.
+ * Recording never allocates.
+ */
+class HdrHistogram
+{
+public:
+    static const std::uint32_t SubBucketBits = 7;
+    static const std::uint32_t MaxValueBits = 32;
+    static const std::uint32_t SubBucketHalfCount = 1u << (SubBucketBits - 1);
+    static const std::uint32_t BucketCount = (MaxValueBits - SubBucketBits + 2) * SubBucketHalfCount;
+
+    HdrHistogram() { Reset(); }
+
+    void Reset();
+    void Record(std::uint64_t value);
+
+    /** Adds all values recorded by another histogram. */
+    void Merge(const HdrHistogram& other);
+
+    std::uint64_t GetCount() const { return m_count; }
+    std::uint64_t GetMin() const { return m_count != 0 ? m_min : 0; }
+    std::uint64_t GetMax() const { return m_max; }
+    double GetMean() const { return m_count != 0 ? (double)m_sum / (double)m_count : 0.0; }
+
+    /**
+     * @param percentile - value in [0, 100]
+     * @return value below or at which the given percentage of recorded values lies,
+     * within the bucket precision, 0 for an empty histogram
+     */
+    std::uint64_t GetPercentile(double percentile) const;
+
+private:
+    static std::uint32_t GetBucketIndex(std::uint64_t value);
+    static std::uint64_t GetBucketLowest(std::uint32_t index);
+    static std::uint64_t GetBucketHighest(std::uint32_t index);
+
+    std::uint64_t m_counts[BucketCount];
+    std::uint64_t m_count;
+    std::uint64_t m_sum;
+    std::uint64_t m_min;
+    std::uint64_t m_max;
+};
+}
@@ -0,0 +1,336 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#include "image_metrics.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace
+{
+    float GetLuma(const float rgba[4])
+    {
+        return 0.2126f * rgba[0] + 0.7152f * rgba[1] + 0.0722f * rgba[2];
+    }
+
+    float Saturate(float value)
+    {
+        // Also maps NaN to 0.
+        return value > 0.f ? (value < 1.f ? value : 1.f) : 0.f;
+    }
+
+    bool AreComparable(const PerfTools::ImageView& a, const PerfTools::ImageView& b)
+    {
+        return a.data != nullptr && b.data != nullptr &&
+            PerfTools::GetPixelFormatSize(a.format) != 0 && PerfTools::GetPixelFormatSize(b.format) != 0 &&
+            a.width == b.width && a.height == b.height && a.width != 0 && a.height != 0;
+    }
+
+    /** Decodes clamped luma of the whole image into a tightly packed array. */
+    std::vector<float> DecodeLuma(const PerfTools::ImageView& image)
+    {
+        const std::uint32_t texelSize = PerfTools::GetPixelFormatSize(image.format);
+        std::vector<float> luma((std::size_t)image.width * image.height);
+        for (std::uint32_t y = 0; y < image.height; ++y)
+        {
+            const std::uint8_t* row = image.data + (std::size_t)y * image.rowPitch;
+            for (std::uint32_t x = 0; x < image.width; ++x)
+            {
+                float rgba[4];
+                PerfTools::DecodeTexel(image.format, row + (std::size_t)x * texelSize, rgba);
+                luma[(std::size_t)y * image.width + x] = Saturate(GetLuma(rgba));
+            }
+        }
+        return luma;
+    }
+}
+
+namespace PerfTools
+{
+std::uint32_t GetPixelFormatSize(PixelFormat format)
+{
+    switch (format)
+    {
+    case PixelFormat::R8G8B8A8_UNORM: return 4;
+    case PixelFormat::R10G10B10A2_UNORM: return 4;
+    case PixelFormat::R16G16_FLOAT: return 4;
+    case PixelFormat::R16G16B16A16_FLOAT: return 8;
+    case PixelFormat::R16G16B16A16_UNORM: return 8;
+    case PixelFormat::R32_FLOAT: return 4;
+    default: return 0;
+    }
+}
+
+float HalfToFloat(std::uint16_t value)
+{
+    const std::uint32_t sign = (std::uint32_t)(value & 0x8000u) << 16;
+    std::uint32_t exponent = (value >> 10) & 0x1Fu;
+    std::uint32_t mantissa = value & 0x3FFu;
+
+    std::uint32_t bits;
+    if (exponent == 0x1Fu)
+    {
+        // Inf or NaN
+        bits = sign | 0x7F800000u | (mantissa << 13);
+    }
+    else if (exponent != 0)
+    {
+        bits = sign | ((exponent + 112u) << 23) | (mantissa << 13);
+    }
+    else if (mantissa != 0)
+    {
+        // Denormal, normalize it
+        exponent = 113u;
+        while ((mantissa & 0x400u) == 0)
+        {
+            mantissa <<= 1;
+            exponent--;
+        }
+        bits = sign | (exponent << 23) | ((mantissa & 0x3FFu) << 13);
+    }
+    else
+    {
+        bits = sign;
+    }
+
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+std::uint16_t FloatToHalf(float value)
+{
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    const std::uint16_t sign = (std::uint16_t)((bits >> 16) & 0x8000u);
+    const std::uint32_t exponent = (bits >> 23) & 0xFFu;
+    const std::uint32_t mantissa = bits & 0x7FFFFFu;
+
+    if (exponent == 0xFFu)
+    {
+        return (std::uint16_t)(sign | 0x7C00u | (mantissa ? 0x200u : 0u));
+    }
+
+    const int halfExponent = (int)exponent - 112;
+    if (halfExponent >= 0x1F)
+    {
+        return (std::uint16_t)(sign | 0x7C00u);
+    }
+    if (halfExponent <= 0)
+    {
+        if (halfExponent < -10)
+        {
+            return sign;
+        }
+        const std::uint32_t denormal = (mantissa | 0x800000u) >> (1 - halfExponent);
+        return (std::uint16_t)(sign | ((denormal + 0x1000u) >> 13));
+    }
+
+    // Round to nearest, carry into the exponent is intentional
+    return (std::uint16_t)(sign + (((std::uint32_t)halfExponent << 10) | (mantissa >> 13)) + ((mantissa >> 12) & 1u));
+}
+
+void DecodeTexel(PixelFormat format, const std::uint8_t* texel, float rgba[4])
+{
+    rgba[0] = rgba[1] = rgba[2] = 0.f;
+    rgba[3] = 1.f;
+
+    switch (format)
+    {
+    case PixelFormat::R8G8B8A8_UNORM:
+        for (int c = 0; c < 4; ++c)
+        {
+            rgba[c] = (float)texel[c] / 255.f;
+        }
+        break;
+    case PixelFormat::R10G10B10A2_UNORM:
+    {
+        std::uint32_t value;
+        std::memcpy(&value, texel, sizeof(value));
+        rgba[0] = (float)(value & 0x3FFu) / 1023.f;
+        rgba[1] = (float)((value >> 10) & 0x3FFu) / 1023.f;
+        rgba[2] = (float)((value >> 20) & 0x3FFu) / 1023.f;
+        rgba[3] = (float)(value >> 30) / 3.f;
+        break;
+    }
+    case PixelFormat::R16G16_FLOAT:
+    case PixelFormat::R16G16B16A16_FLOAT:
+    {
+        const int channels = format == PixelFormat::R16G16_FLOAT ? 2 : 4;
+        for (int c = 0; c < channels; ++c)
+        {
+            std::uint16_t value;
+            std::memcpy(&value, texel + c * 2, sizeof(value));
+            rgba[c] = HalfToFloat(value);
+        }
+        break;
+    }
+    case PixelFormat::R16G16B16A16_UNORM:
+        for (int c = 0; c < 4; ++c)
+        {
+            std::uint16_t value;
+            std::memcpy(&value, texel + c * 2, sizeof(value));
+            rgba[c] = (float)value / 65535.f;
+        }
+        break;
+    case PixelFormat::R32_FLOAT:
+        std::memcpy(&rgba[0], texel, sizeof(float));
+        break;
+    default:
+        break;
+    }
+}
+
+double ComputeVelocityValidity(const ImageView& velocity, float maxLength)
+{
+    const std::uint32_t texelSize = GetPixelFormatSize(velocity.format);
+    if (velocity.data == nullptr || texelSize == 0 || velocity.width == 0 || velocity.height == 0)
+    {
+        return 0.0;
+    }
+
+    const float maxLengthSq = maxLength * maxLength;
+    std::uint64_t valid = 0;
+    for (std::uint32_t y = 0; y < velocity.height; ++y)
+    {
+        const std::uint8_t* row = velocity.data + (std::size_t)y * velocity.rowPitch;
+        for (std::uint32_t x = 0; x < velocity.width; ++x)
+        {
+            float rgba[4];
+            DecodeTexel(velocity.format, row + (std::size_t)x * texelSize, rgba);
+            const float lengthSq = rgba[0] * rgba[0] + rgba[1] * rgba[1];
+            if (std::isfinite(lengthSq) && lengthSq <= maxLengthSq)
+            {
+                valid++;
+            }
+        }
+    }
+    return (double)valid / ((double)velocity.width * (double)velocity.height);
+}
+
+double ComputeMeanAbsoluteLumaDifference(const ImageView& a, const ImageView& b)
+{
+    const std::uint32_t sizeA = GetPixelFormatSize(a.format);
+    const std::uint32_t sizeB = GetPixelFormatSize(b.format);
+    if (a.data == nullptr || b.data == nullptr || sizeA == 0 || sizeB == 0 ||
+        a.width != b.width || a.height != b.height || a.width == 0 || a.height == 0)
+    {
+        return -1.0;
+    }
+
+    double sum = 0.0;
+    for (std::uint32_t y = 0; y < a.height; ++y)
+    {
+        const std::uint8_t* rowA = a.data + (std::size_t)y * a.rowPitch;
+        const std::uint8_t* rowB = b.data + (std::size_t)y * b.rowPitch;
+        for (std::uint32_t x = 0; x < a.width; ++x)
+        {
+            float rgbaA[4];
+            float rgbaB[4];
+            DecodeTexel(a.format, rowA + (std::size_t)x * sizeA, rgbaA);
+            DecodeTexel(b.format, rowB + (std::size_t)x * sizeB, rgbaB);
+            sum += std::fabs((double)GetLuma(rgbaA) - (double)GetLuma(rgbaB));
+        }
+    }
+    return sum / ((double)a.width * (double)a.height);
+}
+
+double ComputePsnr(const ImageView& image, const ImageView& reference)
+{
+    if (!AreComparable(image, reference))
+    {
+        return -1.0;
+    }
+
+    const std::uint32_t sizeImage = GetPixelFormatSize(image.format);
+    const std::uint32_t sizeReference = GetPixelFormatSize(reference.format);
+    double sum = 0.0;
+    for (std::uint32_t y = 0; y < image.height; ++y)
+    {
+        const std::uint8_t* rowImage = image.data + (std::size_t)y * image.rowPitch;
+        const std::uint8_t* rowReference = reference.data + (std::size_t)y * reference.rowPitch;
+        for (std::uint32_t x = 0; x < image.width; ++x)
+        {
+            float rgbaImage[4];
+            float rgbaReference[4];
+            DecodeTexel(image.format, rowImage + (std::size_t)x * sizeImage, rgbaImage);
+            DecodeTexel(reference.format, rowReference + (std::size_t)x * sizeReference, rgbaReference);
+            for (int c = 0; c < 3; ++c)
+            {
+                const double difference = (double)Saturate(rgbaImage[c]) - (double)Saturate(rgbaReference[c]);
+                sum += difference * difference;
+            }
+        }
+    }
+
+    const double mse = sum / (3.0 * (double)image.width * (double)image.height);
+    return mse > 0.0 ? -10.0 * std::log10(mse) : std::numeric_limits<double>::infinity();
+}
+
+double ComputeSsim(const ImageView& image, const ImageView& reference)
+{
+    if (!AreComparable(image, reference))
+    {
+        return -2.0;
+    }
+
+    // Constants of the original SSIM paper for a dynamic range of 1.
+    const double c1 = 0.01 * 0.01;
+    const double c2 = 0.03 * 0.03;
+    const std::uint32_t window = 8;
+    const std::uint32_t stride = 4;
+
+    const std::vector<float> lumaImage = DecodeLuma(image);
+    const std::vector<float> lumaReference = DecodeLuma(reference);
+    const std::uint32_t windowWidth = image.width < window ? image.width : window;
+    const std::uint32_t windowHeight = image.height < window ? image.height : window;
+    const double count = (double)windowWidth * windowHeight;
+
+    double sum = 0.0;
+    std::uint64_t windows = 0;
+    for (std::uint32_t wy = 0; wy + windowHeight <= image.height; wy += stride)
+    {
+        for (std::uint32_t wx = 0; wx + windowWidth <= image.width; wx += stride)
+        {
+            double sumA = 0.0, sumB = 0.0, sumAA = 0.0, sumBB = 0.0, sumAB = 0.0;
+            for (std::uint32_t y = wy; y < wy + windowHeight; ++y)
+            {
+                for (std::uint32_t x = wx; x < wx + windowWidth; ++x)
+                {
+                    const double a = lumaImage[(std::size_t)y * image.width + x];
+                    const double b = lumaReference[(std::size_t)y * image.width + x];
+                    sumA += a;
+                    sumB += b;
+                    sumAA += a * a;
+                    sumBB += b * b;
+                    sumAB += a * b;
+                }
+            }
+
+            const double meanA = sumA / count;
+            const double meanB = sumB / count;
+            const double varianceA = sumAA / count - meanA * meanA;
+            const double varianceB = sumBB / count - meanB * meanB;
+            const double covariance = sumAB / count - meanA * meanB;
+            sum += ((2.0 * meanA * meanB + c1) * (2.0 * covariance + c2)) /
+                ((meanA * meanA + meanB * meanB + c1) * (varianceA + varianceB + c2));
+            windows++;
+        }
+    }
+    return sum / (double)windows;
+}
+}
@@ -0,0 +1,91 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+namespace PerfTools
+{
+/** Pixel formats of CPU side image copies understood by the metrics. */
+enum class PixelFormat : std::uint32_t
+{
+    Unknown = 0,
+    R8G8B8A8_UNORM = 1,
+    R10G10B10A2_UNORM = 2,
+    R16G16_FLOAT = 3,
+    R16G16B16A16_FLOAT = 4,
+    R16G16B16A16_UNORM = 5,
+    R32_FLOAT = 6,
+};
+
+/** Non-owning view of a CPU side image. */
+struct ImageView
+{
+    PixelFormat format = PixelFormat::Unknown;
+    std::uint32_t width = 0;
+    std::uint32_t height = 0;
+    /** Bytes between the starts of two consecutive rows. */
+    std::uint32_t rowPitch = 0;
+    const std::uint8_t* data = nullptr;
+};
+
+/** @return size of one texel in bytes, 0 for unknown formats */
+std::uint32_t GetPixelFormatSize(PixelFormat format);
+
+float HalfToFloat(std::uint16_t value);
+std::uint16_t FloatToHalf(float value);
+
+/**
+ * Decodes one texel into RGBA floats. Missing channels are set to 0, missing alpha to 1.
+ * @param format - texel format
+ * @param texel - pointer to the first byte of the texel
+ * @param rgba - decoded value
+ */
+void DecodeTexel(PixelFormat format, const std::uint8_t* texel, float rgba[4]);
+
+/**
+ * Fraction of velocity texels that are finite and not longer than maxLength pixels.
+ * @param velocity - two channel velocity image in pixels
+ * @param maxLength - longest plausible motion vector
+ * @return value in [0, 1], 0 for empty images
+ */
+double ComputeVelocityValidity(const ImageView& velocity, float maxLength);
+
+/**
+ * Mean absolute difference of Rec.709 luma between two images of equal size.
+ * Applied to consecutive upscaled outputs of a static or slowly moving scene it
+ * estimates temporal instability (flicker and ghosting trails).
+ * @return mean difference, negative if the images are not comparable
+ */
+double ComputeMeanAbsoluteLumaDifference(const ImageView& a, const ImageView& b);
+
+/**
+ * Peak signal-to-noise ratio of the RGB channels against a reference of equal
+ * size. Channels are clamped to [0, 1], the peak is 1.
+ * @param image - image to rate, e.g. an upscaled output
+ * @param reference - ground truth, e.g. a supersampled render of the same frame
+ * @return PSNR in dB, infinity for identical images, negative if the images are not comparable
+ */
+double ComputePsnr(const ImageView& image, const ImageView& reference);
+
+/**
+ * Structural similarity of Rec.709 luma against a reference of equal size,
+ * averaged over 8x8 windows placed every 4 pixels. Luma is clamped to [0, 1].
+ * @param image - image to rate
+ * @param reference - ground truth
+ * @return SSIM in [-1, 1], 1 for identical images, below -1 if the images are not comparable
+ */
+double ComputeSsim(const ImageView& image, const ImageView& reference);
+}
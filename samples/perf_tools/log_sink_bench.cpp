@@ -0,0 +1,234 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+// Benchmark of the asynchronous log sink. Producer threads log like a runtime
+// with verbose logging, a mix of distinct and repeated messages, into a writer
+// that simulates slow output such as OutputDebugStringA under a debugger. Runs
+// once with the writer called synchronously by the producers, as the samples'
+// LogCallback did, and once through AsyncLogSink, and reports how long the
+// producers are blocked per message. Exits with 1 if messages are unaccounted.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "async_log_sink.h"
+#include "command_line.h"
+#include "hdr_histogram.h"
+
+using namespace PerfTools;
+
+namespace
+{
+    void PrintUsage()
+    {
+        std::printf("Usage: log_sink_bench [-threads <count>] [-messages <per thread>] [-interval_us <us>]\n"
+            "    [-repeat_ratio <0..1>] [-write_us <us>] [-capacity <messages>] [-max_repeats <count>]\n"
+            "    [-output <file>] [-allow_drops]\n");
+    }
+
+    /** Stands in for the output device, each line costs writeUs and goes to the file if one is open. */
+    class SlowWriter
+    {
+    public:
+        SlowWriter(double writeUs, FILE* file) : m_writeUs(writeUs), m_file(file) {}
+
+        void Write(const char* line)
+        {
+            if (m_file != nullptr)
+            {
+                std::fputs(line, m_file);
+            }
+            if (m_writeUs > 0.0)
+            {
+                const auto end = std::chrono::steady_clock::now() +
+                    std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                        std::chrono::duration<double, std::micro>(m_writeUs));
+                while (std::chrono::steady_clock::now() < end)
+                {
+                }
+            }
+            m_lines++;
+        }
+
+        std::uint64_t GetLines() const { return m_lines; }
+
+    private:
+        double m_writeUs;
+        FILE* m_file;
+        std::uint64_t m_lines = 0;
+    };
+
+    struct Options
+    {
+        std::uint32_t threads;
+        std::uint32_t messages;
+        double intervalUs;
+        double repeatRatio;
+    };
+
+    /**
+     * Runs the producer threads.
+     * @param log - called for every message, measured
+     * @return latency of the log calls [ns]
+     */
+    template <typename LogFunction>
+    HdrHistogram RunProducers(const Options& options, LogFunction log, double& seconds)
+    {
+        std::vector<HdrHistogram> histograms(options.threads);
+        std::vector<std::thread> threads;
+        const auto start = std::chrono::steady_clock::now();
+        for (std::uint32_t t = 0; t < options.threads; ++t)
+        {
+            threads.emplace_back([&, t] {
+                const auto interval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                    std::chrono::duration<double, std::micro>(options.intervalUs));
+                auto next = std::chrono::steady_clock::now();
+                const std::uint32_t repeatEvery =
+                    options.repeatRatio > 0.0 ? std::max((std::uint32_t)(1.0 / options.repeatRatio + 0.5), 1u) : 0;
+                char message[128];
+                for (std::uint32_t i = 0; i < options.messages; ++i)
+                {
+                    if (repeatEvery != 0 && i % repeatEvery == 0)
+                    {
+                        std::snprintf(message, sizeof(message), "Resource state of the output texture does not match");
+                    }
+                    else
+                    {
+                        std::snprintf(message, sizeof(message), "Thread %u recorded dispatch %u of the upscaling pass", t, i);
+                    }
+                    const auto logStart = std::chrono::steady_clock::now();
+                    log(message);
+                    histograms[t].Record((std::uint64_t)(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::steady_clock::now() - logStart).count()));
+                    if (options.intervalUs > 0.0)
+                    {
+                        next += interval;
+                        std::this_thread::sleep_until(next);
+                    }
+                }
+            });
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        HdrHistogram merged;
+        for (const HdrHistogram& histogram : histograms)
+        {
+            merged.Merge(histogram);
+        }
+        return merged;
+    }
+
+    void PrintRun(const char* name, const HdrHistogram& latency, double producerSeconds, std::uint64_t lines,
+        std::uint64_t dropped)
+    {
+        const std::uint64_t count = latency.GetCount();
+        std::printf("%-6s %10llu %9.3f %10llu %10llu %12llu %10llu %12.2f\n", name, (unsigned long long)count,
+            producerSeconds, (unsigned long long)latency.GetPercentile(50.0),
+            (unsigned long long)latency.GetPercentile(99.0), (unsigned long long)latency.GetMax(),
+            (unsigned long long)lines, count > 0 ? 100.0 * (double)dropped / (double)count : 0.0);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    CommandLine args(argc, argv);
+    if (args.IsSet("-help"))
+    {
+        PrintUsage();
+        return 0;
+    }
+
+    Options options;
+    options.threads = (std::uint32_t)std::min(std::max(args.GetInt("-threads", 4), 1ll), 64ll);
+    options.messages = (std::uint32_t)std::max(args.GetInt("-messages", 5000), 1ll);
+    // Paced like a verbose runtime, 20000 messages per second in total by default. Flooding with -interval_us 0
+    // outruns any writer and only measures how fast messages are dropped.
+    options.intervalUs = std::max(args.GetDouble("-interval_us", 200.0), 0.0);
+    options.repeatRatio = std::min(std::max(args.GetDouble("-repeat_ratio", 0.25), 0.0), 1.0);
+    const double writeUs = std::max(args.GetDouble("-write_us", 20.0), 0.0);
+    const std::uint32_t capacity = (std::uint32_t)std::max(args.GetInt("-capacity", 4096), 2ll);
+    const std::uint32_t maxRepeats = (std::uint32_t)std::max(args.GetInt("-max_repeats", 5), 0ll);
+
+    FILE* file = nullptr;
+    const std::string output = args.GetString("-output", "");
+    if (!output.empty() && (file = std::fopen(output.c_str(), "w")) == nullptr)
+    {
+        std::fprintf(stderr, "Cannot open %s\n", output.c_str());
+        return 1;
+    }
+
+    std::printf("%-6s %10s %9s %10s %10s %12s %10s %12s\n", "run", "messages", "time [s]", "p50 [ns]", "p99 [ns]",
+        "max [ns]", "lines", "dropped [%]");
+
+    // Synchronous, the producers wait for the output like the samples' LogCallback.
+    SlowWriter syncWriter(writeUs, file);
+    std::mutex writerMutex;
+    double syncSeconds = 0.0;
+    const HdrHistogram syncLatency = RunProducers(options, [&](const char* message) {
+        const std::string line = std::string("[XeSS-SR Runtime][0]: ") + message + "\n";
+        std::lock_guard<std::mutex> lock(writerMutex);
+        syncWriter.Write(line.c_str());
+    }, syncSeconds);
+    PrintRun("sync", syncLatency, syncSeconds, syncWriter.GetLines(), 0);
+
+    // Asynchronous, the producers only copy the message into the ring.
+    SlowWriter asyncWriter(writeUs, file);
+    AsyncLogSink sink(capacity);
+    sink.SetRateLimit(maxRepeats, 1000);
+    sink.Start([&](const char* line) { asyncWriter.Write(line); });
+    AsyncLogSink::SetInstance(&sink);
+    double asyncSeconds = 0.0;
+    const HdrHistogram asyncLatency = RunProducers(options, [](const char* message) {
+        AsyncLogSink::XessLogCallback(message, XESS_LOGGING_LEVEL_DEBUG);
+    }, asyncSeconds);
+    const auto drainStart = std::chrono::steady_clock::now();
+    sink.Stop();
+    AsyncLogSink::SetInstance(nullptr);
+    const double drainSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - drainStart).count();
+    const LogSinkStatistics statistics = sink.GetStatistics();
+    PrintRun("async", asyncLatency, asyncSeconds, asyncWriter.GetLines(), statistics.dropped);
+    std::printf("Drained in %.3f s after the producers finished.\n", drainSeconds);
+    std::printf("%s", sink.FormatReport().c_str());
+
+    if (file != nullptr)
+    {
+        std::fclose(file);
+    }
+
+    // Every message is written, suppressed or dropped, summaries add lines of their own.
+    const std::uint64_t expected = (std::uint64_t)options.threads * options.messages;
+    if (statistics.posted != expected || statistics.written + statistics.suppressed + statistics.dropped != expected ||
+        asyncWriter.GetLines() < statistics.written)
+    {
+        std::fprintf(stderr, "Messages unaccounted for\n");
+        return 1;
+    }
+    // Latencies of a run that drops messages are not comparable with the synchronous run.
+    if (statistics.dropped != 0 && !args.IsSet("-allow_drops"))
+    {
+        std::fprintf(stderr, "%llu messages dropped, raise -capacity or -interval_us, or pass -allow_drops\n",
+            (unsigned long long)statistics.dropped);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,254 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#include "parameter_block.h"
+
+#include <sstream>
+
+namespace
+{
+    void ToArray(const PerfTools::XessParameters& parameters, float (&values)[6])
+    {
+        values[0] = parameters.velocityScale[0];
+        values[1] = parameters.velocityScale[1];
+        values[2] = parameters.jitterScale[0];
+        values[3] = parameters.jitterScale[1];
+        values[4] = parameters.exposureMultiplier;
+        values[5] = parameters.maxResponsiveMaskValue;
+    }
+
+    void FromArray(const float (&values)[6], PerfTools::XessParameters& parameters)
+    {
+        parameters.velocityScale[0] = values[0];
+        parameters.velocityScale[1] = values[1];
+        parameters.jitterScale[0] = values[2];
+        parameters.jitterScale[1] = values[3];
+        parameters.exposureMultiplier = values[4];
+        parameters.maxResponsiveMaskValue = values[5];
+    }
+
+    /** @return XessParameterBits of the fields that differ */
+    std::uint32_t Compare(const PerfTools::XessParameters& a, const PerfTools::XessParameters& b)
+    {
+        std::uint32_t changed = 0;
+        if (a.velocityScale[0] != b.velocityScale[0] || a.velocityScale[1] != b.velocityScale[1])
+        {
+            changed |= PerfTools::XessParameterVelocityScale;
+        }
+        if (a.jitterScale[0] != b.jitterScale[0] || a.jitterScale[1] != b.jitterScale[1])
+        {
+            changed |= PerfTools::XessParameterJitterScale;
+        }
+        if (a.exposureMultiplier != b.exposureMultiplier)
+        {
+            changed |= PerfTools::XessParameterExposureMultiplier;
+        }
+        if (a.maxResponsiveMaskValue != b.maxResponsiveMaskValue)
+        {
+            changed |= PerfTools::XessParameterMaxResponsiveMaskValue;
+        }
+        return changed;
+    }
+}
+
+namespace PerfTools
+{
+XessParameterBlock::XessParameterBlock()
+{
+    // Version 0 holds the defaults.
+    float values[6];
+    ToArray(XessParameters(), values);
+    for (std::uint32_t i = 0; i < 6; i++)
+    {
+        m_slots[0].values[i].store(values[i], std::memory_order_relaxed);
+    }
+    m_slots[0].sequence.store(2, std::memory_order_release);
+}
+
+void XessParameterBlock::Update(const XessParameters& values, std::uint32_t fieldMask)
+{
+    for (;;)
+    {
+        const std::uint64_t base = m_latest.load(std::memory_order_acquire);
+        XessParameters parameters;
+        if (!ReadSlot(base, parameters))
+        {
+            m_readRetries.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        if (fieldMask & XessParameterVelocityScale)
+        {
+            parameters.velocityScale[0] = values.velocityScale[0];
+            parameters.velocityScale[1] = values.velocityScale[1];
+        }
+        if (fieldMask & XessParameterJitterScale)
+        {
+            parameters.jitterScale[0] = values.jitterScale[0];
+            parameters.jitterScale[1] = values.jitterScale[1];
+        }
+        if (fieldMask & XessParameterExposureMultiplier)
+        {
+            parameters.exposureMultiplier = values.exposureMultiplier;
+        }
+        if (fieldMask & XessParameterMaxResponsiveMaskValue)
+        {
+            parameters.maxResponsiveMaskValue = values.maxResponsiveMaskValue;
+        }
+
+        // Claim a slot that is neither being written nor able to become the latest version. The latest
+        // version only grows and a writer publishes only on top of the version it started from, so
+        // versions older than the latest one are never published and their slots can be reused.
+        // At most one slot per writer plus the latest one are unavailable.
+        std::uint64_t version = 0;
+        Slot* slot = nullptr;
+        for (;;)
+        {
+            version = m_nextVersion.fetch_add(1, std::memory_order_relaxed);
+            slot = &m_slots[version & (SlotCount - 1)];
+            std::uint64_t sequence = slot->sequence.load(std::memory_order_relaxed);
+            if ((sequence & 1) != 0)
+            {
+                continue;
+            }
+            const bool reusable = sequence == 0 || sequence / 2 - 1 < m_latest.load(std::memory_order_acquire);
+            if (reusable && slot->sequence.compare_exchange_strong(sequence, 2 * version + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+
+        float slotValues[6];
+        ToArray(parameters, slotValues);
+        for (std::uint32_t i = 0; i < 6; i++)
+        {
+            slot->values[i].store(slotValues[i], std::memory_order_relaxed);
+        }
+        slot->sequence.store(2 * version + 2, std::memory_order_release);
+
+        std::uint64_t expected = base;
+        if (m_latest.compare_exchange_strong(expected, version, std::memory_order_acq_rel))
+        {
+            m_updates.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        // Another writer published first, apply the fields on top of its version.
+        m_writerRetries.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void XessParameterBlock::SetVelocityScale(float x, float y)
+{
+    XessParameters values;
+    values.velocityScale[0] = x;
+    values.velocityScale[1] = y;
+    Update(values, XessParameterVelocityScale);
+}
+
+void XessParameterBlock::SetJitterScale(float x, float y)
+{
+    XessParameters values;
+    values.jitterScale[0] = x;
+    values.jitterScale[1] = y;
+    Update(values, XessParameterJitterScale);
+}
+
+void XessParameterBlock::SetExposureMultiplier(float scale)
+{
+    XessParameters values;
+    values.exposureMultiplier = scale;
+    Update(values, XessParameterExposureMultiplier);
+}
+
+void XessParameterBlock::SetMaxResponsiveMaskValue(float value)
+{
+    XessParameters values;
+    values.maxResponsiveMaskValue = value;
+    Update(values, XessParameterMaxResponsiveMaskValue);
+}
+
+std::uint64_t XessParameterBlock::Read(XessParameters& parameters) const
+{
+    for (;;)
+    {
+        const std::uint64_t version = m_latest.load(std::memory_order_acquire);
+        if (ReadSlot(version, parameters))
+        {
+            return version;
+        }
+        m_readRetries.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+std::uint32_t XessParameterBlock::Consume(XessParameters& parameters)
+{
+    Read(parameters);
+    const std::uint32_t changed = m_consumedValid ? Compare(parameters, m_consumed) : std::uint32_t(XessParameterAll);
+    m_consumed = parameters;
+    m_consumedValid = true;
+    if (changed != 0)
+    {
+        m_consumedCount++;
+    }
+    return changed;
+}
+
+void XessParameterBlock::Invalidate()
+{
+    m_consumedValid = false;
+}
+
+ParameterBlockStatistics XessParameterBlock::GetStatistics() const
+{
+    ParameterBlockStatistics statistics;
+    statistics.updates = m_updates.load(std::memory_order_relaxed);
+    statistics.writerRetries = m_writerRetries.load(std::memory_order_relaxed);
+    statistics.consumed = m_consumedCount;
+    statistics.readRetries = m_readRetries.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+std::string XessParameterBlock::FormatReport() const
+{
+    const ParameterBlockStatistics statistics = GetStatistics();
+    std::ostringstream report;
+    report << "XeSS parameter block: updates " << statistics.updates << ", writer retries " << statistics.writerRetries
+           << ", consumed " << statistics.consumed << ", read retries " << statistics.readRetries << "\n";
+    return report.str();
+}
+
+bool XessParameterBlock::ReadSlot(std::uint64_t version, XessParameters& parameters) const
+{
+    const Slot& slot = m_slots[version & (SlotCount - 1)];
+    const std::uint64_t sequence = 2 * version + 2;
+    if (slot.sequence.load(std::memory_order_acquire) != sequence)
+    {
+        return false;
+    }
+    float values[6];
+    for (std::uint32_t i = 0; i < 6; i++)
+    {
+        values[i] = slot.values[i].load(std::memory_order_relaxed);
+    }
+    // Orders the value loads before the second sequence load, a writer that reused the slot meanwhile changed it.
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != sequence)
+    {
+        return false;
+    }
+    FromArray(values, parameters);
+    return true;
+}
+}
@@ -0,0 +1,144 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "xess/xess.h"
+
+namespace PerfTools
+{
+/** Values of the XeSS-SR state setters, the defaults are the values of a new context. */
+struct XessParameters
+{
+    /** xessSetVelocityScale */
+    float velocityScale[2] = {1.0f, 1.0f};
+    /** xessSetJitterScale */
+    float jitterScale[2] = {1.0f, 1.0f};
+    /** xessSetExposureMultiplier */
+    float exposureMultiplier = 1.0f;
+    /** xessSetMaxResponsiveMaskValue */
+    float maxResponsiveMaskValue = 0.8f;
+};
+
+/** Bits of the fields of XessParameters, used to select the fields of an update and to report changes. */
+enum XessParameterBits : std::uint32_t
+{
+    XessParameterVelocityScale = 1u << 0,
+    XessParameterJitterScale = 1u << 1,
+    XessParameterExposureMultiplier = 1u << 2,
+    XessParameterMaxResponsiveMaskValue = 1u << 3,
+    XessParameterAll = 0xfu,
+};
+
+struct ParameterBlockStatistics
+{
+    /** Published updates. */
+    std::uint64_t updates = 0;
+    /** Updates that had to be rebuilt because another writer published first. */
+    std::uint64_t writerRetries = 0;
+    /** Consume calls that saw a new version. */
+    std::uint64_t consumed = 0;
+    /** Reads that were torn by a writer reusing the slot and had to be repeated. */
+    std::uint64_t readRetries = 0;
+};
+
+/**
+ * Publishes XeSS-SR state from any number of threads to the render thread.
+ *
+ * Every version of the parameters lives in its own slot of a fixed ring, each
+ * slot guarded by a sequence counter like a seqlock. A writer copies the latest
+ * version, changes the selected fields, writes the result into a free slot and
+ * publishes it with a compare and swap of the latest version. If another writer
+ * published first, the update is rebuilt on top of that version, so concurrent
+ * updates of different fields are never lost. Writers never block, wait for the
+ * reader or call into the XeSS library.
+ *
+ * The render thread calls Consume once per frame, before the execute call is
+ * recorded, and passes the changed fields to the xessSet* functions. All fields
+ * of one update become visible in the same frame.
+ */
+class XessParameterBlock
+{
+public:
+    XessParameterBlock();
+
+    XessParameterBlock(const XessParameterBlock&) = delete;
+    XessParameterBlock& operator=(const XessParameterBlock&) = delete;
+
+    /**
+     * Publishes the selected fields, any thread.
+     * @param values - new values, only the fields selected by fieldMask are used
+     * @param fieldMask - XessParameterBits
+     */
+    void Update(const XessParameters& values, std::uint32_t fieldMask);
+
+    void SetVelocityScale(float x, float y);
+    void SetJitterScale(float x, float y);
+    void SetExposureMultiplier(float scale);
+    void SetMaxResponsiveMaskValue(float value);
+
+    /**
+     * Reads the latest version, any thread.
+     * @return version number, increasing with every published update
+     */
+    std::uint64_t Read(XessParameters& parameters) const;
+
+    /**
+     * Reads the latest version on the render thread and compares it with the
+     * version returned by the previous call.
+     * @param parameters - receives the latest values
+     * @return XessParameterBits of the fields that differ from the previous call,
+     * all bits on the first call
+     */
+    std::uint32_t Consume(XessParameters& parameters);
+
+    /** Makes the next Consume report all fields, e.g. after the context was recreated. */
+    void Invalidate();
+
+    ParameterBlockStatistics GetStatistics() const;
+    std::string FormatReport() const;
+
+    /** Versions that can be written before a slot is reused, a power of two. */
+    static const std::uint32_t SlotCount = 64;
+
+private:
+    struct alignas(64) Slot
+    {
+        // 2 * version + 1 while the slot is written, 2 * version + 2 once it holds the version.
+        std::atomic<std::uint64_t> sequence{0};
+        // Fields of XessParameters in declaration order.
+        std::atomic<float> values[6];
+    };
+
+    /** @return false if the slot no longer holds the version */
+    bool ReadSlot(std::uint64_t version, XessParameters& parameters) const;
+
+    Slot m_slots[SlotCount];
+    alignas(64) std::atomic<std::uint64_t> m_latest{0};
+    alignas(64) std::atomic<std::uint64_t> m_nextVersion{1};
+
+    alignas(64) std::atomic<std::uint64_t> m_updates{0};
+    std::atomic<std::uint64_t> m_writerRetries{0};
+    mutable std::atomic<std::uint64_t> m_readRetries{0};
+
+    // Render thread only.
+    XessParameters m_consumed;
+    bool m_consumedValid = false;
+    std::uint64_t m_consumedCount = 0;
+};
+}
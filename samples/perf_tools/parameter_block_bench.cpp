@@ -0,0 +1,289 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+// Contention benchmark of the XeSS parameter block. For every writer count,
+// writer threads publish updates as fast as they can, or at a fixed interval,
+// while a render thread consumes the block once per frame. The same load runs
+// against a mutex protected block for comparison. Reports the update and
+// consume latencies and checks that the render thread never sees a torn update
+// and that concurrent updates of different fields are not lost. Exits with 1
+// on a violation.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "command_line.h"
+#include "hdr_histogram.h"
+#include "parameter_block.h"
+
+using namespace PerfTools;
+
+namespace
+{
+    void PrintUsage()
+    {
+        std::printf("Usage: parameter_block_bench [-writers <count,...>] [-duration_ms <ms>] [-frame_us <us>]\n"
+            "    [-write_us <us>]\n");
+    }
+
+    /** Baseline with the same interface, every update and read takes the mutex. */
+    class MutexParameterBlock
+    {
+    public:
+        void Update(const XessParameters& values, std::uint32_t fieldMask)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (fieldMask & XessParameterVelocityScale)
+            {
+                m_parameters.velocityScale[0] = values.velocityScale[0];
+                m_parameters.velocityScale[1] = values.velocityScale[1];
+            }
+            if (fieldMask & XessParameterJitterScale)
+            {
+                m_parameters.jitterScale[0] = values.jitterScale[0];
+                m_parameters.jitterScale[1] = values.jitterScale[1];
+            }
+            if (fieldMask & XessParameterExposureMultiplier)
+            {
+                m_parameters.exposureMultiplier = values.exposureMultiplier;
+            }
+            if (fieldMask & XessParameterMaxResponsiveMaskValue)
+            {
+                m_parameters.maxResponsiveMaskValue = values.maxResponsiveMaskValue;
+            }
+            m_version++;
+        }
+
+        std::uint64_t Read(XessParameters& parameters) const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            parameters = m_parameters;
+            return m_version;
+        }
+
+    private:
+        mutable std::mutex m_mutex;
+        XessParameters m_parameters;
+        std::uint64_t m_version = 0;
+    };
+
+    XessParameters Uniform(float value)
+    {
+        XessParameters parameters;
+        parameters.velocityScale[0] = parameters.velocityScale[1] = value;
+        parameters.jitterScale[0] = parameters.jitterScale[1] = value;
+        parameters.exposureMultiplier = value;
+        parameters.maxResponsiveMaskValue = value;
+        return parameters;
+    }
+
+    bool IsUniform(const XessParameters& parameters)
+    {
+        const float value = parameters.velocityScale[0];
+        return parameters.velocityScale[1] == value && parameters.jitterScale[0] == value &&
+            parameters.jitterScale[1] == value && parameters.exposureMultiplier == value &&
+            parameters.maxResponsiveMaskValue == value;
+    }
+
+    float GetField(const XessParameters& parameters, std::uint32_t field, std::uint32_t component)
+    {
+        switch (field)
+        {
+        case 0:
+            return parameters.velocityScale[component];
+        case 1:
+            return parameters.jitterScale[component];
+        case 2:
+            return parameters.exposureMultiplier;
+        default:
+            return parameters.maxResponsiveMaskValue;
+        }
+    }
+
+    std::uint64_t ElapsedNs(std::chrono::steady_clock::time_point start)
+    {
+        return std::uint64_t(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+    }
+
+    struct RunResult
+    {
+        HdrHistogram update;
+        HdrHistogram consume;
+        double seconds = 0.0;
+        std::uint64_t frames = 0;
+        std::uint64_t tornReads = 0;
+        std::uint64_t lostUpdates = 0;
+    };
+
+    template <typename Block>
+    void Run(Block& block, std::uint32_t writers, double durationMs, double frameUs, double writeUs, RunResult& result)
+    {
+        // The defaults are not uniform.
+        block.Update(Uniform(0.0f), XessParameterAll);
+
+        std::atomic<bool> stop{false};
+        std::vector<HdrHistogram> histograms(writers);
+        std::vector<std::thread> threads;
+        const auto start = std::chrono::steady_clock::now();
+        for (std::uint32_t w = 0; w < writers; w++)
+        {
+            threads.emplace_back([&, w] {
+                const auto interval = std::chrono::duration<double, std::micro>(writeUs);
+                auto next = std::chrono::steady_clock::now();
+                // Distinct per writer and exact in a float.
+                std::uint32_t counter = 0;
+                while (!stop.load(std::memory_order_relaxed))
+                {
+                    const XessParameters values = Uniform(float((counter++ & 0x7FFFF) * 16 + w));
+                    const auto updateStart = std::chrono::steady_clock::now();
+                    block.Update(values, XessParameterAll);
+                    histograms[w].Record(ElapsedNs(updateStart));
+                    if (writeUs > 0.0)
+                    {
+                        next += std::chrono::duration_cast<std::chrono::steady_clock::duration>(interval);
+                        std::this_thread::sleep_until(next);
+                    }
+                }
+            });
+        }
+
+        // Render thread, reads the block once per frame.
+        const auto end = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double, std::milli>(durationMs));
+        while (std::chrono::steady_clock::now() < end)
+        {
+            XessParameters parameters;
+            const auto consumeStart = std::chrono::steady_clock::now();
+            block.Read(parameters);
+            result.consume.Record(ElapsedNs(consumeStart));
+            result.frames++;
+            if (!IsUniform(parameters))
+            {
+                result.tornReads++;
+            }
+            std::this_thread::sleep_for(std::chrono::duration<double, std::micro>(frameUs));
+        }
+        stop = true;
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        for (const HdrHistogram& histogram : histograms)
+        {
+            result.update.Merge(histogram);
+        }
+
+        // Every writer updates a single field at once, writer w the field w % 4 with -(w + 1). Each field written
+        // must end up with the value of one of its writers, an update built on a stale version would restore
+        // the uniform value.
+        std::atomic<std::uint32_t> ready{0};
+        threads.clear();
+        for (std::uint32_t w = 0; w < writers; w++)
+        {
+            threads.emplace_back([&, w] {
+                XessParameters values = Uniform(-float(w + 1));
+                ready.fetch_add(1);
+                while (ready.load() < writers)
+                {
+                }
+                block.Update(values, 1u << (w % 4));
+            });
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+        XessParameters parameters;
+        block.Read(parameters);
+        for (std::uint32_t field = 0; field < std::min(writers, 4u); field++)
+        {
+            for (std::uint32_t component = 0; component < 2; component++)
+            {
+                const float value = GetField(parameters, field, component);
+                if (!(value < 0.0f && std::uint32_t(-value - 1.0f) % 4 == field))
+                {
+                    result.lostUpdates++;
+                }
+            }
+        }
+    }
+
+    void PrintRun(const char* name, std::uint32_t writers, const RunResult& result, std::uint64_t retries)
+    {
+        const std::uint64_t updates = result.update.GetCount();
+        std::printf("%-9s %7u %12.0f %8.3f %9llu %9llu %10llu %9llu %9llu %6llu %5llu\n", name, writers,
+            updates / result.seconds, updates > 0 ? double(retries) / updates : 0.0,
+            (unsigned long long)result.update.GetPercentile(50.0), (unsigned long long)result.update.GetPercentile(99.0),
+            (unsigned long long)result.update.GetMax(), (unsigned long long)result.consume.GetPercentile(99.0),
+            (unsigned long long)result.consume.GetMax(), (unsigned long long)result.tornReads,
+            (unsigned long long)result.lostUpdates);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    CommandLine args(argc, argv);
+    if (args.IsSet("-help"))
+    {
+        PrintUsage();
+        return 0;
+    }
+
+    std::vector<std::uint32_t> writerCounts;
+    std::stringstream list(args.GetString("-writers", "1,2,4,8,16"));
+    std::string item;
+    while (std::getline(list, item, ','))
+    {
+        const long long count = std::atoll(item.c_str());
+        if (count < 1 || count > 64)
+        {
+            PrintUsage();
+            return 1;
+        }
+        writerCounts.push_back(std::uint32_t(count));
+    }
+    const double durationMs = std::max(args.GetDouble("-duration_ms", 500.0), 1.0);
+    const double frameUs = std::max(args.GetDouble("-frame_us", 1000.0), 0.0);
+    const double writeUs = std::max(args.GetDouble("-write_us", 0.0), 0.0);
+
+    std::printf("%-9s %7s %12s %8s %9s %9s %10s %9s %9s %6s %5s\n", "block", "writers", "updates/s", "retries",
+        "upd p50", "upd p99", "upd max", "read p99", "read max", "torn", "lost");
+    bool valid = true;
+    for (std::uint32_t writers : writerCounts)
+    {
+        XessParameterBlock lockFree;
+        RunResult lockFreeResult;
+        Run(lockFree, writers, durationMs, frameUs, writeUs, lockFreeResult);
+        PrintRun("lock-free", writers, lockFreeResult, lockFree.GetStatistics().writerRetries);
+
+        MutexParameterBlock mutex;
+        RunResult mutexResult;
+        Run(mutex, writers, durationMs, frameUs, writeUs, mutexResult);
+        PrintRun("mutex", writers, mutexResult, 0);
+
+        valid = valid && lockFreeResult.tornReads == 0 && lockFreeResult.lostUpdates == 0 &&
+            mutexResult.tornReads == 0 && mutexResult.lostUpdates == 0;
+    }
+    std::printf("Latencies in ns, retries per update.\n");
+    return valid ? 0 : 1;
+}
@@ -0,0 +1,80 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#include "pass_name_table.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace PerfTools
+{
+std::uint32_t PassNameTable::Intern(const char* name, bool* isNew)
+{
+    if (isNew != nullptr)
+    {
+        *isNew = false;
+    }
+
+    const std::uint32_t id = Find(name);
+    if (id != InvalidId || m_count == MaxNames)
+    {
+        return id;
+    }
+
+    std::snprintf(m_names[m_count], MaxNameLength, "%s", name != nullptr ? name : "unnamed");
+    if (isNew != nullptr)
+    {
+        *isNew = true;
+    }
+    return m_count++;
+}
+
+std::uint32_t PassNameTable::Find(const char* name) const
+{
+    if (name == nullptr)
+    {
+        name = "unnamed";
+    }
+
+    // Names longer than the storage are matched by their stored prefix.
+    for (std::uint32_t i = 0; i < m_count; ++i)
+    {
+        if (std::strncmp(m_names[i], name, MaxNameLength - 1) == 0)
+        {
+            return i;
+        }
+    }
+    return InvalidId;
+}
+
+bool PassNameTable::Define(std::uint32_t id, const char* name)
+{
+    if (id >= MaxNames)
+    {
+        return false;
+    }
+
+    std::snprintf(m_names[id], MaxNameLength, "%s", name);
+    if (id >= m_count)
+    {
+        m_count = id + 1;
+    }
+    return true;
+}
+
+const char* PassNameTable::GetName(std::uint32_t id) const
+{
+    return (id < m_count && m_names[id][0] != '\0') ? m_names[id] : "unknown";
+}
+}
@@ -0,0 +1,60 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+namespace PerfTools
+{
+/**
+ * Interns profiling pass names into small stable IDs.
+ *
+ * xess_profiled_frame_data_t names are owned by the XeSS context and only valid
+ * until the next poll, so names are copied into fixed storage on first use. IDs
+ * are assigned in order of first appearance and never change.
+ */
+class PassNameTable
+{
+public:
+    static const std::uint32_t MaxNames = 64;
+    static const std::uint32_t MaxNameLength = 64;
+    static const std::uint32_t InvalidId = 0xFFFFFFFFu;
+
+    /**
+     * @param isNew - optional, set to true if the name was added by this call
+     * @return ID of the name, InvalidId if the table is full
+     */
+    std::uint32_t Intern(const char* name, bool* isNew = nullptr);
+
+    /** @return ID of the name, InvalidId if it was never interned */
+    std::uint32_t Find(const char* name) const;
+
+    /**
+     * Adds a name with an explicit ID, used when decoding logs.
+     * @return false if the ID is out of range
+     */
+    bool Define(std::uint32_t id, const char* name);
+
+    /** @return interned name or "unknown" for IDs not defined */
+    const char* GetName(std::uint32_t id) const;
+
+    std::uint32_t GetCount() const { return m_count; }
+    void Clear() { m_count = 0; }
+
+private:
+    char m_names[MaxNames][MaxNameLength] = {};
+    std::uint32_t m_count = 0;
+};
+}
@@ -0,0 +1,360 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#include "periodic_dump.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+#include "dump_stream.h"
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    const char* const SamplePrefix = "sample_";
+
+    std::uint64_t GetFolderSize(const fs::path& path)
+    {
+        std::uint64_t size = 0;
+        std::error_code ec;
+        for (fs::recursive_directory_iterator it(path, ec), end; !ec && it != end; it.increment(ec))
+        {
+            if (it->is_regular_file(ec))
+            {
+                size += (std::uint64_t)it->file_size(ec);
+            }
+        }
+        return size;
+    }
+}
+
+namespace PerfTools
+{
+PeriodicDumper::~PeriodicDumper()
+{
+    Stop();
+}
+
+bool PeriodicDumper::Start(const PeriodicDumpSchedule& schedule)
+{
+    Stop();
+
+    if (schedule.frameInterval == 0 && schedule.secondsInterval <= 0.0 && !schedule.onDemand)
+    {
+        return false;
+    }
+
+    std::error_code ec;
+    fs::create_directories(schedule.folder, ec);
+    if (!fs::is_directory(schedule.folder, ec))
+    {
+        return false;
+    }
+
+    m_schedule = schedule;
+    if (m_schedule.elementsMask == 0)
+    {
+        m_schedule.elementsMask = XESS_DUMP_ALL_INPUTS;
+    }
+
+    for (Sample& sample : m_samples)
+    {
+        sample.data.resize((std::size_t)m_schedule.maxSampleBytes);
+        sample.busy = false;
+    }
+    m_current = nullptr;
+    m_anySampleTaken = false;
+    m_sampleRequested = false;
+
+    // Samples of previous runs count against the budget, names sort by creation time.
+    std::vector<fs::path> existing;
+    for (fs::directory_iterator it(m_schedule.folder, ec), end; !ec && it != end; it.increment(ec))
+    {
+        if (it->is_directory(ec) && it->path().filename().string().rfind(SamplePrefix, 0) == 0)
+        {
+            existing.push_back(it->path());
+        }
+    }
+    std::sort(existing.begin(), existing.end());
+
+    m_stored.clear();
+    m_diskUsage = 0;
+    for (const fs::path& path : existing)
+    {
+        const std::uint64_t bytes = GetFolderSize(path);
+        m_stored.push_back({path.string(), bytes});
+        m_diskUsage += bytes;
+    }
+    m_writtenSamples = 0;
+    m_skippedSamples = 0;
+    m_deletedSamples = 0;
+
+    m_stopRequested = false;
+    m_thread = std::thread(&PeriodicDumper::WriterThread, this);
+    return true;
+}
+
+void PeriodicDumper::Stop()
+{
+    if (!m_thread.joinable())
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopRequested = true;
+    }
+    m_condition.notify_one();
+    m_thread.join();
+}
+
+bool PeriodicDumper::IsElementSelected(xess_dump_element_bits_t element) const
+{
+    return (m_schedule.elementsMask & (xess_dump_elements_mask_t)element) != 0;
+}
+
+bool PeriodicDumper::IsSampleDue(std::uint64_t frameIndex)
+{
+    if (!IsRunning())
+    {
+        return false;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    bool due = m_sampleRequested && m_schedule.onDemand;
+    due = due || (m_schedule.frameInterval != 0 && frameIndex % m_schedule.frameInterval == 0);
+    if (m_schedule.secondsInterval > 0.0)
+    {
+        const std::chrono::duration<double> elapsed = now - m_lastSampleTime;
+        due = due || !m_anySampleTaken || elapsed.count() >= m_schedule.secondsInterval;
+    }
+    if (!due)
+    {
+        return false;
+    }
+
+    // A time based or requested sample is not retried on the next frames while the writer is busy.
+    m_sampleRequested = false;
+    m_lastSampleTime = now;
+    m_anySampleTaken = true;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_samples[0].busy && m_samples[1].busy)
+    {
+        m_skippedSamples++;
+        return false;
+    }
+    return true;
+}
+
+bool PeriodicDumper::BeginSample(std::uint64_t frameIndex)
+{
+    m_current = nullptr;
+    if (!IsRunning())
+    {
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (Sample& sample : m_samples)
+        {
+            if (!sample.busy)
+            {
+                sample.busy = true;
+                m_current = &sample;
+                break;
+            }
+        }
+        if (m_current == nullptr)
+        {
+            m_skippedSamples++;
+            return false;
+        }
+    }
+
+    m_current->frameIndex = frameIndex;
+    m_current->usedSize = 0;
+    m_current->elementCount = 0;
+    return true;
+}
+
+std::uint8_t* PeriodicDumper::AddElement(xess_dump_element_bits_t element, PixelFormat format,
+    std::uint32_t width, std::uint32_t height, std::uint32_t rowPitch)
+{
+    const std::uint32_t maxElements = (std::uint32_t)(sizeof(m_current->elements) / sizeof(m_current->elements[0]));
+    if (m_current == nullptr || !IsElementSelected(element) || m_current->elementCount == maxElements)
+    {
+        return nullptr;
+    }
+
+    const std::uint64_t dataSize = (std::uint64_t)rowPitch * height;
+    if (m_current->usedSize + dataSize > m_current->data.size())
+    {
+        return nullptr;
+    }
+
+    Element& desc = m_current->elements[m_current->elementCount++];
+    desc.element = element;
+    desc.format = format;
+    desc.width = width;
+    desc.height = height;
+    desc.rowPitch = rowPitch;
+    desc.dataOffset = m_current->usedSize;
+    m_current->usedSize += dataSize;
+    return m_current->data.data() + desc.dataOffset;
+}
+
+void PeriodicDumper::EndSample()
+{
+    if (m_current == nullptr)
+    {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push_back(m_current);
+    }
+    m_condition.notify_one();
+    m_current = nullptr;
+}
+
+std::uint64_t PeriodicDumper::GetWrittenSampleCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_writtenSamples;
+}
+
+std::uint64_t PeriodicDumper::GetSkippedSampleCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_skippedSamples;
+}
+
+std::uint64_t PeriodicDumper::GetDeletedSampleCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_deletedSamples;
+}
+
+std::uint64_t PeriodicDumper::GetDiskUsage() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_diskUsage;
+}
+
+void PeriodicDumper::WriterThread()
+{
+    std::vector<float> rowBuffer;
+    for (;;)
+    {
+        Sample* sample = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this] { return !m_queue.empty() || m_stopRequested; });
+            if (m_queue.empty())
+            {
+                return;
+            }
+            sample = m_queue.front();
+            m_queue.pop_front();
+        }
+
+        const long long seconds = (long long)std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        char name[64];
+        std::snprintf(name, sizeof(name), "%s%012lld_%010llu", SamplePrefix, seconds,
+            (unsigned long long)sample->frameIndex);
+        const std::string path = (fs::path(m_schedule.folder) / name).string();
+
+        const std::uint64_t bytes = WriteSample(*sample, path, rowBuffer);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            sample->busy = false;
+            m_stored.push_back({path, bytes});
+            m_diskUsage += bytes;
+            m_writtenSamples++;
+        }
+        EnforceDiskBudget();
+    }
+}
+
+std::uint64_t PeriodicDumper::WriteSample(const Sample& sample, const std::string& path, std::vector<float>& rowBuffer)
+{
+    std::error_code ec;
+    fs::create_directories(path, ec);
+
+    std::uint64_t bytes = 0;
+    for (std::uint32_t i = 0; i < sample.elementCount; ++i)
+    {
+        const Element& element = sample.elements[i];
+        const std::uint32_t texelSize = GetPixelFormatSize(element.format);
+        const std::string fileName = (fs::path(path) / (std::string(GetDumpElementName(element.element)) + ".pfm")).string();
+
+        FILE* file = std::fopen(fileName.c_str(), "wb");
+        if (file == nullptr)
+        {
+            continue;
+        }
+
+        // Portable Float Map, RGB little endian rows stored bottom to top.
+        const int headerSize = std::fprintf(file, "PF\n%u %u\n-1.0\n", element.width, element.height);
+        rowBuffer.resize((std::size_t)element.width * 3);
+        for (std::uint32_t y = element.height; y-- > 0;)
+        {
+            const std::uint8_t* row = sample.data.data() + element.dataOffset + (std::size_t)y * element.rowPitch;
+            for (std::uint32_t x = 0; x < element.width; ++x)
+            {
+                float rgba[4];
+                DecodeTexel(element.format, row + (std::size_t)x * texelSize, rgba);
+                std::memcpy(&rowBuffer[(std::size_t)x * 3], rgba, 3 * sizeof(float));
+            }
+            std::fwrite(rowBuffer.data(), sizeof(float), rowBuffer.size(), file);
+        }
+        std::fclose(file);
+
+        bytes += (std::uint64_t)(headerSize > 0 ? headerSize : 0) + (std::uint64_t)rowBuffer.size() * sizeof(float) * element.height;
+    }
+    return bytes;
+}
+
+void PeriodicDumper::EnforceDiskBudget()
+{
+    for (;;)
+    {
+        StoredSample oldest;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            // The newest sample is always kept, even if it alone exceeds the budget.
+            if (m_diskUsage <= m_schedule.maxDiskBytes || m_stored.size() <= 1)
+            {
+                return;
+            }
+            oldest = m_stored.front();
+            m_stored.pop_front();
+            m_diskUsage -= std::min(m_diskUsage, oldest.bytes);
+            m_deletedSamples++;
+        }
+
+        std::error_code ec;
+        fs::remove_all(oldest.path, ec);
+    }
+}
+}
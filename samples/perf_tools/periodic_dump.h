@@ -0,0 +1,165 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "xess/xess_debug.h"
+
+#include "image_metrics.h"
+
+namespace PerfTools
+{
+/** When and how much to dump during a long soak run. */
+struct PeriodicDumpSchedule
+{
+    /** Folder receiving one sample_<frame> subfolder per sample. Created if missing. */
+    std::string folder = "soak_dump";
+    /** Elements to keep, 0 means XESS_DUMP_ALL_INPUTS as in xessStartDump. */
+    xess_dump_elements_mask_t elementsMask = 0;
+    /** Sample every N-th frame, 0 disables the frame based schedule. */
+    std::uint32_t frameInterval = 0;
+    /** Sample once per interval, 0 disables the time based schedule. [seconds] */
+    double secondsInterval = 0.0;
+    /** Accept samples requested with RequestSample, also without a schedule. */
+    bool onDemand = false;
+    /** Oldest samples are deleted once the folder grows beyond this size. [bytes] */
+    std::uint64_t maxDiskBytes = 2ull << 30;
+    /** Capacity of each preallocated sample buffer. [bytes] */
+    std::uint64_t maxSampleBytes = 64ull << 20;
+};
+
+/**
+ * Captures single frames on a schedule and writes them on a background thread.
+ *
+ * Unlike xessStartDump, which captures one contiguous window and blocks the
+ * execute call while saving it, samples are copied into one of two preallocated
+ * buffers and converted and written asynchronously. A due sample is skipped
+ * while both buffers are still being written, the render thread never waits
+ * for the disk. Each element is stored as a Portable Float Map (.pfm) image.
+ */
+class PeriodicDumper
+{
+public:
+    PeriodicDumper() = default;
+    ~PeriodicDumper();
+
+    PeriodicDumper(const PeriodicDumper&) = delete;
+    PeriodicDumper& operator=(const PeriodicDumper&) = delete;
+
+    /**
+     * Allocates sample buffers, accounts samples left in the folder by previous
+     * runs and starts the writer thread.
+     * @return false if the folder cannot be created or the schedule is empty
+     */
+    bool Start(const PeriodicDumpSchedule& schedule);
+
+    /** Writes pending samples and stops the writer thread. */
+    void Stop();
+
+    bool IsRunning() const { return m_thread.joinable(); }
+    bool IsElementSelected(xess_dump_element_bits_t element) const;
+
+    /**
+     * Checks the schedule, call once per frame before recording readback copies.
+     * @return true if a sample should be taken for this frame
+     */
+    bool IsSampleDue(std::uint64_t frameIndex);
+
+    /** Makes the next IsSampleDue call take a sample, for example when an anomaly was detected. */
+    void RequestSample() { m_sampleRequested = true; }
+
+    /**
+     * Starts filling a sample buffer.
+     * @return false if both buffers are busy, the sample is counted as skipped
+     */
+    bool BeginSample(std::uint64_t frameIndex);
+
+    /**
+     * Reserves storage for one element of the current sample.
+     * @return destination for rowPitch * height bytes, or nullptr if the element is
+     * not selected or does not fit into the sample buffer
+     */
+    std::uint8_t* AddElement(xess_dump_element_bits_t element, PixelFormat format,
+        std::uint32_t width, std::uint32_t height, std::uint32_t rowPitch);
+
+    /** Hands the current sample over to the writer thread. */
+    void EndSample();
+
+    std::uint64_t GetWrittenSampleCount() const;
+    std::uint64_t GetSkippedSampleCount() const;
+    std::uint64_t GetDeletedSampleCount() const;
+    std::uint64_t GetDiskUsage() const;
+
+private:
+    struct Element
+    {
+        xess_dump_element_bits_t element;
+        PixelFormat format;
+        std::uint32_t width;
+        std::uint32_t height;
+        std::uint32_t rowPitch;
+        std::uint64_t dataOffset;
+    };
+
+    struct Sample
+    {
+        std::uint64_t frameIndex = 0;
+        std::vector<std::uint8_t> data;
+        std::uint64_t usedSize = 0;
+        Element elements[8];
+        std::uint32_t elementCount = 0;
+        bool busy = false;
+    };
+
+    struct StoredSample
+    {
+        std::string path;
+        std::uint64_t bytes;
+    };
+
+    void WriterThread();
+    std::uint64_t WriteSample(const Sample& sample, const std::string& path, std::vector<float>& rowBuffer);
+    void EnforceDiskBudget();
+
+    PeriodicDumpSchedule m_schedule;
+    std::chrono::steady_clock::time_point m_lastSampleTime;
+    bool m_anySampleTaken = false;
+    bool m_sampleRequested = false;
+
+    Sample m_samples[2];
+    Sample* m_current = nullptr;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::deque<Sample*> m_queue;
+    bool m_stopRequested = false;
+    std::thread m_thread;
+
+    // Accessed by the writer thread, read under m_mutex by the getters.
+    std::deque<StoredSample> m_stored;
+    std::uint64_t m_diskUsage = 0;
+    std::uint64_t m_writtenSamples = 0;
+    std::uint64_t m_skippedSamples = 0;
+    std::uint64_t m_deletedSamples = 0;
+};
+}
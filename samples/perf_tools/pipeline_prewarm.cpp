@@ -0,0 +1,233 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#include "pipeline_prewarm.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    /** Lets every other thread of the system run first, the prewarm only uses idle time. */
+    void SetIdlePriority()
+    {
+#if defined(_WIN32)
+        SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_IDLE);
+#else
+        // The nice value applies to the calling thread only on Linux.
+        setpriority(PRIO_PROCESS, (id_t)syscall(SYS_gettid), 19);
+#endif
+    }
+
+    double ElapsedMs(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+}
+
+namespace PerfTools
+{
+PipelinePrewarmer::PipelinePrewarmer(PrewarmBackend& backend) : m_backend(backend)
+{
+}
+
+PipelinePrewarmer::~PipelinePrewarmer()
+{
+    Cancel();
+    Wait();
+}
+
+bool PipelinePrewarmer::Start(std::vector<PrewarmCandidate> candidates, const PrewarmBudget& budget,
+    const std::vector<std::uint32_t>& skipFlags)
+{
+    if (IsRunning())
+    {
+        return false;
+    }
+    Wait();
+
+    // Most likely first, equal likelihoods keep their order.
+    std::stable_sort(candidates.begin(), candidates.end(),
+        [](const PrewarmCandidate& a, const PrewarmCandidate& b) { return a.likelihood > b.likelihood; });
+    std::vector<PrewarmCandidate> unique;
+    std::vector<std::uint32_t> seen = skipFlags;
+    for (const PrewarmCandidate& candidate : candidates)
+    {
+        if (std::find(seen.begin(), seen.end(), candidate.initFlags) == seen.end())
+        {
+            seen.push_back(candidate.initFlags);
+            unique.push_back(candidate);
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_running = true;
+    m_cancelled = false;
+    m_statistics = PrewarmStatistics();
+    m_thread = std::thread(&PipelinePrewarmer::WorkerThread, this, std::move(unique), budget);
+    return true;
+}
+
+void PipelinePrewarmer::Pause()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_paused = true;
+}
+
+void PipelinePrewarmer::Resume()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_paused = false;
+    }
+    m_condition.notify_all();
+}
+
+void PipelinePrewarmer::Cancel()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_cancelled = true;
+    }
+    m_condition.notify_all();
+}
+
+void PipelinePrewarmer::Wait()
+{
+    if (m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+bool PipelinePrewarmer::IsRunning() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_running;
+}
+
+bool PipelinePrewarmer::IsPrewarmed(std::uint32_t initFlags) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return std::find(m_prewarmedFlags.begin(), m_prewarmedFlags.end(), initFlags) != m_prewarmedFlags.end();
+}
+
+PrewarmStatistics PipelinePrewarmer::GetStatistics() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_statistics;
+}
+
+std::string PipelinePrewarmer::FormatReport() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::ostringstream report;
+    report << std::fixed << std::setprecision(1);
+    report << "XeSS pipeline prewarm: built " << m_statistics.built << ", failed " << m_statistics.failed << ", skipped "
+           << m_statistics.skipped << ", cancelled " << m_statistics.cancelled << ", " << m_statistics.totalMs << " ms";
+    if (!m_prewarmedFlags.empty())
+    {
+        report << ", flags" << std::hex;
+        for (std::uint32_t flags : m_prewarmedFlags)
+        {
+            report << " 0x" << flags;
+        }
+        report << std::dec;
+    }
+    report << "\n";
+    return report.str();
+}
+
+void PipelinePrewarmer::WorkerThread(std::vector<PrewarmCandidate> candidates, PrewarmBudget budget)
+{
+    SetIdlePriority();
+
+    const auto poll = std::chrono::duration<double, std::milli>(std::max(budget.pollMs, 0.1));
+    std::unique_lock<std::mutex> lock(m_mutex);
+    std::size_t next = 0;
+    for (; next < candidates.size(); next++)
+    {
+        m_condition.wait(lock, [this] { return !m_paused || m_cancelled; });
+        if (m_cancelled || m_statistics.built + m_statistics.failed >= budget.maxBuilds ||
+            m_statistics.totalMs >= budget.maxTotalMs)
+        {
+            break;
+        }
+        lock.unlock();
+
+        const std::uint32_t flags = candidates[next].initFlags;
+        const auto start = std::chrono::steady_clock::now();
+        xess_context_handle_t context = m_backend.BeginBuild(flags);
+        xess_result_t status = XESS_RESULT_ERROR_UNKNOWN;
+        bool cancelled = false;
+        if (context != nullptr)
+        {
+            for (;;)
+            {
+                status = m_backend.GetBuildStatus(context);
+                if (status != XESS_RESULT_ERROR_OPERATION_IN_PROGRESS)
+                {
+                    break;
+                }
+                lock.lock();
+                // The worker owns totalMs, so it can be read with the time of the build in progress.
+                cancelled = m_condition.wait_for(lock, poll, [this] { return m_cancelled; }) ||
+                    m_statistics.totalMs + ElapsedMs(start) >= budget.maxTotalMs;
+                lock.unlock();
+                if (cancelled)
+                {
+                    break;
+                }
+            }
+            // An abandoned build is released here, so the caller of Cancel never waits for it.
+            m_backend.EndBuild(context);
+        }
+        const double buildMs = ElapsedMs(start);
+
+        lock.lock();
+        m_statistics.totalMs += buildMs;
+        if (status == XESS_RESULT_SUCCESS)
+        {
+            m_statistics.built++;
+            m_prewarmedFlags.push_back(flags);
+        }
+        else if (cancelled)
+        {
+            m_statistics.cancelled++;
+        }
+        else
+        {
+            m_statistics.failed++;
+        }
+    }
+    m_statistics.skipped += std::uint32_t(candidates.size() - next);
+    m_running = false;
+}
+}
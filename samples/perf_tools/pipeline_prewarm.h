@@ -0,0 +1,142 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "xess/xess.h"
+
+namespace PerfTools
+{
+/** Configuration that may be switched to later. The pipelines depend only on the init flags. */
+struct PrewarmCandidate
+{
+    std::uint32_t initFlags = 0;
+    /** Relative likelihood of the configuration, the most likely ones are built first. */
+    double likelihood = 1.0;
+};
+
+/** Builds pipelines into the cache shared with the application, for example a pipeline cache or library. */
+class PrewarmBackend
+{
+public:
+    virtual ~PrewarmBackend() = default;
+
+    /**
+     * Starts a non-blocking build on a temporary context, e.g. xess*CreateContext and
+     * xess*BuildPipelines(context, sharedCache, false, initFlags).
+     * @return the temporary context, or nullptr on failure
+     */
+    virtual xess_context_handle_t BeginBuild(std::uint32_t initFlags) = 0;
+
+    /**
+     * @return the state of the build, e.g. of xessGetPipelineBuildStatus: XESS_RESULT_ERROR_OPERATION_IN_PROGRESS
+     * while building, XESS_RESULT_SUCCESS once built, any other result if the build failed
+     */
+    virtual xess_result_t GetBuildStatus(xess_context_handle_t context) = 0;
+
+    /** Destroys the temporary context, which may wait for an unfinished build. */
+    virtual void EndBuild(xess_context_handle_t context) = 0;
+};
+
+/** Limits that keep the prewarm from competing with the application. */
+struct PrewarmBudget
+{
+    /** Number of configurations to build, the most likely first. */
+    std::uint32_t maxBuilds = 4;
+    /** No build is started once the builds took this long in total, a build still running then is abandoned. [ms] */
+    double maxTotalMs = 10000.0;
+    /** Interval of the build status polls. [ms] */
+    double pollMs = 5.0;
+};
+
+struct PrewarmStatistics
+{
+    std::uint32_t built = 0;
+    std::uint32_t failed = 0;
+    /** Candidates not built because of the budget or a cancellation. */
+    std::uint32_t skipped = 0;
+    /** Builds started but abandoned by a cancellation or the time budget. */
+    std::uint32_t cancelled = 0;
+    double totalMs = 0.0;
+};
+
+/**
+ * Speculatively builds the XeSS pipelines of likely configurations.
+ *
+ * The candidates are built one at a time, most likely first, on a worker thread
+ * with idle priority, so a later switch to one of them finds its pipelines in
+ * the shared cache and skips the kernel compilation. The worker waits while
+ * paused, e.g. during loading, and stops starting builds once the budget is
+ * spent or Cancel was called. A build in progress is abandoned by Cancel or
+ * the time budget and released on the worker thread, Cancel itself never
+ * waits. Only builds that report XESS_RESULT_SUCCESS count as prewarmed.
+ */
+class PipelinePrewarmer
+{
+public:
+    explicit PipelinePrewarmer(PrewarmBackend& backend);
+    ~PipelinePrewarmer();
+
+    PipelinePrewarmer(const PipelinePrewarmer&) = delete;
+    PipelinePrewarmer& operator=(const PipelinePrewarmer&) = delete;
+
+    /**
+     * Starts the worker thread. Candidates with the same init flags are built once.
+     * @param skipFlags - init flags whose pipelines are already built, e.g. the current ones
+     * @return false if a prewarm is already running
+     */
+    bool Start(std::vector<PrewarmCandidate> candidates, const PrewarmBudget& budget,
+        const std::vector<std::uint32_t>& skipFlags = {});
+
+    /** Holds back the next build, a build in progress continues. Also applies to a later Start. */
+    void Pause();
+    void Resume();
+
+    /** Stops the prewarm without waiting for it. */
+    void Cancel();
+
+    /** Waits until the worker thread is finished. */
+    void Wait();
+
+    /** @return true while candidates are left to build */
+    bool IsRunning() const;
+
+    /** @return true if the pipelines of the init flags were built by the prewarm */
+    bool IsPrewarmed(std::uint32_t initFlags) const;
+
+    PrewarmStatistics GetStatistics() const;
+    std::string FormatReport() const;
+
+private:
+    void WorkerThread(std::vector<PrewarmCandidate> candidates, PrewarmBudget budget);
+
+    PrewarmBackend& m_backend;
+    std::thread m_thread;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_running = false;
+    bool m_paused = false;
+    bool m_cancelled = false;
+    std::vector<std::uint32_t> m_prewarmedFlags;
+    PrewarmStatistics m_statistics;
+};
+}
@@ -0,0 +1,191 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#include "profiling_aggregator.h"
+#include "profiling_log.h"
+#include "trace_exporter.h"
+
+#include <cmath>
+#include <cstdio>
+
+namespace
+{
+    std::uint64_t SecondsToNanoseconds(double seconds)
+    {
+        return (seconds > 0.0 && std::isfinite(seconds)) ? (std::uint64_t)std::llround(seconds * 1e9) : 0;
+    }
+
+    double NanosecondsToMilliseconds(std::uint64_t nanoseconds)
+    {
+        return (double)nanoseconds * 1e-6;
+    }
+}
+
+namespace PerfTools
+{
+const char* const ProfilingAggregator::ExecutionTotalName = "execution_total";
+
+void ProfilingAggregator::Init(xess_context_handle_t context, ProfilingDataQuery query, double pollIntervalSeconds)
+{
+    m_context = context;
+    m_query = query;
+    m_pollInterval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(pollIntervalSeconds));
+    m_lastPoll = std::chrono::steady_clock::now();
+
+    if (!m_histograms)
+    {
+        m_histograms.reset(new HdrHistogram[MaxPasses]);
+    }
+    m_names.Clear();
+    Reset();
+
+    // The execution total always occupies the first slot.
+    m_names.Intern(ExecutionTotalName);
+    m_initialized = true;
+}
+
+bool ProfilingAggregator::Update()
+{
+    if (m_query == nullptr)
+    {
+        return false;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    if (now - m_lastPoll < m_pollInterval)
+    {
+        return false;
+    }
+    Poll();
+    return true;
+}
+
+xess_result_t ProfilingAggregator::Poll()
+{
+    if (m_query == nullptr)
+    {
+        return XESS_RESULT_ERROR_UNINITIALIZED;
+    }
+
+    m_lastPoll = std::chrono::steady_clock::now();
+
+    xess_profiling_data_t* data = nullptr;
+    const xess_result_t result = m_query(m_context, &data);
+    if (result == XESS_RESULT_SUCCESS && data != nullptr)
+    {
+        Accumulate(*data);
+        if (m_log != nullptr)
+        {
+            const auto timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(m_lastPoll.time_since_epoch());
+            m_log->Append(*data, (std::uint64_t)timestamp.count());
+        }
+        if (m_trace != nullptr)
+        {
+            m_trace->AddXessProfilingData(*data);
+        }
+    }
+    return result;
+}
+
+void ProfilingAggregator::Flush(std::uint32_t maxPolls)
+{
+    for (std::uint32_t i = 0; i < maxPolls; ++i)
+    {
+        if (Poll() != XESS_RESULT_SUCCESS || !m_dataInFlight)
+        {
+            break;
+        }
+    }
+}
+
+void ProfilingAggregator::Accumulate(const xess_profiling_data_t& data)
+{
+    for (std::uint64_t f = 0; f < data.frame_count; ++f)
+    {
+        const xess_profiled_frame_data_t& frame = data.frames[f];
+        std::uint64_t total = 0;
+        for (std::uint64_t r = 0; r < frame.gpu_duration_record_count; ++r)
+        {
+            const std::uint64_t duration = SecondsToNanoseconds(frame.gpu_duration_values[r]);
+            total += duration;
+
+            const std::uint32_t pass = m_names.Intern(frame.gpu_duration_names[r]);
+            if (pass == PassNameTable::InvalidId)
+            {
+                m_droppedRecords++;
+                continue;
+            }
+            m_histograms[pass].Record(duration);
+        }
+        m_histograms[0].Record(total);
+        m_executionCount++;
+        m_lastExecutionNs = total;
+    }
+    m_dataInFlight = data.any_profiling_data_in_flight != 0;
+}
+
+void ProfilingAggregator::Reset()
+{
+    for (std::uint32_t i = 0; i < m_names.GetCount(); ++i)
+    {
+        m_histograms[i].Reset();
+    }
+    m_executionCount = 0;
+    m_droppedRecords = 0;
+}
+
+PassStatistics ProfilingAggregator::GetPassStatistics(std::uint32_t pass) const
+{
+    const HdrHistogram& histogram = m_histograms[pass];
+
+    PassStatistics statistics;
+    statistics.name = m_names.GetName(pass);
+    statistics.count = histogram.GetCount();
+    statistics.meanMs = histogram.GetMean() * 1e-6;
+    statistics.p50Ms = NanosecondsToMilliseconds(histogram.GetPercentile(50.0));
+    statistics.p90Ms = NanosecondsToMilliseconds(histogram.GetPercentile(90.0));
+    statistics.p99Ms = NanosecondsToMilliseconds(histogram.GetPercentile(99.0));
+    statistics.maxMs = NanosecondsToMilliseconds(histogram.GetMax());
+    return statistics;
+}
+
+std::string ProfilingAggregator::FormatReport(const char* title) const
+{
+    std::string report;
+    char line[256];
+    std::snprintf(line, sizeof(line), "%s, %llu executions [ms]\n",
+        title, (unsigned long long)m_executionCount);
+    report += line;
+    std::snprintf(line, sizeof(line), "%-32s %10s %9s %9s %9s %9s %9s\n",
+        "pass", "count", "mean", "p50", "p90", "p99", "max");
+    report += line;
+
+    for (std::uint32_t i = 0; i < m_names.GetCount(); ++i)
+    {
+        const PassStatistics s = GetPassStatistics(i);
+        std::snprintf(line, sizeof(line), "%-32s %10llu %9.4f %9.4f %9.4f %9.4f %9.4f\n",
+            s.name, (unsigned long long)s.count, s.meanMs, s.p50Ms, s.p90Ms, s.p99Ms, s.maxMs);
+        report += line;
+    }
+
+    if (m_droppedRecords != 0)
+    {
+        std::snprintf(line, sizeof(line), "%llu records dropped, more than %u passes\n",
+            (unsigned long long)m_droppedRecords, MaxPasses);
+        report += line;
+    }
+    return report;
+}
+}
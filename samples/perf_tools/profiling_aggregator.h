@@ -0,0 +1,146 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "xess/xess_debug.h"
+
+#include "hdr_histogram.h"
+#include "pass_name_table.h"
+
+namespace PerfTools
+{
+class ProfilingLogWriter;
+class TraceExporter;
+
+/** Summary of one named GPU duration. All durations in milliseconds. */
+struct PassStatistics
+{
+    const char* name;
+    std::uint64_t count;
+    double meanMs;
+    double p50Ms;
+    double p90Ms;
+    double p99Ms;
+    double maxMs;
+};
+
+/**
+ * Folds XeSS profiling data into per-pass HDR histograms with constant memory.
+ *
+ * With XESS_DEBUG_ENABLE_PROFILING the library buffers profiling data until it
+ * is polled, so the aggregator polls xessGetProfilingData on a fixed cadence
+ * and keeps only histograms. Polling never waits for the GPU: frames still in
+ * flight are reported by later polls, any_profiling_data_in_flight only decides
+ * whether Flush has anything left to collect. The histograms are allocated once
+ * in Init, nothing is allocated while polling.
+ *
+ * The XeSS context is not documented as thread-safe, so Update must be called
+ * on the thread which records xess*Execute, typically once per frame.
+ */
+class ProfilingAggregator
+{
+public:
+    static const std::uint32_t MaxPasses = PassNameTable::MaxNames;
+    /** Synthetic pass holding the sum of all durations of one execution. */
+    static const char* const ExecutionTotalName;
+
+    /** Signature of xessGetProfilingData, replaceable for stand-in backends. */
+    typedef xess_result_t (*ProfilingDataQuery)(xess_context_handle_t, xess_profiling_data_t**);
+
+    /**
+     * @param context - XeSS context initialized with XESS_DEBUG_ENABLE_PROFILING
+     * @param query - xessGetProfilingData, a stand-in, or nullptr if all data is passed to Accumulate
+     * @param pollIntervalSeconds - minimal time between two polls
+     */
+    void Init(xess_context_handle_t context, ProfilingDataQuery query, double pollIntervalSeconds = 0.25);
+
+    /** @return true once Init was called, also if the data is only passed to Accumulate */
+    bool IsInitialized() const { return m_initialized; }
+
+    /**
+     * Additionally appends every poll to a binary log.
+     * @param log - open log, nullptr to stop logging; must outlive the aggregator
+     */
+    void SetLog(ProfilingLogWriter* log) { m_log = log; }
+
+    /**
+     * Additionally exports every poll to a timeline trace.
+     * @param trace - open trace, nullptr to stop exporting; must outlive the aggregator
+     */
+    void SetTrace(TraceExporter* trace) { m_trace = trace; }
+
+    /**
+     * Polls when the cadence interval elapsed since the last poll.
+     * @return true if profiling data was polled
+     */
+    bool Update();
+
+    /** Polls immediately. */
+    xess_result_t Poll();
+
+    /**
+     * Collects data of executions still in flight. Call after the application
+     * waited for the GPU, for example before destroying the context.
+     * @param maxPolls - upper bound of polls while data is reported in flight
+     */
+    void Flush(std::uint32_t maxPolls = 8);
+
+    /** Adds polled profiling data to the histograms. */
+    void Accumulate(const xess_profiling_data_t& data);
+
+    /** Clears the histograms, pass names are kept. */
+    void Reset();
+
+    bool IsDataInFlight() const { return m_dataInFlight; }
+    std::uint64_t GetExecutionCount() const { return m_executionCount; }
+    /** @return sum of all passes of the most recently polled execution, 0 before the first one */
+    double GetLastExecutionMs() const { return (double)m_lastExecutionNs * 1e-6; }
+    /** @return records dropped because more than MaxPasses distinct names were seen */
+    std::uint64_t GetDroppedRecordCount() const { return m_droppedRecords; }
+
+    std::uint32_t GetPassCount() const { return m_names.GetCount(); }
+    PassStatistics GetPassStatistics(std::uint32_t pass) const;
+    const HdrHistogram& GetPassHistogram(std::uint32_t pass) const { return m_histograms[pass]; }
+
+    /**
+     * @param title - first line of the report
+     * @return human readable table of all passes, one line per pass
+     */
+    std::string FormatReport(const char* title = "XeSS GPU profile") const;
+
+private:
+    bool m_initialized = false;
+    xess_context_handle_t m_context = nullptr;
+    ProfilingDataQuery m_query = nullptr;
+    std::chrono::steady_clock::duration m_pollInterval{};
+    std::chrono::steady_clock::time_point m_lastPoll;
+
+    ProfilingLogWriter* m_log = nullptr;
+    TraceExporter* m_trace = nullptr;
+
+    /** Pass IDs index the histograms. */
+    PassNameTable m_names;
+    std::unique_ptr<HdrHistogram[]> m_histograms;
+    std::uint64_t m_executionCount = 0;
+    std::uint64_t m_lastExecutionNs = 0;
+    std::uint64_t m_droppedRecords = 0;
+    bool m_dataInFlight = false;
+};
+}
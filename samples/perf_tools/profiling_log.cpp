@@ -0,0 +1,356 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#include "profiling_log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+    const std::size_t WriteBufferSize = 64 * 1024;
+    const std::size_t ReadBufferSize = 256 * 1024;
+
+    void WriteU32(std::uint8_t* out, std::uint32_t value)
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            out[i] = (std::uint8_t)(value >> (8 * i));
+        }
+    }
+
+    std::uint32_t ReadU32(const std::uint8_t* in)
+    {
+        std::uint32_t value = 0;
+        for (int i = 0; i < 4; ++i)
+        {
+            value |= (std::uint32_t)in[i] << (8 * i);
+        }
+        return value;
+    }
+
+    std::uint64_t SecondsToNanoseconds(double seconds)
+    {
+        return (seconds > 0.0 && std::isfinite(seconds)) ? (std::uint64_t)std::llround(seconds * 1e9) : 0;
+    }
+}
+
+namespace PerfTools
+{
+ProfilingLogWriter::~ProfilingLogWriter()
+{
+    Close();
+}
+
+bool ProfilingLogWriter::Open(const std::string& path)
+{
+    Close();
+
+    m_file = std::fopen(path.c_str(), "wb");
+    if (m_file == nullptr)
+    {
+        return false;
+    }
+
+    m_buffer.resize(WriteBufferSize);
+    m_used = 0;
+    m_bytesWritten = 0;
+    m_droppedRecords = 0;
+    m_names.Clear();
+    std::memset(m_previousDurations, 0, sizeof(m_previousDurations));
+    m_previousFrameIndex = 0;
+    m_previousTimestamp = 0;
+
+    WriteU32(&m_buffer[0], ProfilingLogMagic);
+    WriteU32(&m_buffer[4], ProfilingLogVersion);
+    m_used = 8;
+    return true;
+}
+
+void ProfilingLogWriter::Close()
+{
+    if (m_file == nullptr)
+    {
+        return;
+    }
+
+    Flush();
+    std::fclose(m_file);
+    m_file = nullptr;
+}
+
+void ProfilingLogWriter::Append(const xess_profiling_data_t& data, std::uint64_t timestampNs)
+{
+    if (m_file == nullptr)
+    {
+        return;
+    }
+
+    for (std::uint64_t f = 0; f < data.frame_count; ++f)
+    {
+        const xess_profiled_frame_data_t& frame = data.frames[f];
+        const std::size_t count = (std::size_t)frame.gpu_duration_record_count;
+        if (m_recordIds.size() < count)
+        {
+            m_recordIds.resize(count);
+        }
+
+        // Name records first, a reader must know every ID before the frame referencing it.
+        std::uint64_t validCount = 0;
+        for (std::size_t r = 0; r < count; ++r)
+        {
+            bool isNew = false;
+            const std::uint32_t id = m_names.Intern(frame.gpu_duration_names[r], &isNew);
+            m_recordIds[r] = id;
+            if (id == PassNameTable::InvalidId)
+            {
+                m_droppedRecords++;
+                continue;
+            }
+            validCount++;
+
+            if (isNew)
+            {
+                const char* name = m_names.GetName(id);
+                const std::size_t length = std::strlen(name);
+                Put(ProfilingLogTagName);
+                PutVarint(id);
+                PutVarint(length);
+                for (std::size_t i = 0; i < length; ++i)
+                {
+                    Put((std::uint8_t)name[i]);
+                }
+            }
+        }
+
+        Put(ProfilingLogTagFrame);
+        PutSigned((std::int64_t)(frame.frame_index - m_previousFrameIndex));
+        PutSigned((std::int64_t)(timestampNs - m_previousTimestamp));
+        PutVarint(validCount);
+        m_previousFrameIndex = frame.frame_index;
+        m_previousTimestamp = timestampNs;
+
+        for (std::size_t r = 0; r < count; ++r)
+        {
+            const std::uint32_t id = m_recordIds[r];
+            if (id == PassNameTable::InvalidId)
+            {
+                continue;
+            }
+
+            const std::uint64_t duration = SecondsToNanoseconds(frame.gpu_duration_values[r]);
+            PutVarint(id);
+            PutSigned((std::int64_t)(duration - m_previousDurations[id]));
+            m_previousDurations[id] = duration;
+        }
+    }
+}
+
+void ProfilingLogWriter::Flush()
+{
+    if (m_file == nullptr || m_used == 0)
+    {
+        return;
+    }
+
+    std::fwrite(m_buffer.data(), 1, m_used, m_file);
+    std::fflush(m_file);
+    m_bytesWritten += m_used;
+    m_used = 0;
+}
+
+void ProfilingLogWriter::Put(std::uint8_t value)
+{
+    if (m_used == m_buffer.size())
+    {
+        Flush();
+    }
+    m_buffer[m_used++] = value;
+}
+
+void ProfilingLogWriter::PutVarint(std::uint64_t value)
+{
+    while (value >= 0x80)
+    {
+        Put((std::uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    Put((std::uint8_t)value);
+}
+
+void ProfilingLogWriter::PutSigned(std::int64_t value)
+{
+    PutVarint(((std::uint64_t)value << 1) ^ (std::uint64_t)(value >> 63));
+}
+
+ProfilingLogReader::~ProfilingLogReader()
+{
+    Close();
+}
+
+bool ProfilingLogReader::Open(const std::string& path)
+{
+    Close();
+
+    m_file = std::fopen(path.c_str(), "rb");
+    if (m_file == nullptr)
+    {
+        return false;
+    }
+
+    std::uint8_t header[8];
+    if (std::fread(header, 1, sizeof(header), m_file) != sizeof(header) ||
+        ReadU32(&header[0]) != ProfilingLogMagic || ReadU32(&header[4]) != ProfilingLogVersion)
+    {
+        Close();
+        return false;
+    }
+
+    m_buffer.resize(ReadBufferSize);
+    m_position = 0;
+    m_size = 0;
+    m_names.Clear();
+    std::memset(m_previousDurations, 0, sizeof(m_previousDurations));
+    m_previousFrameIndex = 0;
+    m_previousTimestamp = 0;
+    return true;
+}
+
+void ProfilingLogReader::Close()
+{
+    if (m_file != nullptr)
+    {
+        std::fclose(m_file);
+        m_file = nullptr;
+    }
+}
+
+bool ProfilingLogReader::ReadFrame(ProfilingLogFrame& frame)
+{
+    std::uint8_t tag = 0;
+    while (Get(tag))
+    {
+        if (tag == ProfilingLogTagName)
+        {
+            std::uint64_t id = 0;
+            std::uint64_t length = 0;
+            if (!GetVarint(id) || !GetVarint(length) || length >= PassNameTable::MaxNameLength)
+            {
+                return false;
+            }
+
+            char name[PassNameTable::MaxNameLength] = {};
+            for (std::uint64_t i = 0; i < length; ++i)
+            {
+                std::uint8_t c = 0;
+                if (!Get(c))
+                {
+                    return false;
+                }
+                name[i] = (char)c;
+            }
+            if (!m_names.Define((std::uint32_t)id, name))
+            {
+                return false;
+            }
+        }
+        else if (tag == ProfilingLogTagFrame)
+        {
+            std::int64_t frameDelta = 0;
+            std::int64_t timestampDelta = 0;
+            std::uint64_t count = 0;
+            if (!GetSigned(frameDelta) || !GetSigned(timestampDelta) || !GetVarint(count))
+            {
+                return false;
+            }
+
+            frame.frameIndex = m_previousFrameIndex + (std::uint64_t)frameDelta;
+            frame.timestampNs = m_previousTimestamp + (std::uint64_t)timestampDelta;
+            frame.records.clear();
+            for (std::uint64_t r = 0; r < count; ++r)
+            {
+                std::uint64_t id = 0;
+                std::int64_t durationDelta = 0;
+                if (!GetVarint(id) || !GetSigned(durationDelta) || id >= PassNameTable::MaxNames)
+                {
+                    return false;
+                }
+
+                m_previousDurations[id] += (std::uint64_t)durationDelta;
+                frame.records.push_back({(std::uint32_t)id, m_previousDurations[id]});
+            }
+
+            m_previousFrameIndex = frame.frameIndex;
+            m_previousTimestamp = frame.timestampNs;
+            return true;
+        }
+        else
+        {
+            // Unknown tag, the rest of the stream cannot be interpreted.
+            return false;
+        }
+    }
+    return false;
+}
+
+bool ProfilingLogReader::Get(std::uint8_t& value)
+{
+    if (m_position == m_size)
+    {
+        if (m_file == nullptr)
+        {
+            return false;
+        }
+        m_size = std::fread(m_buffer.data(), 1, m_buffer.size(), m_file);
+        m_position = 0;
+        if (m_size == 0)
+        {
+            return false;
+        }
+    }
+    value = m_buffer[m_position++];
+    return true;
+}
+
+bool ProfilingLogReader::GetVarint(std::uint64_t& value)
+{
+    value = 0;
+    for (std::uint32_t shift = 0; shift < 64; shift += 7)
+    {
+        std::uint8_t byte = 0;
+        if (!Get(byte))
+        {
+            return false;
+        }
+        value |= (std::uint64_t)(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ProfilingLogReader::GetSigned(std::int64_t& value)
+{
+    std::uint64_t encoded = 0;
+    if (!GetVarint(encoded))
+    {
+        return false;
+    }
+    value = (std::int64_t)(encoded >> 1) ^ -(std::int64_t)(encoded & 1);
+    return true;
+}
+}
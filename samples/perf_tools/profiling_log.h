@@ -0,0 +1,146 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "xess/xess_debug.h"
+
+#include "pass_name_table.h"
+
+namespace PerfTools
+{
+/**
+ * Compact append-only log of XeSS profiling data.
+ *
+ * Layout: 8 byte header (magic, version) followed by records, each starting
+ * with a one byte tag. Integers are LEB128 varints, signed values are zigzag
+ * encoded first.
+ *
+ * - ProfilingLogTagName: pass ID, name length, name bytes. Written once, before
+ *   the first frame which uses the name.
+ * - ProfilingLogTagFrame: frame index delta, timestamp delta, record count, then
+ *   per record the pass ID and the duration delta to the previous duration of
+ *   the same pass. Timestamps and durations are in nanoseconds.
+ *
+ * Steady GPU durations thus take one or two bytes per pass and frame. A record
+ * truncated by a crash ends the log, everything before it stays readable.
+ */
+static const std::uint32_t ProfilingLogMagic = 0x474C5058; // "XPLG"
+static const std::uint32_t ProfilingLogVersion = 1;
+static const std::uint8_t ProfilingLogTagName = 1;
+static const std::uint8_t ProfilingLogTagFrame = 2;
+
+class ProfilingLogWriter
+{
+public:
+    ProfilingLogWriter() = default;
+    ~ProfilingLogWriter();
+
+    ProfilingLogWriter(const ProfilingLogWriter&) = delete;
+    ProfilingLogWriter& operator=(const ProfilingLogWriter&) = delete;
+
+    /** Creates or truncates the log file. */
+    bool Open(const std::string& path);
+    void Close();
+    bool IsOpen() const { return m_file != nullptr; }
+
+    /**
+     * Appends all frames of one xessGetProfilingData poll.
+     * @param data - polled profiling data
+     * @param timestampNs - monotonic CPU time of the poll
+     */
+    void Append(const xess_profiling_data_t& data, std::uint64_t timestampNs);
+
+    /** Writes buffered records to the file. */
+    void Flush();
+
+    std::uint64_t GetBytesWritten() const { return m_bytesWritten + m_used; }
+
+    /** @return records left out of the log because more than PassNameTable::MaxNames distinct names were seen */
+    std::uint64_t GetDroppedRecordCount() const { return m_droppedRecords; }
+
+private:
+    void Put(std::uint8_t value);
+    void PutVarint(std::uint64_t value);
+    void PutSigned(std::int64_t value);
+
+    std::FILE* m_file = nullptr;
+    std::vector<std::uint8_t> m_buffer;
+    std::size_t m_used = 0;
+    std::uint64_t m_bytesWritten = 0;
+    std::uint64_t m_droppedRecords = 0;
+
+    PassNameTable m_names;
+    /** Pass IDs of the frame being written, grown to the largest record count seen. */
+    std::vector<std::uint32_t> m_recordIds;
+    std::uint64_t m_previousDurations[PassNameTable::MaxNames] = {};
+    std::uint64_t m_previousFrameIndex = 0;
+    std::uint64_t m_previousTimestamp = 0;
+};
+
+struct ProfilingLogRecord
+{
+    std::uint32_t passId;
+    std::uint64_t durationNs;
+};
+
+struct ProfilingLogFrame
+{
+    std::uint64_t frameIndex = 0;
+    std::uint64_t timestampNs = 0;
+    std::vector<ProfilingLogRecord> records;
+};
+
+class ProfilingLogReader
+{
+public:
+    ProfilingLogReader() = default;
+    ~ProfilingLogReader();
+
+    ProfilingLogReader(const ProfilingLogReader&) = delete;
+    ProfilingLogReader& operator=(const ProfilingLogReader&) = delete;
+
+    /** @return false if the file is missing or not a profiling log of a known version */
+    bool Open(const std::string& path);
+    void Close();
+
+    /**
+     * Reads the next frame, name records are consumed on the way.
+     * @return false at the end of the log or at a truncated record
+     */
+    bool ReadFrame(ProfilingLogFrame& frame);
+
+    const PassNameTable& GetNames() const { return m_names; }
+
+private:
+    bool Get(std::uint8_t& value);
+    bool GetVarint(std::uint64_t& value);
+    bool GetSigned(std::int64_t& value);
+
+    std::FILE* m_file = nullptr;
+    std::vector<std::uint8_t> m_buffer;
+    std::size_t m_position = 0;
+    std::size_t m_size = 0;
+
+    PassNameTable m_names;
+    std::uint64_t m_previousDurations[PassNameTable::MaxNames] = {};
+    std::uint64_t m_previousFrameIndex = 0;
+    std::uint64_t m_previousTimestamp = 0;
+};
+}
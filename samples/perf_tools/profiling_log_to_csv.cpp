@@ -0,0 +1,85 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+// Decodes a binary profiling log into CSV, one row per pass and frame.
+// Timestamps are relative to the first logged poll.
+
+#include <cstdio>
+#include <string>
+
+#include "command_line.h"
+#include "profiling_log.h"
+
+using namespace PerfTools;
+
+namespace
+{
+    void PrintUsage()
+    {
+        std::printf("Usage: profiling_log_to_csv -input <log> [-output <csv>]\n");
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    CommandLine args(argc, argv);
+    const std::string input = args.GetString("-input", "");
+    if (args.IsSet("-help") || input.empty())
+    {
+        PrintUsage();
+        return input.empty() ? 1 : 0;
+    }
+
+    ProfilingLogReader reader;
+    if (!reader.Open(input))
+    {
+        std::fprintf(stderr, "'%s' is not a profiling log\n", input.c_str());
+        return 1;
+    }
+
+    const std::string output = args.GetString("-output", "");
+    std::FILE* out = output.empty() ? stdout : std::fopen(output.c_str(), "w");
+    if (out == nullptr)
+    {
+        std::fprintf(stderr, "Failed to create '%s'\n", output.c_str());
+        return 1;
+    }
+
+    std::fprintf(out, "frame_index,timestamp_ms,pass,duration_ms\n");
+
+    ProfilingLogFrame frame;
+    std::uint64_t frameCount = 0;
+    std::uint64_t firstTimestamp = 0;
+    while (reader.ReadFrame(frame))
+    {
+        if (frameCount++ == 0)
+        {
+            firstTimestamp = frame.timestampNs;
+        }
+
+        const double timestampMs = (double)(frame.timestampNs - firstTimestamp) * 1e-6;
+        for (const ProfilingLogRecord& record : frame.records)
+        {
+            std::fprintf(out, "%llu,%.3f,%s,%.6f\n", (unsigned long long)frame.frameIndex, timestampMs,
+                reader.GetNames().GetName(record.passId), (double)record.durationNs * 1e-6);
+        }
+    }
+
+    if (out != stdout)
+    {
+        std::fclose(out);
+        std::printf("%llu frames written to '%s'\n", (unsigned long long)frameCount, output.c_str());
+    }
+    return 0;
+}
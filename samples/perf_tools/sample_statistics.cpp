@@ -0,0 +1,167 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#include "sample_statistics.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace PerfTools
+{
+MannWhitneyResult MannWhitneyU(const std::vector<double>& a, const std::vector<double>& b)
+{
+    MannWhitneyResult result;
+    const std::size_t n1 = a.size();
+    const std::size_t n2 = b.size();
+    if (n1 == 0 || n2 == 0)
+    {
+        return result;
+    }
+
+    struct Value
+    {
+        double value;
+        bool first;
+    };
+    std::vector<Value> values;
+    values.reserve(n1 + n2);
+    for (double v : a)
+    {
+        values.push_back({v, true});
+    }
+    for (double v : b)
+    {
+        values.push_back({v, false});
+    }
+    std::sort(values.begin(), values.end(), [](const Value& x, const Value& y) { return x.value < y.value; });
+
+    // Average ranks for ties, the tie term corrects the variance.
+    double rankSumFirst = 0.0;
+    double tieTerm = 0.0;
+    for (std::size_t i = 0; i < values.size();)
+    {
+        std::size_t j = i;
+        while (j < values.size() && values[j].value == values[i].value)
+        {
+            ++j;
+        }
+        const double rank = (double)(i + j + 1) * 0.5;
+        for (std::size_t k = i; k < j; ++k)
+        {
+            if (values[k].first)
+            {
+                rankSumFirst += rank;
+            }
+        }
+        const double t = (double)(j - i);
+        tieTerm += t * t * t - t;
+        i = j;
+    }
+
+    const double n = (double)(n1 + n2);
+    result.u = rankSumFirst - (double)n1 * (double)(n1 + 1) * 0.5;
+    const double mean = (double)n1 * (double)n2 * 0.5;
+    const double variance = (double)n1 * (double)n2 / 12.0 * ((n + 1.0) - tieTerm / (n * (n - 1.0)));
+    if (variance <= 0.0)
+    {
+        return result;
+    }
+
+    // Continuity correction towards the mean.
+    const double difference = result.u - mean;
+    const double corrected = std::max(std::abs(difference) - 0.5, 0.0);
+    result.z = (difference < 0.0 ? -corrected : corrected) / std::sqrt(variance);
+    result.pValue = std::erfc(std::abs(result.z) / std::sqrt(2.0));
+    return result;
+}
+
+double Median(std::vector<double>& values)
+{
+    if (values.empty())
+    {
+        return 0.0;
+    }
+
+    const std::size_t middle = values.size() / 2;
+    std::nth_element(values.begin(), values.begin() + middle, values.end());
+    const double upper = values[middle];
+    if (values.size() % 2 != 0)
+    {
+        return upper;
+    }
+    const double lower = *std::max_element(values.begin(), values.begin() + middle);
+    return (lower + upper) * 0.5;
+}
+
+MedianDelta BootstrapMedianDelta(const std::vector<double>& baseline, const std::vector<double>& candidate,
+    std::uint32_t resamples, double confidence, std::uint64_t seed)
+{
+    MedianDelta result;
+    if (baseline.empty() || candidate.empty())
+    {
+        return result;
+    }
+
+    std::vector<double> scratchBaseline(baseline);
+    std::vector<double> scratchCandidate(candidate);
+    const double medianBaseline = Median(scratchBaseline);
+    const double medianCandidate = Median(scratchCandidate);
+    if (medianBaseline == 0.0)
+    {
+        return result;
+    }
+    result.delta = (medianCandidate - medianBaseline) / medianBaseline;
+    result.low = result.delta;
+    result.high = result.delta;
+    if (resamples == 0)
+    {
+        return result;
+    }
+
+    std::mt19937_64 random(seed);
+    std::uniform_int_distribution<std::size_t> pickBaseline(0, baseline.size() - 1);
+    std::uniform_int_distribution<std::size_t> pickCandidate(0, candidate.size() - 1);
+
+    std::vector<double> deltas;
+    deltas.reserve(resamples);
+    for (std::uint32_t r = 0; r < resamples; ++r)
+    {
+        for (double& v : scratchBaseline)
+        {
+            v = baseline[pickBaseline(random)];
+        }
+        for (double& v : scratchCandidate)
+        {
+            v = candidate[pickCandidate(random)];
+        }
+        const double resampledBaseline = Median(scratchBaseline);
+        if (resampledBaseline != 0.0)
+        {
+            deltas.push_back((Median(scratchCandidate) - resampledBaseline) / resampledBaseline);
+        }
+    }
+    if (deltas.empty())
+    {
+        return result;
+    }
+
+    std::sort(deltas.begin(), deltas.end());
+    const double tail = (1.0 - confidence) * 0.5;
+    const std::size_t last = deltas.size() - 1;
+    result.low = deltas[(std::size_t)std::floor(tail * (double)last)];
+    result.high = deltas[(std::size_t)std::ceil((1.0 - tail) * (double)last)];
+    return result;
+}
+}
@@ -0,0 +1,61 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace PerfTools
+{
+/** Result of a two-sided Mann-Whitney U test. */
+struct MannWhitneyResult
+{
+    /** U statistic of the first sample. */
+    double u = 0.0;
+    /** Normal approximation of U, tie corrected. */
+    double z = 0.0;
+    double pValue = 1.0;
+};
+
+/**
+ * Two-sided Mann-Whitney U test. It makes no assumption about the distribution,
+ * so single long frames do not dominate the result as they do for a t-test.
+ * Uses the normal approximation, which needs about 20 values per sample or more.
+ */
+MannWhitneyResult MannWhitneyU(const std::vector<double>& a, const std::vector<double>& b);
+
+/** Relative change of the median from a baseline to a candidate with a bootstrap confidence interval. */
+struct MedianDelta
+{
+    /** (median(candidate) - median(baseline)) / median(baseline) */
+    double delta = 0.0;
+    double low = 0.0;
+    double high = 0.0;
+};
+
+/**
+ * Percentile bootstrap of the relative median change.
+ * @param baseline - baseline values
+ * @param candidate - candidate values
+ * @param resamples - number of bootstrap resamples
+ * @param confidence - confidence level of the interval, e.g. 0.95
+ * @param seed - random seed, fixed by default so repeated runs give equal results
+ */
+MedianDelta BootstrapMedianDelta(const std::vector<double>& baseline, const std::vector<double>& candidate,
+    std::uint32_t resamples = 2000, double confidence = 0.95, std::uint64_t seed = 1);
+
+/** @return median of the values, the vector is partially reordered */
+double Median(std::vector<double>& values);
+}
@@ -0,0 +1,170 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#include "shared_memory.h"
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    std::string GetPlatformName(const std::string& name)
+    {
+#if defined(_WIN32)
+        return "Local\\" + name;
+#else
+        return "/" + name;
+#endif
+    }
+}
+
+namespace PerfTools
+{
+SharedMemory::~SharedMemory()
+{
+    Close();
+}
+
+bool SharedMemory::Create(const std::string& name, std::size_t size)
+{
+    Close();
+
+    const std::string platformName = GetPlatformName(name);
+#if defined(_WIN32)
+    const unsigned long long size64 = size;
+    HANDLE mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+        (DWORD)(size64 >> 32), (DWORD)(size64 & 0xFFFFFFFFull), platformName.c_str());
+    if (mapping == nullptr)
+    {
+        return false;
+    }
+    void* data = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+    if (data == nullptr)
+    {
+        CloseHandle(mapping);
+        return false;
+    }
+    m_mapping = mapping;
+#else
+    // Remove leftovers of a producer which did not shut down cleanly.
+    shm_unlink(platformName.c_str());
+    int fd = shm_open(platformName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0)
+    {
+        return false;
+    }
+    if (ftruncate(fd, (off_t)size) != 0)
+    {
+        close(fd);
+        shm_unlink(platformName.c_str());
+        return false;
+    }
+    void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        shm_unlink(platformName.c_str());
+        return false;
+    }
+#endif
+
+    m_data = data;
+    m_size = size;
+    m_owner = true;
+    m_name = platformName;
+    return true;
+}
+
+bool SharedMemory::Open(const std::string& name)
+{
+    Close();
+
+    const std::string platformName = GetPlatformName(name);
+#if defined(_WIN32)
+    HANDLE mapping = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, platformName.c_str());
+    if (mapping == nullptr)
+    {
+        return false;
+    }
+    void* data = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+    if (data == nullptr)
+    {
+        CloseHandle(mapping);
+        return false;
+    }
+    MEMORY_BASIC_INFORMATION info = {};
+    VirtualQuery(data, &info, sizeof(info));
+    m_mapping = mapping;
+    m_size = info.RegionSize;
+#else
+    int fd = shm_open(platformName.c_str(), O_RDWR, 0600);
+    if (fd < 0)
+    {
+        return false;
+    }
+    struct stat info = {};
+    if (fstat(fd, &info) != 0 || info.st_size == 0)
+    {
+        close(fd);
+        return false;
+    }
+    void* data = mmap(nullptr, (std::size_t)info.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+        return false;
+    }
+    m_size = (std::size_t)info.st_size;
+#endif
+
+    m_data = data;
+    m_owner = false;
+    m_name = platformName;
+    return true;
+}
+
+void SharedMemory::Close()
+{
+    if (m_data == nullptr)
+    {
+        return;
+    }
+
+#if defined(_WIN32)
+    UnmapViewOfFile(m_data);
+    CloseHandle((HANDLE)m_mapping);
+    m_mapping = nullptr;
+#else
+    munmap(m_data, m_size);
+    if (m_owner)
+    {
+        shm_unlink(m_name.c_str());
+    }
+#endif
+
+    m_data = nullptr;
+    m_size = 0;
+    m_owner = false;
+    m_name.clear();
+}
+}
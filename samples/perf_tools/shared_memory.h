@@ -0,0 +1,66 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace PerfTools
+{
+/**
+ * Named memory region shared between processes on the same machine.
+ * Backed by a paging file mapping on Windows and by shm_open on POSIX systems.
+ */
+class SharedMemory
+{
+public:
+    SharedMemory() = default;
+    ~SharedMemory();
+
+    SharedMemory(const SharedMemory&) = delete;
+    SharedMemory& operator=(const SharedMemory&) = delete;
+
+    /**
+     * Creates a new region, replacing any stale region with the same name.
+     * @param name - region name without platform specific prefix
+     * @param size - region size in bytes
+     * @return true on success
+     */
+    bool Create(const std::string& name, std::size_t size);
+
+    /**
+     * Maps an existing region created by another process.
+     * @param name - region name without platform specific prefix
+     * @return true on success, false if the region does not exist (yet)
+     */
+    bool Open(const std::string& name);
+
+    /** Unmaps the region. Region created by this instance is also unlinked. */
+    void Close();
+
+    void* GetData() const { return m_data; }
+    std::size_t GetSize() const { return m_size; }
+    bool IsOpen() const { return m_data != nullptr; }
+
+private:
+    void* m_data = nullptr;
+    std::size_t m_size = 0;
+    bool m_owner = false;
+    std::string m_name;
+#if defined(_WIN32)
+    void* m_mapping = nullptr;
+#endif
+};
+}
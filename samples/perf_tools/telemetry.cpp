@@ -0,0 +1,262 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#include "telemetry.h"
+
+#include <chrono>
+#include <cstring>
+#include <new>
+
+namespace
+{
+    const std::uint32_t SlotAlignment = 64;
+    const std::uint32_t RecordWords = sizeof(PerfTools::TelemetryRecord) / sizeof(std::uint64_t);
+    /** Frame index and timestamp are always present. */
+    const std::uint32_t MinRecordSize = 2 * sizeof(std::uint64_t);
+
+    std::uint32_t AlignUp(std::uint32_t value, std::uint32_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    std::uint64_t SteadyNowNs()
+    {
+        return (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    // A slot holds the sequence number followed by the record words.
+    std::atomic<std::uint64_t>* GetSlot(std::uint8_t* slots, std::uint32_t slotSize, std::uint32_t slotCount, std::uint64_t index)
+    {
+        return reinterpret_cast<std::atomic<std::uint64_t>*>(slots + (std::size_t)(index % slotCount) * slotSize);
+    }
+}
+
+namespace PerfTools
+{
+bool TelemetryWriter::Create(const std::string& name, std::uint32_t slotCount)
+{
+    Close();
+
+    if (slotCount == 0)
+    {
+        return false;
+    }
+
+    const std::uint32_t slotsOffset = AlignUp((std::uint32_t)sizeof(TelemetryHeader), SlotAlignment);
+    const std::uint32_t slotSize = AlignUp((std::uint32_t)(sizeof(std::uint64_t) + sizeof(TelemetryRecord)), SlotAlignment);
+    if (!m_memory.Create(name, (std::size_t)slotsOffset + (std::size_t)slotSize * slotCount))
+    {
+        return false;
+    }
+
+    std::uint8_t* base = static_cast<std::uint8_t*>(m_memory.GetData());
+    m_slots = base + slotsOffset;
+    for (std::uint32_t slot = 0; slot < slotCount; ++slot)
+    {
+        std::atomic<std::uint64_t>* words = GetSlot(m_slots, slotSize, slotCount, slot);
+        for (std::uint32_t i = 0; i <= RecordWords; ++i)
+        {
+            new (&words[i]) std::atomic<std::uint64_t>(0);
+        }
+    }
+
+    m_header = new (base) TelemetryHeader();
+    m_header->version = TelemetryVersion;
+    m_header->recordSize = (std::uint32_t)sizeof(TelemetryRecord);
+    m_header->slotSize = slotSize;
+    m_header->slotCount = slotCount;
+    m_header->slotsOffset = slotsOffset;
+    m_header->writeIndex.store(0, std::memory_order_relaxed);
+    m_header->magic.store(TelemetryMagic, std::memory_order_release);
+
+    m_writeIndex = 0;
+    m_lastTimestampNs = 0;
+    return true;
+}
+
+void TelemetryWriter::Close()
+{
+    if (m_header != nullptr)
+    {
+        m_header->magic.store(0, std::memory_order_release);
+    }
+    m_memory.Close();
+    m_header = nullptr;
+    m_slots = nullptr;
+}
+
+void TelemetryWriter::Publish(const TelemetryRecord& record)
+{
+    if (m_header == nullptr)
+    {
+        return;
+    }
+
+    TelemetryRecord published = record;
+    published.timestampNs = SteadyNowNs();
+    if ((published.validFields & TelemetryFrameTime) == 0 && m_lastTimestampNs != 0)
+    {
+        published.frameTimeMs = (float)((double)(published.timestampNs - m_lastTimestampNs) * 1e-6);
+        published.validFields |= TelemetryFrameTime;
+    }
+    m_lastTimestampNs = published.timestampNs;
+
+    std::uint64_t source[RecordWords];
+    std::memcpy(source, &published, sizeof(published));
+
+    std::atomic<std::uint64_t>* sequence = GetSlot(m_slots, m_header->slotSize, m_header->slotCount, m_writeIndex);
+    std::atomic<std::uint64_t>* words = sequence + 1;
+    // An odd sequence marks the slot as being written, the fence keeps the
+    // record stores behind it.
+    sequence->store(2 * m_writeIndex + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (std::uint32_t i = 0; i < RecordWords; ++i)
+    {
+        words[i].store(source[i], std::memory_order_relaxed);
+    }
+    sequence->store(2 * m_writeIndex + 2, std::memory_order_release);
+
+    m_writeIndex++;
+    m_header->writeIndex.store(m_writeIndex, std::memory_order_release);
+}
+
+bool TelemetryReader::Open(const std::string& name)
+{
+    Close();
+
+    if (!m_memory.Open(name) || m_memory.GetSize() < sizeof(TelemetryHeader))
+    {
+        m_memory.Close();
+        return false;
+    }
+
+    const TelemetryHeader* header = static_cast<const TelemetryHeader*>(m_memory.GetData());
+    if (header->magic.load(std::memory_order_acquire) != TelemetryMagic ||
+        header->version != TelemetryVersion ||
+        header->recordSize < MinRecordSize || header->recordSize % sizeof(std::uint64_t) != 0 ||
+        header->slotCount == 0 || header->slotSize < sizeof(std::uint64_t) + header->recordSize ||
+        (std::size_t)header->slotsOffset + (std::size_t)header->slotSize * header->slotCount > m_memory.GetSize())
+    {
+        m_memory.Close();
+        return false;
+    }
+
+    m_header = header;
+    m_slots = static_cast<const std::uint8_t*>(m_memory.GetData()) + header->slotsOffset;
+    // Join the ring at its current position.
+    m_readIndex = header->writeIndex.load(std::memory_order_acquire);
+    m_lostRecords = 0;
+    return true;
+}
+
+void TelemetryReader::Close()
+{
+    m_memory.Close();
+    m_header = nullptr;
+    m_slots = nullptr;
+}
+
+bool TelemetryReader::IsProducerAlive() const
+{
+    return m_header != nullptr && m_header->magic.load(std::memory_order_acquire) == TelemetryMagic;
+}
+
+bool TelemetryReader::Read(TelemetryRecord& record)
+{
+    if (m_header == nullptr)
+    {
+        return false;
+    }
+
+    for (;;)
+    {
+        const std::uint64_t writeIndex = m_header->writeIndex.load(std::memory_order_acquire);
+        if (m_readIndex >= writeIndex)
+        {
+            return false;
+        }
+        if (writeIndex - m_readIndex > m_header->slotCount)
+        {
+            const std::uint64_t oldest = writeIndex - m_header->slotCount;
+            m_lostRecords += oldest - m_readIndex;
+            m_readIndex = oldest;
+        }
+
+        const bool copied = CopyRecord(m_readIndex, record);
+        m_readIndex++;
+        if (copied)
+        {
+            return true;
+        }
+        // Overwritten while copying, continue with the next record.
+        m_lostRecords++;
+    }
+}
+
+bool TelemetryReader::ReadLatest(TelemetryRecord& record)
+{
+    if (m_header == nullptr)
+    {
+        return false;
+    }
+
+    for (;;)
+    {
+        const std::uint64_t writeIndex = m_header->writeIndex.load(std::memory_order_acquire);
+        if (m_readIndex >= writeIndex)
+        {
+            return false;
+        }
+        // Fails only if the producer wrapped the whole ring during the copy.
+        if (CopyRecord(writeIndex - 1, record))
+        {
+            m_readIndex = writeIndex;
+            return true;
+        }
+    }
+}
+
+bool TelemetryReader::CopyRecord(std::uint64_t index, TelemetryRecord& record) const
+{
+    // Readers only load, the ring stays const on this side.
+    std::atomic<std::uint64_t>* sequence = GetSlot(const_cast<std::uint8_t*>(m_slots), m_header->slotSize, m_header->slotCount, index);
+    const std::atomic<std::uint64_t>* words = sequence + 1;
+
+    const std::uint64_t expected = 2 * index + 2;
+    if (sequence->load(std::memory_order_acquire) != expected)
+    {
+        return false;
+    }
+
+    // Fields appended by a newer producer are ignored, fields unknown to an
+    // older producer stay zero and are not marked valid.
+    std::uint64_t copy[RecordWords] = {};
+    const std::uint32_t producerWords = m_header->recordSize / sizeof(std::uint64_t);
+    const std::uint32_t wordCount = producerWords < RecordWords ? producerWords : RecordWords;
+    for (std::uint32_t i = 0; i < wordCount; ++i)
+    {
+        copy[i] = words[i].load(std::memory_order_relaxed);
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (sequence->load(std::memory_order_relaxed) != expected)
+    {
+        return false;
+    }
+
+    std::memcpy(&record, copy, sizeof(record));
+    return true;
+}
+}
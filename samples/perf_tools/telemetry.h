@@ -0,0 +1,161 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "shared_memory.h"
+
+namespace PerfTools
+{
+/**
+ * Live frame telemetry for overlay and logging processes on the same machine.
+ * The application publishes one record per frame into a ring in shared memory
+ * and readers poll it at their own rate.
+ *
+ * Unlike the dump stream, readers never write to the ring, so any number of
+ * them can attach and none can slow down the producer. The producer overwrites
+ * the oldest record when it wraps, a reader that falls more than a ring behind
+ * skips the overwritten records and counts them as lost.
+ *
+ * Every slot carries a sequence number that is odd while the producer writes
+ * the slot (seqlock). A reader keeps a copied record only if the sequence was
+ * even and unchanged before and after the copy. Records are copied as relaxed
+ * atomic words, so a torn read is detected and never a data race.
+ */
+static const std::uint32_t TelemetryMagic = 0x544C5358; // "XSLT"
+/** Incremented on incompatible layout changes. Fields are only ever appended to TelemetryRecord. */
+static const std::uint32_t TelemetryVersion = 1;
+static const char* const TelemetryDefaultName = "xess_telemetry";
+
+/** Bits of TelemetryRecord::validFields, fields without their bit set are not measured by the producer. */
+enum TelemetryFieldBits : std::uint32_t
+{
+    TelemetryFrameTime = 1u << 0,
+    TelemetryXessGpuTime = 1u << 1,
+    TelemetrySimToPresentLatency = 1u << 2,
+    TelemetryFramesPresented = 1u << 3,
+};
+
+/** Telemetry of one frame. */
+struct TelemetryRecord
+{
+    std::uint64_t frameIndex;
+    /** Steady clock time when the record was published. [nanoseconds] */
+    std::uint64_t timestampNs;
+    std::uint32_t validFields;
+    /** xefg_swapchain_present_status_t::framesPresented of the last present. */
+    std::uint32_t framesPresented;
+    /** Time since the previous record. [milliseconds] */
+    float frameTimeMs;
+    /** Sum of all XeSS passes of the last profiled execution. [milliseconds] */
+    float xessGpuTimeMs;
+    /** XeLL simulation start to present end of the last reported frame. [milliseconds] */
+    float simToPresentLatencyMs;
+    float reserved;
+};
+
+static_assert(sizeof(TelemetryRecord) % sizeof(std::uint64_t) == 0, "Telemetry records are copied as 64-bit words");
+
+/** Ring control block at the start of the shared memory region. */
+struct TelemetryHeader
+{
+    /** Written last by the producer, readers must not touch the ring before it is valid. */
+    std::atomic<std::uint32_t> magic;
+    std::uint32_t version;
+    /** Size of the producer's TelemetryRecord, at least the size known to the reader. */
+    std::uint32_t recordSize;
+    std::uint32_t slotSize;
+    std::uint32_t slotCount;
+    std::uint32_t slotsOffset;
+    /** Number of published records. */
+    alignas(64) std::atomic<std::uint64_t> writeIndex;
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "Shared memory ring requires lock-free 64-bit atomics");
+
+/** Producer side of the telemetry ring, used by the rendering application. */
+class TelemetryWriter
+{
+public:
+    /**
+     * Creates the shared memory ring.
+     * @param name - shared memory name, readers open the ring with the same name
+     * @param slotCount - number of records kept for readers
+     * @return true on success
+     */
+    bool Create(const std::string& name, std::uint32_t slotCount = 1024);
+    void Close();
+
+    bool IsOpen() const { return m_header != nullptr; }
+
+    /**
+     * Publishes a record. Sets timestampNs, and frameTimeMs as the time since the
+     * previous Publish if the caller did not mark it valid. Never waits for readers.
+     */
+    void Publish(const TelemetryRecord& record);
+
+    std::uint64_t GetPublishedCount() const { return m_writeIndex; }
+
+private:
+    SharedMemory m_memory;
+    TelemetryHeader* m_header = nullptr;
+    std::uint8_t* m_slots = nullptr;
+    std::uint64_t m_writeIndex = 0;
+    std::uint64_t m_lastTimestampNs = 0;
+};
+
+/** Reader side of the telemetry ring, used by overlay and logging processes. */
+class TelemetryReader
+{
+public:
+    /** @return false if the producer has not created a compatible ring yet */
+    bool Open(const std::string& name);
+    void Close();
+
+    bool IsOpen() const { return m_header != nullptr; }
+    /** @return false once the producer closed the ring, the reader should reopen it */
+    bool IsProducerAlive() const;
+
+    /**
+     * Copies the oldest unread record. Reading starts with the records published
+     * after Open.
+     * @return false if no new record is available
+     */
+    bool Read(TelemetryRecord& record);
+
+    /**
+     * Copies the newest record and marks all older ones as read, the skipped
+     * records are not counted as lost.
+     * @return false if no new record is available
+     */
+    bool ReadLatest(TelemetryRecord& record);
+
+    /** @return records overwritten before they were read */
+    std::uint64_t GetLostRecordCount() const { return m_lostRecords; }
+
+private:
+    /** @return false if the slot no longer holds the record with the given index */
+    bool CopyRecord(std::uint64_t index, TelemetryRecord& record) const;
+
+    SharedMemory m_memory;
+    const TelemetryHeader* m_header = nullptr;
+    const std::uint8_t* m_slots = nullptr;
+    std::uint64_t m_readIndex = 0;
+    std::uint64_t m_lostRecords = 0;
+};
+}
@@ -0,0 +1,152 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+// Reference reader of the live telemetry ring. Logs every record as CSV, or
+// with -latest samples the newest record per poll like an overlay would.
+// Status messages go to stderr, so stdout stays valid CSV.
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+#include "command_line.h"
+#include "telemetry.h"
+
+using namespace PerfTools;
+
+namespace
+{
+    void PrintUsage()
+    {
+        std::printf("Usage: telemetry_reader [-name <ring>] [-output <path>] [-interval <ms>] [-latest] [-timeout <seconds>]\n");
+    }
+
+    void PrintField(std::FILE* file, const TelemetryRecord& record, std::uint32_t field, double value)
+    {
+        if ((record.validFields & field) != 0)
+        {
+            std::fprintf(file, ",%.4f", value);
+        }
+        else
+        {
+            std::fprintf(file, ",");
+        }
+    }
+
+    void PrintRecord(std::FILE* file, const TelemetryRecord& record, std::uint64_t lostRecords)
+    {
+        std::fprintf(file, "%llu,%.3f", (unsigned long long)record.frameIndex, (double)record.timestampNs * 1e-6);
+        PrintField(file, record, TelemetryFrameTime, record.frameTimeMs);
+        PrintField(file, record, TelemetryXessGpuTime, record.xessGpuTimeMs);
+        PrintField(file, record, TelemetrySimToPresentLatency, record.simToPresentLatencyMs);
+        if ((record.validFields & TelemetryFramesPresented) != 0)
+        {
+            std::fprintf(file, ",%u", record.framesPresented);
+        }
+        else
+        {
+            std::fprintf(file, ",");
+        }
+        std::fprintf(file, ",%llu\n", (unsigned long long)lostRecords);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    CommandLine args(argc, argv);
+    if (args.IsSet("-help"))
+    {
+        PrintUsage();
+        return 0;
+    }
+
+    const std::string name = args.GetString("-name", TelemetryDefaultName);
+    const std::string outputPath = args.GetString("-output", "");
+    const long long interval = args.GetInt("-interval", 100);
+    const bool latest = args.IsSet("-latest");
+    const double timeout = args.GetDouble("-timeout", 10.0);
+
+    std::FILE* output = stdout;
+    if (!outputPath.empty())
+    {
+        output = std::fopen(outputPath.c_str(), "w");
+        if (output == nullptr)
+        {
+            std::fprintf(stderr, "Unable to create %s\n", outputPath.c_str());
+            return 1;
+        }
+    }
+    std::fprintf(output, "frame_index,timestamp_ms,frame_time_ms,xess_gpu_ms,sim_to_present_ms,frames_presented,lost_records\n");
+
+    TelemetryReader reader;
+    auto lastActivity = std::chrono::steady_clock::now();
+
+    for (;;)
+    {
+        if (!reader.IsOpen() || !reader.IsProducerAlive())
+        {
+            if (reader.IsOpen())
+            {
+                std::fprintf(stderr, "Producer closed the ring\n");
+                reader.Close();
+            }
+            if (reader.Open(name))
+            {
+                std::fprintf(stderr, "Connected to '%s'\n", name.c_str());
+                lastActivity = std::chrono::steady_clock::now();
+            }
+        }
+
+        bool any = false;
+        TelemetryRecord record;
+        if (latest)
+        {
+            any = reader.ReadLatest(record);
+            if (any)
+            {
+                PrintRecord(output, record, reader.GetLostRecordCount());
+            }
+        }
+        else
+        {
+            while (reader.Read(record))
+            {
+                PrintRecord(output, record, reader.GetLostRecordCount());
+                any = true;
+            }
+        }
+
+        if (any)
+        {
+            std::fflush(output);
+            lastActivity = std::chrono::steady_clock::now();
+        }
+        else
+        {
+            const std::chrono::duration<double> idle = std::chrono::steady_clock::now() - lastActivity;
+            if (timeout > 0.0 && idle.count() > timeout)
+            {
+                std::fprintf(stderr, "No records for %.1f s, exiting\n", timeout);
+                break;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(interval > 0 ? interval : 1));
+    }
+
+    if (output != stdout)
+    {
+        std::fclose(output);
+    }
+    return 0;
+}
@@ -0,0 +1,340 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#include "trace_exporter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+namespace
+{
+    const int ProcessCpu = 1;
+    const int ProcessGpu = 2;
+
+    const int ThreadSimulation = 1;
+    const int ThreadRenderSubmit = 2;
+    const int ThreadPresent = 3;
+    const int ThreadFrameGeneration = 4;
+    const int ThreadXess = 1;
+    // CPU timer threads follow the fixed CPU tracks.
+    const int ThreadCpuTimersBase = 16;
+
+    // xellGetFramesReports always returns the last 64 frames.
+    const std::uint32_t MaxXellReports = 64;
+
+    double NanosecondsToMicroseconds(std::uint64_t nanoseconds)
+    {
+        return (double)nanoseconds * 1e-3;
+    }
+
+    std::uint64_t SecondsToNanoseconds(double seconds)
+    {
+        return (seconds > 0.0 && std::isfinite(seconds)) ? (std::uint64_t)std::llround(seconds * 1e9) : 0;
+    }
+}
+
+namespace PerfTools
+{
+TraceExporter::~TraceExporter()
+{
+    Close();
+}
+
+bool TraceExporter::Open(const std::string& path)
+{
+    Close();
+
+    m_file = std::fopen(path.c_str(), "w");
+    if (m_file == nullptr)
+    {
+        return false;
+    }
+
+    m_firstEvent = true;
+    m_markerCount = 0;
+    m_xellOffset = 0;
+    m_xellOffsetValid = false;
+    m_anyXellFrameExported = false;
+    m_submitRead = 0;
+    m_submitWrite = 0;
+    m_gpuBusyUntil = 0;
+    m_unmatchedExecutions = 0;
+    m_namedCpuTimerThreads = 0;
+
+    std::fprintf(m_file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    WriteMetadata(ProcessCpu, 0, "process_name", "CPU", 0);
+    WriteMetadata(ProcessGpu, 0, "process_name", "GPU", 1);
+    WriteMetadata(ProcessCpu, ThreadSimulation, "thread_name", "Simulation", ThreadSimulation);
+    WriteMetadata(ProcessCpu, ThreadRenderSubmit, "thread_name", "Render submit", ThreadRenderSubmit);
+    WriteMetadata(ProcessCpu, ThreadPresent, "thread_name", "Present", ThreadPresent);
+    WriteMetadata(ProcessCpu, ThreadFrameGeneration, "thread_name", "XeSS-FG present status", ThreadFrameGeneration);
+    WriteMetadata(ProcessGpu, ThreadXess, "thread_name", "XeSS", ThreadXess);
+    return true;
+}
+
+void TraceExporter::Close()
+{
+    if (m_file == nullptr)
+    {
+        return;
+    }
+
+    std::fprintf(m_file, "\n]}\n");
+    std::fclose(m_file);
+    m_file = nullptr;
+}
+
+std::uint64_t TraceExporter::Now()
+{
+    // steady_clock is QueryPerformanceCounter based on Windows, as is XeLL.
+    return (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void TraceExporter::AddXellMarkerTime(std::uint32_t frameId, std::uint64_t timestampNs)
+{
+    m_markers[m_markerCount % MarkerCapacity] = {frameId, timestampNs};
+    m_markerCount++;
+}
+
+void TraceExporter::AddXellFrameReports(const xell_frame_report_t* reports, std::uint32_t count)
+{
+    if (m_file == nullptr || reports == nullptr)
+    {
+        return;
+    }
+    count = std::min(count, MaxXellReports);
+
+    // The marker time is taken before XeLL samples its clock, so the largest
+    // difference is the one with the least delay in between.
+    const std::uint32_t markerCount = m_markerCount < MarkerCapacity ? m_markerCount : MarkerCapacity;
+    for (std::uint32_t r = 0; r < count; ++r)
+    {
+        if (reports[r].m_sim_start_ts == 0)
+        {
+            continue;
+        }
+        for (std::uint32_t m = 0; m < markerCount; ++m)
+        {
+            if (m_markers[m].frameId == reports[r].m_frame_id)
+            {
+                const std::int64_t offset = (std::int64_t)(m_markers[m].timestampNs - reports[r].m_sim_start_ts);
+                m_xellOffset = m_xellOffsetValid ? std::max(m_xellOffset, offset) : offset;
+                m_xellOffsetValid = true;
+                break;
+            }
+        }
+    }
+
+    // Without marker times both clocks are assumed to be the same, with marker
+    // times nothing is exported before the offset is known.
+    if (m_markerCount != 0 && !m_xellOffsetValid)
+    {
+        return;
+    }
+
+    const xell_frame_report_t* pending[MaxXellReports];
+    std::uint32_t pendingCount = 0;
+    for (std::uint32_t r = 0; r < count; ++r)
+    {
+        if (!m_anyXellFrameExported || reports[r].m_frame_id > m_lastXellFrameId)
+        {
+            pending[pendingCount++] = &reports[r];
+        }
+    }
+    std::sort(pending, pending + pendingCount,
+        [](const xell_frame_report_t* a, const xell_frame_report_t* b) { return a->m_frame_id < b->m_frame_id; });
+
+    const auto toTrace = [this](std::uint64_t xellNs) { return xellNs + (std::uint64_t)m_xellOffset; };
+    char args[64];
+    for (std::uint32_t i = 0; i < pendingCount; ++i)
+    {
+        const xell_frame_report_t& report = *pending[i];
+        if (report.m_sim_start_ts == 0 || report.m_present_end_ts == 0)
+        {
+            // Frame still in progress, export it and its successors with the next reports.
+            break;
+        }
+
+        std::snprintf(args, sizeof(args), "\"frame\":%u", report.m_frame_id);
+        WriteSlice(ProcessCpu, ThreadSimulation, "Simulation",
+            toTrace(report.m_sim_start_ts), toTrace(report.m_sim_end_ts), args);
+        WriteSlice(ProcessCpu, ThreadRenderSubmit, "Render submit",
+            toTrace(report.m_render_submit_start_ts), toTrace(report.m_render_submit_end_ts), args);
+        WriteSlice(ProcessCpu, ThreadPresent, "Present",
+            toTrace(report.m_present_start_ts), toTrace(report.m_present_end_ts), args);
+        WriteCounter("Simulation to present [ms]", toTrace(report.m_present_end_ts),
+            (double)(report.m_present_end_ts - report.m_sim_start_ts) * 1e-6);
+
+        m_lastXellFrameId = report.m_frame_id;
+        m_anyXellFrameExported = true;
+    }
+}
+
+void TraceExporter::AddXessExecute(std::uint64_t timestampNs)
+{
+    if (m_submitWrite - m_submitRead == SubmitCapacity)
+    {
+        m_submitRead++;
+        m_unmatchedExecutions++;
+    }
+    m_submits[m_submitWrite % SubmitCapacity] = timestampNs;
+    m_submitWrite++;
+}
+
+void TraceExporter::AddXessProfilingData(const xess_profiling_data_t& data)
+{
+    if (m_file == nullptr)
+    {
+        return;
+    }
+
+    char args[64];
+    for (std::uint64_t f = 0; f < data.frame_count; ++f)
+    {
+        const xess_profiled_frame_data_t& frame = data.frames[f];
+
+        std::uint64_t start = m_gpuBusyUntil;
+        if (m_submitRead != m_submitWrite)
+        {
+            start = std::max(start, m_submits[m_submitRead % SubmitCapacity]);
+            m_submitRead++;
+        }
+        else
+        {
+            m_unmatchedExecutions++;
+        }
+
+        std::uint64_t total = 0;
+        for (std::uint64_t r = 0; r < frame.gpu_duration_record_count; ++r)
+        {
+            total += SecondsToNanoseconds(frame.gpu_duration_values[r]);
+        }
+
+        std::snprintf(args, sizeof(args), "\"frame_index\":%llu", (unsigned long long)frame.frame_index);
+        WriteSlice(ProcessGpu, ThreadXess, "XeSS execute", start, start + total, args);
+
+        std::uint64_t passStart = start;
+        for (std::uint64_t r = 0; r < frame.gpu_duration_record_count; ++r)
+        {
+            const std::uint64_t duration = SecondsToNanoseconds(frame.gpu_duration_values[r]);
+            const char* name = frame.gpu_duration_names[r] != nullptr ? frame.gpu_duration_names[r] : "unnamed";
+            WriteSlice(ProcessGpu, ThreadXess, name, passStart, passStart + duration);
+            passStart += duration;
+        }
+        m_gpuBusyUntil = start + total;
+    }
+}
+
+void TraceExporter::AddPresentStatus(std::uint64_t timestampNs, std::uint32_t frameId,
+    const xefg_swapchain_present_status_t& status)
+{
+    if (m_file == nullptr)
+    {
+        return;
+    }
+
+    const char* name = status.frameGenResult == XEFG_SWAPCHAIN_RESULT_SUCCESS ? "Present status" : "Frame generation failed";
+    BeginEvent();
+    std::fprintf(m_file, "{\"ph\":\"i\",\"s\":\"t\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f,\"name\":\"%s\","
+        "\"args\":{\"frame\":%u,\"frames_presented\":%u,\"result\":%d,\"frame_generation_enabled\":%u}}",
+        ProcessCpu, ThreadFrameGeneration, NanosecondsToMicroseconds(timestampNs), name, frameId,
+        status.framesPresented, (int)status.frameGenResult, status.isFrameGenEnabled);
+    WriteCounter("Frames presented", timestampNs, (double)status.framesPresented);
+}
+
+void TraceExporter::AddCpuTimerSamples(const CpuTimerSample* samples, std::uint32_t count)
+{
+    if (m_file == nullptr || samples == nullptr)
+    {
+        return;
+    }
+
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+        const CpuTimerSample& sample = samples[i];
+        const int thread = ThreadCpuTimersBase + (int)sample.thread;
+        const std::uint32_t threadBit = 1u << (sample.thread % 32);
+        if ((m_namedCpuTimerThreads & threadBit) == 0)
+        {
+            char name[64];
+            std::snprintf(name, sizeof(name), "CPU timers, thread %u", sample.thread);
+            WriteMetadata(ProcessCpu, thread, "thread_name", name, thread);
+            m_namedCpuTimerThreads |= threadBit;
+        }
+        WriteSlice(ProcessCpu, thread, CpuTimers::GetZoneName(sample.zone), sample.startNs,
+            sample.startNs + sample.durationNs);
+    }
+}
+
+void TraceExporter::BeginEvent()
+{
+    std::fprintf(m_file, m_firstEvent ? "\n" : ",\n");
+    m_firstEvent = false;
+}
+
+void TraceExporter::WriteSlice(int process, int thread, const char* name, std::uint64_t startNs, std::uint64_t endNs,
+    const char* args)
+{
+    if (startNs == 0 || endNs < startNs)
+    {
+        return;
+    }
+
+    BeginEvent();
+    std::fprintf(m_file, "{\"ph\":\"X\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,\"name\":",
+        process, thread, NanosecondsToMicroseconds(startNs), NanosecondsToMicroseconds(endNs - startNs));
+    WriteString(name);
+    if (args != nullptr)
+    {
+        std::fprintf(m_file, ",\"args\":{%s}", args);
+    }
+    std::fprintf(m_file, "}");
+}
+
+void TraceExporter::WriteCounter(const char* name, std::uint64_t timestampNs, double value)
+{
+    BeginEvent();
+    std::fprintf(m_file, "{\"ph\":\"C\",\"pid\":%d,\"ts\":%.3f,\"name\":\"%s\",\"args\":{\"value\":%.4f}}",
+        ProcessCpu, NanosecondsToMicroseconds(timestampNs), name, value);
+}
+
+void TraceExporter::WriteMetadata(int process, int thread, const char* type, const char* name, int sortIndex)
+{
+    BeginEvent();
+    std::fprintf(m_file, "{\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"name\":\"%s\",\"args\":{\"name\":\"%s\"}},\n",
+        process, thread, type, name);
+    std::fprintf(m_file, "{\"ph\":\"M\",\"pid\":%d,\"tid\":%d,\"name\":\"%s_sort_index\",\"args\":{\"sort_index\":%d}}",
+        process, thread, thread == 0 ? "process" : "thread", sortIndex);
+}
+
+void TraceExporter::WriteString(const char* text)
+{
+    std::fputc('"', m_file);
+    for (const char* c = text; *c != '\0'; ++c)
+    {
+        if (*c == '"' || *c == '\\')
+        {
+            std::fputc('\\', m_file);
+            std::fputc(*c, m_file);
+        }
+        else if ((unsigned char)*c >= 0x20)
+        {
+            std::fputc(*c, m_file);
+        }
+    }
+    std::fputc('"', m_file);
+}
+}
@@ -0,0 +1,138 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+#include "cpu_timers.h"
+#include "xell/xell.h"
+#include "xess/xess_debug.h"
+#include "xess_fg/xefg_swapchain.h"
+
+namespace PerfTools
+{
+/**
+ * Streams XeSS, XeLL and XeSS-FG timing into one Chrome trace JSON file, which
+ * opens in Perfetto (ui.perfetto.dev) and chrome://tracing.
+ *
+ * All events are placed on the trace clock, Now(). Sources using other clocks
+ * are aligned on the way:
+ * - XeLL reports use the XeLL clock. The offset is estimated from marker times
+ *   the application takes on the trace clock right before adding
+ *   XELL_SIMULATION_START, see AddXellMarkerTime.
+ * - XeSS profiling data only holds GPU durations. Each execution is placed at
+ *   its CPU submission time, see AddXessExecute, or after the previous one if
+ *   the GPU was still busy, passes follow each other in reported order. Start
+ *   times are thus approximate, durations are exact.
+ *
+ * Events are written as they arrive, memory use does not grow with the length
+ * of the capture. Methods are not thread-safe.
+ */
+class TraceExporter
+{
+public:
+    TraceExporter() = default;
+    ~TraceExporter();
+
+    TraceExporter(const TraceExporter&) = delete;
+    TraceExporter& operator=(const TraceExporter&) = delete;
+
+    /** Creates the trace file and writes the process and track names. */
+    bool Open(const std::string& path);
+    /** Terminates the JSON document. */
+    void Close();
+    bool IsOpen() const { return m_file != nullptr; }
+
+    /** @return current time of the trace clock in nanoseconds */
+    static std::uint64_t Now();
+
+    /**
+     * Records the trace clock time of an XeLL simulation start marker.
+     * @param frameId - frame ID passed to xellAddMarkerData
+     * @param timestampNs - Now() taken right before xellAddMarkerData
+     */
+    void AddXellMarkerTime(std::uint32_t frameId, std::uint64_t timestampNs);
+
+    /**
+     * Exports complete reports of frames not exported yet.
+     * @param reports - output of xellGetFramesReports
+     * @param count - number of reports, 64 for xellGetFramesReports
+     */
+    void AddXellFrameReports(const xell_frame_report_t* reports, std::uint32_t count);
+
+    /** @param timestampNs - Now() taken right before xess*Execute */
+    void AddXessExecute(std::uint64_t timestampNs);
+
+    /** Exports polled XeSS profiling data, executions are matched to AddXessExecute in order. */
+    void AddXessProfilingData(const xess_profiling_data_t& data);
+
+    /**
+     * @param timestampNs - Now() taken after the present returned
+     * @param frameId - application frame ID of the present
+     * @param status - result of xefgSwapChainGetLastPresentStatus
+     */
+    void AddPresentStatus(std::uint64_t timestampNs, std::uint32_t frameId, const xefg_swapchain_present_status_t& status);
+
+    /**
+     * Exports drained CPU timer samples, one track per recording thread.
+     * @param samples - output of CpuTimers::Drain, already on the trace clock
+     * @param count - number of samples
+     */
+    void AddCpuTimerSamples(const CpuTimerSample* samples, std::uint32_t count);
+
+    bool IsXellClockAligned() const { return m_xellOffsetValid; }
+    /** @return nanoseconds added to XeLL timestamps to get trace clock time */
+    std::int64_t GetXellClockOffset() const { return m_xellOffset; }
+    /** @return executions placed after the GPU track because their submission time was lost */
+    std::uint64_t GetUnmatchedExecutionCount() const { return m_unmatchedExecutions; }
+
+private:
+    static const std::uint32_t MarkerCapacity = 256;
+    static const std::uint32_t SubmitCapacity = 256;
+
+    void BeginEvent();
+    void WriteSlice(int process, int thread, const char* name, std::uint64_t startNs, std::uint64_t endNs,
+        const char* args = nullptr);
+    void WriteCounter(const char* name, std::uint64_t timestampNs, double value);
+    void WriteMetadata(int process, int thread, const char* type, const char* name, int sortIndex);
+    void WriteString(const char* text);
+
+    std::FILE* m_file = nullptr;
+    bool m_firstEvent = true;
+
+    struct MarkerTime
+    {
+        std::uint32_t frameId;
+        std::uint64_t timestampNs;
+    };
+    MarkerTime m_markers[MarkerCapacity] = {};
+    std::uint32_t m_markerCount = 0;
+    std::int64_t m_xellOffset = 0;
+    bool m_xellOffsetValid = false;
+    bool m_anyXellFrameExported = false;
+    std::uint32_t m_lastXellFrameId = 0;
+
+    std::uint64_t m_submits[SubmitCapacity] = {};
+    std::uint64_t m_submitRead = 0;
+    std::uint64_t m_submitWrite = 0;
+    std::uint64_t m_gpuBusyUntil = 0;
+    std::uint64_t m_unmatchedExecutions = 0;
+
+    /** Bit per CpuTimers thread whose track name was written. */
+    std::uint32_t m_namedCpuTimerThreads = 0;
+};
+}
@@ -0,0 +1,219 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+// Plans the aliasing of the XeSS-SR and XeSS-FG temporary storage with the
+// transient render targets of a frame. Takes the temporary heap sizes reported
+// by xessGetProperties and xefgSwapChainGetProperties and the lifetimes of the
+// application's resources from a CSV file, or uses a built-in example frame,
+// and prints the heap sizes and the offset of every resource. Exits with 1 if
+// the input cannot be read or the plan fails validation.
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "command_line.h"
+#include "transient_heap_planner.h"
+
+using namespace PerfTools;
+
+namespace
+{
+    void PrintUsage()
+    {
+        std::printf("Usage: transient_heap_plan [-resources <csv>] [-mixed] [-alignment_kb <KiB>]\n"
+            "    [-xess_buffer_mb <MiB>] [-xess_texture_mb <MiB>] [-xess_pass <pass>]\n"
+            "    [-xefg_buffer_mb <MiB>] [-xefg_texture_mb <MiB>] [-xefg_passes <first,last>]\n"
+            "CSV lines: name,buffer|texture|rt,bytes,first pass,last pass[,alignment]\n"
+            "A last pass below the first pass continues into the next frame.\n");
+    }
+
+    bool ParseKind(const std::string& text, TransientHeapKind& kind)
+    {
+        if (text == "buffer")
+        {
+            kind = TransientHeapKind::Buffer;
+        }
+        else if (text == "texture")
+        {
+            kind = TransientHeapKind::Texture;
+        }
+        else if (text == "rt")
+        {
+            kind = TransientHeapKind::RenderTarget;
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    }
+
+    bool LoadResources(const std::string& path, TransientHeapPlanner& planner)
+    {
+        std::ifstream file(path);
+        if (!file)
+        {
+            std::fprintf(stderr, "Cannot open %s\n", path.c_str());
+            return false;
+        }
+        std::string line;
+        std::uint32_t lineNumber = 0;
+        while (std::getline(file, line))
+        {
+            lineNumber++;
+            if (!line.empty() && line.back() == '\r')
+            {
+                line.pop_back();
+            }
+            if (line.empty() || line[0] == '#')
+            {
+                continue;
+            }
+            std::vector<std::string> fields;
+            std::stringstream stream(line);
+            std::string field;
+            while (std::getline(stream, field, ','))
+            {
+                fields.push_back(field);
+            }
+            TransientResource resource;
+            if (fields.size() < 5 || !ParseKind(fields[1], resource.kind))
+            {
+                std::fprintf(stderr, "%s:%u: expected name,kind,bytes,first,last[,alignment]\n", path.c_str(), lineNumber);
+                return false;
+            }
+            resource.name = fields[0];
+            resource.size = std::strtoull(fields[2].c_str(), nullptr, 0);
+            resource.firstPass = std::uint32_t(std::strtoul(fields[3].c_str(), nullptr, 0));
+            resource.lastPass = std::uint32_t(std::strtoul(fields[4].c_str(), nullptr, 0));
+            resource.alignment = fields.size() > 5 ? std::strtoull(fields[5].c_str(), nullptr, 0) : 0;
+            planner.Add(resource);
+        }
+        return true;
+    }
+
+    /**
+     * Deferred frame rendered at 1920x1080 and upscaled to 3840x2160.
+     * Passes: 0 G-buffer, 1 SSAO, 2 lighting, 3 XeSS-SR, 4 post processing, 5 UI, 6 present with XeSS-FG.
+     */
+    void AddExampleFrame(TransientHeapPlanner& planner)
+    {
+        struct Example
+        {
+            const char* name;
+            TransientHeapKind kind;
+            std::uint32_t width;
+            std::uint32_t height;
+            std::uint32_t bytesPerPixel;
+            std::uint32_t firstPass;
+            std::uint32_t lastPass;
+        };
+        const Example examples[] = {
+            {"G-buffer albedo", TransientHeapKind::RenderTarget, 1920, 1080, 4, 0, 2},
+            {"G-buffer normals", TransientHeapKind::RenderTarget, 1920, 1080, 8, 0, 2},
+            {"Depth", TransientHeapKind::RenderTarget, 1920, 1080, 4, 0, 3},
+            {"Velocity", TransientHeapKind::RenderTarget, 1920, 1080, 4, 0, 3},
+            {"SSAO", TransientHeapKind::Texture, 1920, 1080, 1, 1, 2},
+            {"SSAO blur", TransientHeapKind::Texture, 1920, 1080, 1, 1, 1},
+            {"Lit color", TransientHeapKind::RenderTarget, 1920, 1080, 8, 2, 3},
+            {"XeSS-SR output", TransientHeapKind::Texture, 3840, 2160, 8, 3, 4},
+            {"Bloom half", TransientHeapKind::Texture, 1920, 1080, 8, 4, 4},
+            {"Bloom quarter", TransientHeapKind::Texture, 960, 540, 8, 4, 4},
+            {"Tonemapped color", TransientHeapKind::RenderTarget, 3840, 2160, 4, 4, 6},
+            {"UI", TransientHeapKind::RenderTarget, 3840, 2160, 4, 5, 6},
+        };
+        for (const Example& example : examples)
+        {
+            TransientResource resource;
+            resource.name = example.name;
+            resource.kind = example.kind;
+            // Round up to the 64 KiB pages of a placed resource.
+            resource.size = (std::uint64_t(example.width) * example.height * example.bytesPerPixel + 0xFFFF) & ~0xFFFFull;
+            resource.firstPass = example.firstPass;
+            resource.lastPass = example.lastPass;
+            planner.Add(resource);
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    CommandLine args(argc, argv);
+    if (args.IsSet("-help"))
+    {
+        PrintUsage();
+        return 0;
+    }
+
+    const std::uint64_t alignment = std::uint64_t(std::max(args.GetInt("-alignment_kb", 64), 1ll)) * 1024;
+    TransientHeapPlanner planner(args.IsSet("-mixed"), alignment);
+
+    const std::string resources = args.GetString("-resources", "");
+    if (resources.empty())
+    {
+        AddExampleFrame(planner);
+    }
+    else if (!LoadResources(resources, planner))
+    {
+        return 1;
+    }
+
+    // Placeholders, pass the sizes returned by xessGetProperties and xefgSwapChainGetProperties.
+    const std::uint32_t xessPass = std::uint32_t(args.GetInt("-xess_pass", 3));
+    xess_properties_t xessProperties = {};
+    xessProperties.tempBufferHeapSize = std::uint64_t(args.GetDouble("-xess_buffer_mb", 96.0) * (1 << 20));
+    xessProperties.tempTextureHeapSize = std::uint64_t(args.GetDouble("-xess_texture_mb", 64.0) * (1 << 20));
+    if (xessProperties.tempBufferHeapSize != 0 || xessProperties.tempTextureHeapSize != 0)
+    {
+        planner.AddXess(xessProperties, xessPass, nullptr, nullptr);
+    }
+
+    xefg_swapchain_properties_t xefgProperties = {};
+    xefgProperties.tempBufferHeapSize = std::uint64_t(args.GetDouble("-xefg_buffer_mb", 48.0) * (1 << 20));
+    xefgProperties.tempTextureHeapSize = std::uint64_t(args.GetDouble("-xefg_texture_mb", 128.0) * (1 << 20));
+    // The interpolation runs on its own queue from the present until the next frame's XeSS-SR pass at the latest,
+    // so by default its temporaries stay live into the next frame and never alias the XeSS-SR ones.
+    unsigned int xefgFirst = 6;
+    unsigned int xefgLast = xessPass;
+    const std::string xefgPasses = args.GetString("-xefg_passes", "6," + std::to_string(xessPass));
+    if (std::sscanf(xefgPasses.c_str(), "%u,%u", &xefgFirst, &xefgLast) != 2)
+    {
+        PrintUsage();
+        return 1;
+    }
+    if (xefgProperties.tempBufferHeapSize != 0 || xefgProperties.tempTextureHeapSize != 0)
+    {
+        planner.AddXefg(xefgProperties, xefgFirst, xefgLast, nullptr, nullptr);
+    }
+
+    if (planner.GetResources().empty())
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    const TransientHeapPlan plan = planner.Plan();
+    std::printf("%s", planner.FormatReport(plan).c_str());
+    if (!planner.Validate(plan))
+    {
+        std::fprintf(stderr, "The plan overlaps resources in use at the same time\n");
+        return 1;
+    }
+    return 0;
+}
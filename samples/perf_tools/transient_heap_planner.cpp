@@ -0,0 +1,349 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#include "transient_heap_planner.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace
+{
+    std::uint64_t AlignUp(std::uint64_t value, std::uint64_t alignment)
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    bool Wraps(const PerfTools::TransientResource& resource)
+    {
+        return resource.lastPass < resource.firstPass;
+    }
+
+    bool IsLive(const PerfTools::TransientResource& resource, std::uint32_t pass)
+    {
+        return Wraps(resource) ? pass >= resource.firstPass || pass <= resource.lastPass
+                               : pass >= resource.firstPass && pass <= resource.lastPass;
+    }
+
+    /** Lifetimes continuing into the next frame are treated as the longest. */
+    std::uint64_t GetSpan(const PerfTools::TransientResource& resource)
+    {
+        return Wraps(resource) ? std::uint64_t(UINT32_MAX) + 1 + resource.lastPass - resource.firstPass
+                               : resource.lastPass - resource.firstPass;
+    }
+
+    bool Intersects(const PerfTools::TransientResource& a, const PerfTools::TransientResource& b)
+    {
+        if (Wraps(a) && Wraps(b))
+        {
+            // Both are live at the start of the frame.
+            return true;
+        }
+        if (Wraps(b))
+        {
+            return b.firstPass <= a.lastPass || a.firstPass <= b.lastPass;
+        }
+        if (Wraps(a))
+        {
+            return a.firstPass <= b.lastPass || b.firstPass <= a.lastPass;
+        }
+        return a.firstPass <= b.lastPass && b.firstPass <= a.lastPass;
+    }
+
+    double ToMiB(std::uint64_t bytes)
+    {
+        return double(bytes) / double(1 << 20);
+    }
+
+    struct Range
+    {
+        std::uint64_t begin;
+        std::uint64_t end;
+    };
+}
+
+namespace PerfTools
+{
+TransientHeapPlanner::TransientHeapPlanner(bool mixedHeaps, std::uint64_t defaultAlignment)
+    : m_mixedHeaps(mixedHeaps), m_defaultAlignment(defaultAlignment > 0 ? defaultAlignment : 1)
+{
+}
+
+std::uint32_t TransientHeapPlanner::Add(const TransientResource& resource)
+{
+    m_resources.push_back(resource);
+    return std::uint32_t(m_resources.size() - 1);
+}
+
+void TransientHeapPlanner::AddXess(const xess_properties_t& properties, std::uint32_t pass, std::uint32_t* bufferIndex,
+    std::uint32_t* textureIndex)
+{
+    TransientResource resource;
+    resource.firstPass = pass;
+    resource.lastPass = pass;
+
+    resource.name = "XeSS-SR temp buffers";
+    resource.kind = TransientHeapKind::Buffer;
+    resource.size = properties.tempBufferHeapSize;
+    const std::uint32_t buffer = Add(resource);
+
+    resource.name = "XeSS-SR temp textures";
+    resource.kind = TransientHeapKind::Texture;
+    resource.size = properties.tempTextureHeapSize;
+    const std::uint32_t texture = Add(resource);
+
+    if (bufferIndex != nullptr)
+    {
+        *bufferIndex = buffer;
+    }
+    if (textureIndex != nullptr)
+    {
+        *textureIndex = texture;
+    }
+}
+
+void TransientHeapPlanner::AddXefg(const xefg_swapchain_properties_t& properties, std::uint32_t firstPass,
+    std::uint32_t lastPass, std::uint32_t* bufferIndex, std::uint32_t* textureIndex)
+{
+    TransientResource resource;
+    resource.firstPass = firstPass;
+    resource.lastPass = lastPass;
+
+    resource.name = "XeSS-FG temp buffers";
+    resource.kind = TransientHeapKind::Buffer;
+    resource.size = properties.tempBufferHeapSize;
+    const std::uint32_t buffer = Add(resource);
+
+    resource.name = "XeSS-FG temp textures";
+    resource.kind = TransientHeapKind::Texture;
+    resource.size = properties.tempTextureHeapSize;
+    const std::uint32_t texture = Add(resource);
+
+    if (bufferIndex != nullptr)
+    {
+        *bufferIndex = buffer;
+    }
+    if (textureIndex != nullptr)
+    {
+        *textureIndex = texture;
+    }
+}
+
+TransientHeapPlan TransientHeapPlanner::Plan() const
+{
+    TransientHeapPlan plan;
+    plan.placements.resize(m_resources.size());
+
+    // One heap per kind in use, or a single heap for all of them.
+    std::vector<std::vector<std::uint32_t>> members;
+    for (std::uint32_t kind = 0; kind <= std::uint32_t(TransientHeapKind::RenderTarget); kind++)
+    {
+        std::vector<std::uint32_t> indices;
+        for (std::uint32_t i = 0; i < m_resources.size(); i++)
+        {
+            if (m_mixedHeaps || m_resources[i].kind == TransientHeapKind(kind))
+            {
+                indices.push_back(i);
+            }
+        }
+        if (!indices.empty())
+        {
+            TransientHeap heap;
+            heap.kind = TransientHeapKind(kind);
+            plan.heaps.push_back(heap);
+            members.push_back(indices);
+        }
+        if (m_mixedHeaps)
+        {
+            break;
+        }
+    }
+
+    for (std::uint32_t h = 0; h < plan.heaps.size(); h++)
+    {
+        TransientHeap& heap = plan.heaps[h];
+        std::vector<std::uint32_t> order = members[h];
+        // Largest first, long lifetimes first among equal sizes, they constrain the most other resources.
+        std::sort(order.begin(), order.end(), [this](std::uint32_t a, std::uint32_t b) {
+            const TransientResource& ra = m_resources[a];
+            const TransientResource& rb = m_resources[b];
+            if (ra.size != rb.size)
+            {
+                return ra.size > rb.size;
+            }
+            if (GetSpan(ra) != GetSpan(rb))
+            {
+                return GetSpan(ra) > GetSpan(rb);
+            }
+            return a < b;
+        });
+
+        std::uint64_t heapAlignment = 1;
+        std::vector<std::uint32_t> placed;
+        std::vector<Range> occupied;
+        for (std::uint32_t index : order)
+        {
+            const TransientResource& resource = m_resources[index];
+            const std::uint64_t alignment = GetAlignment(resource);
+            heapAlignment = std::max(heapAlignment, alignment);
+            heap.unaliasedSize += AlignUp(resource.size, alignment);
+
+            occupied.clear();
+            for (std::uint32_t other : placed)
+            {
+                if (Intersects(resource, m_resources[other]) && m_resources[other].size > 0)
+                {
+                    const std::uint64_t offset = plan.placements[other].offset;
+                    occupied.push_back({offset, offset + m_resources[other].size});
+                }
+            }
+            std::sort(occupied.begin(), occupied.end(), [](const Range& a, const Range& b) { return a.begin < b.begin; });
+
+            // Best fit among the gaps between the occupied ranges, past the end if none fits.
+            std::uint64_t cursor = 0;
+            std::uint64_t bestOffset = UINT64_MAX;
+            std::uint64_t bestGap = UINT64_MAX;
+            for (const Range& range : occupied)
+            {
+                const std::uint64_t candidate = AlignUp(cursor, alignment);
+                if (range.begin > cursor && candidate + resource.size <= range.begin && range.begin - cursor < bestGap)
+                {
+                    bestOffset = candidate;
+                    bestGap = range.begin - cursor;
+                }
+                cursor = std::max(cursor, range.end);
+            }
+            if (bestOffset == UINT64_MAX)
+            {
+                bestOffset = AlignUp(cursor, alignment);
+            }
+
+            plan.placements[index].heap = h;
+            plan.placements[index].offset = bestOffset;
+            heap.size = std::max(heap.size, bestOffset + resource.size);
+            placed.push_back(index);
+        }
+        heap.size = AlignUp(heap.size, heapAlignment);
+
+        // The live set is largest at the first pass of one of its resources, or at the start of the frame.
+        std::vector<std::uint32_t> passes(1, 0);
+        for (std::uint32_t index : members[h])
+        {
+            passes.push_back(m_resources[index].firstPass);
+        }
+        for (std::uint32_t pass : passes)
+        {
+            std::uint64_t live = 0;
+            for (std::uint32_t other : members[h])
+            {
+                if (IsLive(m_resources[other], pass))
+                {
+                    live += m_resources[other].size;
+                }
+            }
+            heap.lowerBound = std::max(heap.lowerBound, live);
+        }
+    }
+    return plan;
+}
+
+bool TransientHeapPlanner::Validate(const TransientHeapPlan& plan) const
+{
+    if (plan.placements.size() != m_resources.size())
+    {
+        return false;
+    }
+    for (std::uint32_t i = 0; i < m_resources.size(); i++)
+    {
+        const TransientResource& resource = m_resources[i];
+        const TransientPlacement& placement = plan.placements[i];
+        if (placement.heap >= plan.heaps.size())
+        {
+            return false;
+        }
+        const TransientHeap& heap = plan.heaps[placement.heap];
+        if ((!m_mixedHeaps && heap.kind != resource.kind) || placement.offset % GetAlignment(resource) != 0 ||
+            placement.offset + resource.size > heap.size)
+        {
+            return false;
+        }
+        for (std::uint32_t j = i + 1; j < m_resources.size(); j++)
+        {
+            const TransientResource& other = m_resources[j];
+            const TransientPlacement& otherPlacement = plan.placements[j];
+            if (otherPlacement.heap != placement.heap || !Intersects(resource, other) || resource.size == 0 ||
+                other.size == 0)
+            {
+                continue;
+            }
+            if (placement.offset < otherPlacement.offset + other.size && otherPlacement.offset < placement.offset + resource.size)
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+std::string TransientHeapPlanner::FormatReport(const TransientHeapPlan& plan) const
+{
+    std::ostringstream report;
+    report << std::fixed << std::setprecision(2);
+    report << std::left << std::setw(28) << "resource" << std::setw(14) << "kind" << std::right << std::setw(10)
+           << "size [MiB]" << std::setw(12) << "passes" << std::setw(6) << "heap" << std::setw(14) << "offset [MiB]"
+           << "\n";
+    for (std::uint32_t i = 0; i < m_resources.size() && i < plan.placements.size(); i++)
+    {
+        const TransientResource& resource = m_resources[i];
+        const std::string passes = std::to_string(resource.firstPass) + "-" + std::to_string(resource.lastPass) +
+            (Wraps(resource) ? " next" : "");
+        report << std::left << std::setw(28) << resource.name << std::setw(14) << GetKindName(resource.kind)
+               << std::right << std::setw(10) << ToMiB(resource.size) << std::setw(12) << passes << std::setw(6)
+               << plan.placements[i].heap << std::setw(14) << ToMiB(plan.placements[i].offset) << "\n";
+    }
+
+    std::uint64_t total = 0;
+    std::uint64_t unaliased = 0;
+    for (std::uint32_t h = 0; h < plan.heaps.size(); h++)
+    {
+        const TransientHeap& heap = plan.heaps[h];
+        report << "Heap " << h << " (" << (m_mixedHeaps ? "mixed" : GetKindName(heap.kind)) << "): " << ToMiB(heap.size)
+               << " MiB, unaliased " << ToMiB(heap.unaliasedSize) << " MiB, lower bound " << ToMiB(heap.lowerBound)
+               << " MiB\n";
+        total += heap.size;
+        unaliased += heap.unaliasedSize;
+    }
+    report << "Total " << ToMiB(total) << " MiB instead of " << ToMiB(unaliased) << " MiB, saves "
+           << ToMiB(unaliased > total ? unaliased - total : 0) << " MiB\n";
+    return report.str();
+}
+
+const char* TransientHeapPlanner::GetKindName(TransientHeapKind kind)
+{
+    switch (kind)
+    {
+    case TransientHeapKind::Buffer:
+        return "buffer";
+    case TransientHeapKind::Texture:
+        return "texture";
+    default:
+        return "render target";
+    }
+}
+
+std::uint64_t TransientHeapPlanner::GetAlignment(const TransientResource& resource) const
+{
+    return resource.alignment > 0 ? resource.alignment : m_defaultAlignment;
+}
+}
@@ -0,0 +1,153 @@
+/*******************************************************************************
+ * Copyright (C) 2025 Intel Corporation
+ *
+ * This software and the related documents are Intel copyrighted materials, and
+ * your use of them is governed by the express license under which they were
+ * provided to you ("License"). Unless the License provides otherwise, you may
+ * not use, modify, copy, publish, distribute, disclose or transmit this
+ * software or the related documents without Intel's prior written permission.
+ *
+ * This software and the related documents are provided as is, with no express
+ * or implied warranties, other than those that are expressly stated in the
+ * License.
+ ******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "xess/xess.h"
+#include "xess_fg/xefg_swapchain.h"
+
+namespace PerfTools
+{
+/**
+ * Resources a heap may hold. D3D12 resource heap tier 1 needs a separate heap
+ * for each kind, see D3D12_HEAP_FLAG_ALLOW_ONLY_*. XeSS and XeSS-FG temporary
+ * buffer storage is a Buffer, their temporary texture storage a Texture.
+ */
+enum class TransientHeapKind : std::uint32_t
+{
+    Buffer,
+    Texture,
+    RenderTarget,
+};
+
+/** Resource that is only used by a range of passes of the frame. */
+struct TransientResource
+{
+    std::string name;
+    TransientHeapKind kind = TransientHeapKind::Texture;
+    /** Allocation size, e.g. D3D12_RESOURCE_ALLOCATION_INFO::SizeInBytes. [bytes] */
+    std::uint64_t size = 0;
+    /** Placement alignment, 0 for the default of the planner. [bytes] */
+    std::uint64_t alignment = 0;
+    /**
+     * First and last pass, inclusive, that access the resource. A last pass below the first one continues
+     * into the next frame up to that pass, e.g. for work that overlaps the next frame on another queue.
+     */
+    std::uint32_t firstPass = 0;
+    std::uint32_t lastPass = 0;
+};
+
+struct TransientHeap
+{
+    TransientHeapKind kind = TransientHeapKind::Buffer;
+    /** Size to create the heap with, a multiple of the largest alignment placed in it. [bytes] */
+    std::uint64_t size = 0;
+    /** Sum of the sizes of its resources, the memory needed without aliasing. [bytes] */
+    std::uint64_t unaliasedSize = 0;
+    /** Largest sum of the sizes of resources used by the same pass, no placement can be smaller. [bytes] */
+    std::uint64_t lowerBound = 0;
+};
+
+struct TransientPlacement
+{
+    /** Index into TransientHeapPlan::heaps. */
+    std::uint32_t heap = 0;
+    /** Offset in the heap, pass it as bufferHeapOffset or textureHeapOffset for the XeSS temporaries. [bytes] */
+    std::uint64_t offset = 0;
+};
+
+struct TransientHeapPlan
+{
+    std::vector<TransientHeap> heaps;
+    /** Placement of every added resource, in the order they were added. */
+    std::vector<TransientPlacement> placements;
+};
+
+/**
+ * Plans aliased placements of transient resources in shared heaps.
+ *
+ * Resources whose pass ranges do not intersect may share memory. The planner
+ * colors the interval graph of the lifetimes with offsets: resources are
+ * placed largest first, each at the best fitting aligned gap left by the
+ * already placed resources whose lifetimes intersect its own. The temporary
+ * storage of XeSS-SR and XeSS-FG is only used inside xess*Execute and the
+ * interpolation of the present, so it can share memory with each other and
+ * with the application's render targets of other passes.
+ *
+ * Passes are positions on one GPU timeline, repeated every frame. Work on
+ * another queue that is not ordered with a fence must extend its lifetime
+ * over every pass it may overlap, into the next frame if needed. The XeSS-FG
+ * interpolation runs on its own queue after the present and may still run
+ * while the next frame renders, up to its XeSS-SR pass. Resources placed in
+ * memory previously used by another resource need an aliasing barrier and,
+ * for textures, a discard or clear before the first use in a frame.
+ */
+class TransientHeapPlanner
+{
+public:
+    /**
+     * @param mixedHeaps - all kinds share one heap, for D3D12 resource heap tier 2 and Vulkan memory types
+     * that allow them
+     * @param defaultAlignment - alignment of resources that do not set one, 64 KiB is the D3D12 default
+     */
+    explicit TransientHeapPlanner(bool mixedHeaps = false, std::uint64_t defaultAlignment = 65536);
+
+    /** @return index of the resource in TransientHeapPlan::placements */
+    std::uint32_t Add(const TransientResource& resource);
+
+    /**
+     * Adds the temporary buffer and texture storage of an XeSS-SR context.
+     * @param properties - from xessGetProperties, for the output resolution passed to init
+     * @param pass - pass that records xess*Execute
+     * @param bufferIndex - receives the index of the buffer storage, may be null
+     * @param textureIndex - receives the index of the texture storage, may be null
+     */
+    void AddXess(const xess_properties_t& properties, std::uint32_t pass, std::uint32_t* bufferIndex,
+        std::uint32_t* textureIndex);
+
+    /**
+     * Adds the temporary buffer and texture storage of an XeSS-FG swap chain.
+     * @param properties - from xefgSwapChainGetProperties
+     * @param firstPass - first pass during which the interpolation may run, usually the present
+     * @param lastPass - last pass during which the interpolation may run, below firstPass if it may still run
+     * during the next frame
+     * @param bufferIndex - receives the index of the buffer storage, may be null
+     * @param textureIndex - receives the index of the texture storage, may be null
+     */
+    void AddXefg(const xefg_swapchain_properties_t& properties, std::uint32_t firstPass, std::uint32_t lastPass,
+        std::uint32_t* bufferIndex, std::uint32_t* textureIndex);
+
+    const std::vector<TransientResource>& GetResources() const { return m_resources; }
+
+    TransientHeapPlan Plan() const;
+
+    /** @return false if resources with intersecting lifetimes overlap in memory, or a placement is misaligned */
+    bool Validate(const TransientHeapPlan& plan) const;
+
+    std::string FormatReport(const TransientHeapPlan& plan) const;
+
+    static const char* GetKindName(TransientHeapKind kind);
+
+private:
+    std::uint64_t GetAlignment(const TransientResource& resource) const;
+
+    bool m_mixedHeaps;
+    std::uint64_t m_defaultAlignment;
+    std::vector<TransientResource> m_resources;
+};
+}